@@ -0,0 +1,85 @@
+/*
+ * Copyright (C) 2015 Morwenn
+ *
+ * The SGL is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * The SGL is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program. If not,
+ * see <http://www.gnu.org/licenses/>.
+ */
+// cc -std=c11 -O2 -Iinclude benchmarks/arena.c src/arena.c src/exception.c
+
+#include <stdio.h>
+#include <sgl/memory.h>
+#include <sgl/utility.h>
+#include <sgl/vector.h>
+#include "bench.h"
+
+sgl_define(sgl_vector(int))
+
+enum { vectors_per_request = 32 };
+
+// Simulates a request handler building temporary vectors
+static void handle_request(const sgl_allocator* allocator, unsigned seed)
+{
+    sgl_vector(int)* vectors[vectors_per_request];
+    for (int i = 0 ; i < vectors_per_request ; ++i)
+    {
+        if (allocator)
+        {
+            vectors[i] = sgl_new_with_allocator(sgl_vector(int), allocator);
+        }
+        else
+        {
+            vectors[i] = sgl_new(sgl_vector(int));
+        }
+        seed = seed * 1103515245u + 12345u;
+        int count = seed >> 24;
+        for (int j = 0 ; j < count ; ++j)
+        {
+            sgl_push_back(vectors[i], j);
+        }
+        bench_sink += sgl_size(vectors[i]);
+    }
+
+    // Vectors from an arena do not need to be deleted
+    if (allocator == NULL)
+    {
+        for (int i = 0 ; i < vectors_per_request ; ++i)
+        {
+            sgl_delete(vectors[i]);
+        }
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    size_t requests = bench_arg(argc, argv, 1, 100000);
+    printf("%zu requests of %d vectors\n", requests, vectors_per_request);
+
+    double start = bench_now();
+    for (size_t i = 0 ; i < requests ; ++i)
+    {
+        handle_request(NULL, (unsigned) i);
+    }
+    printf("malloc: %10.3f ms\n", (bench_now() - start) * 1e3);
+
+    sgl_arena arena;
+    sgl_arena_init(&arena, 64 * 1024);
+    start = bench_now();
+    for (size_t i = 0 ; i < requests ; ++i)
+    {
+        handle_request(sgl_arena_allocator(&arena), (unsigned) i);
+        sgl_arena_reset(&arena);
+    }
+    printf("arena:  %10.3f ms\n", (bench_now() - start) * 1e3);
+    sgl_arena_destroy(&arena);
+}
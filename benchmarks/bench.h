@@ -0,0 +1,60 @@
+/*
+ * Copyright (C) 2015 Morwenn
+ *
+ * The SGL is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * The SGL is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program. If not,
+ * see <http://www.gnu.org/licenses/>.
+ */
+#ifndef SGL_BENCHMARKS_BENCH_H_
+#define SGL_BENCHMARKS_BENCH_H_
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+// Small helpers shared by the benchmarks, which are meant to be
+// compiled with optimizations, for example:
+//   cc -std=c11 -O2 -Iinclude benchmarks/vector_growth.c src/exception.c
+
+/**
+ * Returns the current time in seconds.
+ */
+static inline double bench_now(void)
+{
+    struct timespec ts;
+    timespec_get(&ts, TIME_UTC);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+/**
+ * Returns the numeric command line argument at the given
+ * position, or the default value if there is none.
+ */
+static inline size_t bench_arg(int argc, char* argv[], int pos, size_t default_value)
+{
+    if (argc > pos)
+    {
+        return (size_t) strtoull(argv[pos], NULL, 10);
+    }
+    return default_value;
+}
+
+/**
+ * Prevents the compiler from optimizing away a computed value.
+ */
+static volatile size_t bench_sink;
+
+#endif // SGL_BENCHMARKS_BENCH_H_
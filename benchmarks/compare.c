@@ -0,0 +1,102 @@
+/*
+ * Copyright (C) 2015 Morwenn
+ *
+ * The SGL is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * The SGL is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program. If not,
+ * see <http://www.gnu.org/licenses/>.
+ */
+#include <stdio.h>
+#include <sgl/utility.h>
+#include <sgl/vector.h>
+#include "bench.h"
+
+sgl_define(sgl_vector(int))
+sgl_define(sgl_vector(double))
+
+// Element by element comparison, as done by the former check function
+static bool naive_equal(const sgl_vector(int)* lhs, const sgl_vector(int)* rhs)
+{
+    for (size_t i = 0 ; i < sgl_size(lhs) ; ++i)
+    {
+        if (sgl_at(lhs, i) != sgl_at(rhs, i))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+static void report(const char* name, double elapsed, size_t bytes)
+{
+    printf("%-24s %10.3f ms  %8.2f GB/s\n", name, elapsed * 1e3,
+           bytes / elapsed * 1e-9);
+}
+
+int main(int argc, char* argv[])
+{
+    size_t count = bench_arg(argc, argv, 1, 1000000);
+    size_t repeat = bench_arg(argc, argv, 2, 100);
+    printf("%zu comparisons of %zu-element vectors differing at the end\n",
+           repeat, count);
+
+    sgl_vector(int)* ints[2];
+    sgl_vector(double)* doubles[2];
+    for (int i = 0 ; i < 2 ; ++i)
+    {
+        ints[i] = sgl_new_with_capacity(sgl_vector(int), count);
+        doubles[i] = sgl_new_with_capacity(sgl_vector(double), count);
+        for (size_t j = 0 ; j < count ; ++j)
+        {
+            sgl_push_back(ints[i], (int) j);
+            sgl_push_back(doubles[i], (double) j);
+        }
+    }
+    sgl_at(ints[1], count - 1) = -1;
+    sgl_at(doubles[1], count - 1) = -1.0;
+
+    double start = bench_now();
+    for (size_t i = 0 ; i < repeat ; ++i)
+    {
+        bench_sink += naive_equal(ints[0], ints[1]);
+    }
+    report("naive loop (int)", bench_now() - start, repeat * count * sizeof(int));
+
+    start = bench_now();
+    for (size_t i = 0 ; i < repeat ; ++i)
+    {
+        bench_sink += sgl_equal(ints[0], ints[1]);
+    }
+    report("sgl_equal (int)", bench_now() - start, repeat * count * sizeof(int));
+
+    start = bench_now();
+    for (size_t i = 0 ; i < repeat ; ++i)
+    {
+        bench_sink += sgl_lexicographical_compare(ints[0], ints[1]);
+    }
+    report("sgl_lex_compare (int)", bench_now() - start,
+           repeat * count * sizeof(int));
+
+    start = bench_now();
+    for (size_t i = 0 ; i < repeat ; ++i)
+    {
+        bench_sink += sgl_equal(doubles[0], doubles[1]);
+    }
+    report("sgl_equal (double)", bench_now() - start,
+           repeat * count * sizeof(double));
+
+    for (int i = 0 ; i < 2 ; ++i)
+    {
+        sgl_delete(ints[i]);
+        sgl_delete(doubles[i]);
+    }
+}
@@ -0,0 +1,67 @@
+/*
+ * Copyright (C) 2015 Morwenn
+ *
+ * The SGL is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * The SGL is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program. If not,
+ * see <http://www.gnu.org/licenses/>.
+ */
+// Compile this benchmark twice to compare the dispatch modes:
+//   cc -std=c11 -O2 -Iinclude benchmarks/dispatch.c src/exception.c
+//   cc -std=c11 -O2 -Iinclude -DSGL_STATIC_DISPATCH benchmarks/dispatch.c src/exception.c
+
+#include <stdio.h>
+#include <sgl/iterator.h>
+#include <sgl/utility.h>
+#include <sgl/vector.h>
+#include "bench.h"
+
+sgl_define(sgl_vector(int))
+
+int main(int argc, char* argv[])
+{
+    size_t count = bench_arg(argc, argv, 1, 10000000);
+#ifdef SGL_STATIC_DISPATCH
+    printf("static dispatch, %zu ints\n", count);
+#else
+    printf("function table dispatch, %zu ints\n", count);
+#endif
+
+    sgl_vector(int)* vec = sgl_new(sgl_vector(int));
+
+    double start = bench_now();
+    for (size_t i = 0 ; i < count ; ++i)
+    {
+        sgl_push_back(vec, (int) i);
+    }
+    printf("push_back: %10.3f ms\n", (bench_now() - start) * 1e3);
+
+    start = bench_now();
+    size_t sum = 0;
+    for (size_t i = 0 ; i < sgl_size(vec) ; ++i)
+    {
+        sum += sgl_at(vec, i);
+    }
+    printf("at:        %10.3f ms\n", (bench_now() - start) * 1e3);
+    bench_sink += sum;
+
+    start = bench_now();
+    sum = 0;
+    for (sgl_iterator(sgl_vector(int)) it = sgl_begin(vec) ; it != sgl_end(vec) ; ++it)
+    {
+        sum += *it;
+    }
+    printf("iteration: %10.3f ms\n", (bench_now() - start) * 1e3);
+    bench_sink += sum;
+
+    sgl_delete(vec);
+}
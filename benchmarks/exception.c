@@ -0,0 +1,148 @@
+/*
+ * Copyright (C) 2015 Morwenn
+ *
+ * The SGL is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * The SGL is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program. If not,
+ * see <http://www.gnu.org/licenses/>.
+ */
+// cc -std=c11 -O2 -Iinclude benchmarks/exception.c src/exception.c
+// Add -DSGL_FAST_EXCEPTIONS to both files to measure the fast mode
+
+#include <stdio.h>
+#include <sgl/exception.h>
+#include "bench.h"
+
+// Read at runtime so that the compiler can not tell whether
+// the functions below throw
+static volatile sgl_exception_t to_throw = sgl_runtime_error;
+
+static void work(size_t i)
+{
+    bench_sink += i;
+    if (i == (size_t) -1)
+    {
+        sgl_throw(to_throw);
+    }
+}
+
+static void throw_from_callee(void)
+{
+    if (to_throw != sgl_exception)
+    {
+        sgl_throw(to_throw);
+    }
+}
+
+// Every try block catches and rethrows the exception
+static void rethrow_from(size_t depth)
+{
+    if (depth == 0)
+    {
+        throw_from_callee();
+        return;
+    }
+    sgl_try
+    {
+        rethrow_from(depth - 1);
+    }
+    sgl_catch(sgl_runtime_error)
+    {
+        sgl_rethrow();
+    }
+    sgl_endtry
+}
+
+static double bench_baseline(size_t count)
+{
+    double start = bench_now();
+    for (size_t i = 0 ; i < count ; ++i)
+    {
+        work(i);
+    }
+    return bench_now() - start;
+}
+
+// The loop counter of the caller is not live across sgl_try
+static void work_in_try(size_t i)
+{
+    sgl_try
+    {
+        work(i);
+    }
+    sgl_catch(sgl_exception)
+    {
+        ++bench_sink;
+    }
+    sgl_endtry
+}
+
+static double bench_try_entry(size_t count)
+{
+    double start = bench_now();
+    for (size_t i = 0 ; i < count ; ++i)
+    {
+        work_in_try(i);
+    }
+    return bench_now() - start;
+}
+
+// Throws through depth try blocks and catches the exception
+static void throw_and_catch(size_t depth)
+{
+    sgl_try
+    {
+        rethrow_from(depth);
+    }
+    sgl_catch(sgl_runtime_error)
+    {
+        ++bench_sink;
+    }
+    sgl_endtry
+}
+
+static double bench_throw(size_t count, size_t depth)
+{
+    double start = bench_now();
+    for (size_t i = 0 ; i < count ; ++i)
+    {
+        throw_and_catch(depth);
+    }
+    return bench_now() - start;
+}
+
+int main(int argc, char* argv[])
+{
+    size_t count = bench_arg(argc, argv, 1, 10000000);
+#if defined(SGL_FAST_EXCEPTIONS) && defined(__GNUC__)
+    printf("__builtin_setjmp, %zu iterations\n", count);
+#else
+    printf("setjmp, %zu iterations\n", count);
+#endif
+
+    double baseline = bench_baseline(count);
+    double entry = bench_try_entry(count);
+    printf("%-22s %8.2f ns\n", "call without sgl_try", baseline / count * 1e9);
+    printf("%-22s %8.2f ns\n", "call in sgl_try", entry / count * 1e9);
+    printf("%-22s %8.2f ns\n", "throw to catch", bench_throw(count, 0) / count * 1e9);
+
+    // The outermost try block of the benchmark is not counted
+    size_t depths[] = { 1, 4, 16, SGL_MAX_EXCEPTIONS - 1 };
+    for (size_t i = 0 ; i < sizeof depths / sizeof *depths ; ++i)
+    {
+        size_t iterations = count / (depths[i] + 1);
+        double elapsed = bench_throw(iterations, depths[i]);
+        printf("rethrow depth %-8zu %8.2f ns  %8.2f ns/level\n", depths[i],
+               elapsed / iterations * 1e9,
+               elapsed / iterations / depths[i] * 1e9);
+    }
+}
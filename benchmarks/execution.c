@@ -0,0 +1,104 @@
+/*
+ * Copyright (C) 2015 Morwenn
+ *
+ * The SGL is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * The SGL is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program. If not,
+ * see <http://www.gnu.org/licenses/>.
+ */
+// cc -std=c11 -O2 -Iinclude benchmarks/execution.c src/execution.c src/thread_pool.c src/thread.c src/exception.c -lpthread
+
+#include <stdio.h>
+#include <sgl/algorithm.h>
+#include <sgl/thread.h>
+#include <sgl/utility.h>
+#include <sgl/vector.h>
+#include "bench.h"
+
+sgl_define(sgl_vector(double))
+
+#define scale(ptr) \
+    (*(ptr) *= 1.0001)
+
+static inline double square(double value)
+{
+    return value * value;
+}
+
+#define add(acc, value) \
+    ((acc) + (value))
+
+#define is_large(value) \
+    ((value) > 0.5)
+
+sgl_define(sgl_for_each(double, scale))
+sgl_define(sgl_transform(double, double, square))
+sgl_define(sgl_reduce(double, add))
+sgl_define(sgl_count_if(double, is_large))
+
+int main(int argc, char* argv[])
+{
+    size_t size = bench_arg(argc, argv, 1, 20000000);
+    sgl_vector(double)* in = sgl_new(sgl_vector(double));
+    sgl_vector(double)* out = sgl_new(sgl_vector(double));
+    sgl_resize(in, size, 0.0);
+    sgl_resize(out, size, 0.0);
+    for (size_t i = 0 ; i < size ; ++i)
+    {
+        sgl_at(in, i) = (double) (i % 1000) / 1000;
+    }
+
+    printf("%zu doubles, %zu workers in the default pool, times in ms\n", size,
+           sgl_thread_pool_size(sgl_default_thread_pool()));
+    printf("%-12s %10s %10s %14s\n", "", "sgl_seq", "sgl_par", "sgl_par_unseq");
+    sgl_execution_policy policies[] = { sgl_seq, sgl_par, sgl_par_unseq };
+    const char* names[] = { "fill", "for_each", "transform", "reduce", "count_if" };
+    for (int algo = 0 ; algo < 5 ; ++algo)
+    {
+        double times[3];
+        for (int p = 0 ; p < 3 ; ++p)
+        {
+            sgl_execution_policy policy = policies[p];
+            double start = bench_now();
+            switch (algo)
+            {
+                case 0:
+                    sgl_fill(policy, sgl_begin(out), sgl_end(out), 1.0);
+                    break;
+                case 1:
+                    sgl_for_each(double, scale)(policy, sgl_begin(out), sgl_end(out));
+                    break;
+                case 2:
+                    sgl_transform(double, double, square)(policy, sgl_begin(in),
+                                                          sgl_end(in), sgl_begin(out));
+                    break;
+                case 3:
+                {
+                    double sum = sgl_reduce(double, add)(policy, sgl_begin(in),
+                                                         sgl_end(in), 0.0);
+                    bench_sink += (size_t) sum;
+                    break;
+                }
+                default:
+                    bench_sink += sgl_count_if(double, is_large)(policy, sgl_begin(in),
+                                                                 sgl_end(in));
+                    break;
+            }
+            times[p] = bench_now() - start;
+        }
+        printf("%-12s %10.3f %10.3f %14.3f\n", names[algo], times[0] * 1e3,
+               times[1] * 1e3, times[2] * 1e3);
+    }
+
+    sgl_delete(out);
+    sgl_delete(in);
+}
@@ -0,0 +1,76 @@
+/*
+ * Copyright (C) 2015 Morwenn
+ *
+ * The SGL is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * The SGL is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program. If not,
+ * see <http://www.gnu.org/licenses/>.
+ */
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <sgl/hash.h>
+#include "bench.h"
+
+// FNV-1a, a common hand-rolled byte hash, for comparison
+static size_t fnv1a(const void* data, size_t size)
+{
+    const unsigned char* ptr = data;
+    uint64_t hash = UINT64_C(0xcbf29ce484222325);
+    for (size_t i = 0 ; i < size ; ++i)
+    {
+        hash = (hash ^ ptr[i]) * UINT64_C(0x100000001b3);
+    }
+    return (size_t) hash;
+}
+
+static void bench_bytes(const char* name, size_t (*hash)(const void*, size_t),
+                        const unsigned char* data, size_t size, size_t total)
+{
+    size_t count = total / size;
+    double start = bench_now();
+    for (size_t i = 0 ; i < count ; ++i)
+    {
+        bench_sink += hash(data + (i & 255), size);
+    }
+    double elapsed = bench_now() - start;
+    printf("  %-8s %6zu bytes  %8.2f GB/s  %8.2f Mhash/s\n", name, size,
+           count * size / elapsed * 1e-9, count / elapsed * 1e-6);
+}
+
+int main(int argc, char* argv[])
+{
+    size_t total = bench_arg(argc, argv, 1, 1000000000);
+
+    printf("integers\n");
+    size_t count = total / 8;
+    double start = bench_now();
+    for (size_t i = 0 ; i < count ; ++i)
+    {
+        bench_sink += sgl_hash(i);
+    }
+    printf("  sgl_hash %8.2f Mhash/s\n", count / (bench_now() - start) * 1e-6);
+
+    printf("byte ranges\n");
+    unsigned char* data = malloc(65536 + 256);
+    for (size_t i = 0 ; i < 65536 + 256 ; ++i)
+    {
+        data[i] = (unsigned char) (i * 131);
+    }
+    size_t sizes[] = { 4, 8, 16, 32, 64, 256, 1024, 65536 };
+    for (size_t i = 0 ; i < sizeof sizes / sizeof *sizes ; ++i)
+    {
+        bench_bytes("sgl", sgl_hash_bytes, data, sizes[i], total);
+        bench_bytes("fnv1a", fnv1a, data, sizes[i], total / 8);
+    }
+    free(data);
+}
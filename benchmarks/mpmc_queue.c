@@ -0,0 +1,227 @@
+/*
+ * Copyright (C) 2015 Morwenn
+ *
+ * The SGL is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * The SGL is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program. If not,
+ * see <http://www.gnu.org/licenses/>.
+ */
+// cc -std=c11 -O2 -Iinclude benchmarks/mpmc_queue.c src/exception.c -lpthread
+//
+// Arguments: number of elements, maximal number of producer and
+// consumer pairs; the pairs should not exceed the number of cores.
+
+#include <stdatomic.h>
+#include <stdio.h>
+#include <threads.h>
+#include <sgl/mpmc_queue.h>
+#include <sgl/utility.h>
+#include "bench.h"
+
+sgl_define(sgl_mpmc_queue(size_t))
+
+enum
+{
+    capacity = 4096,
+    batch_size = 32,
+    max_threads = 64
+};
+
+static size_t per_producer;
+static atomic_size_t consumed;
+static size_t total;
+
+////////////////////////////////////////////////////////////
+// Baseline: a ring buffer protected by a mutex
+
+static struct
+{
+    mtx_t mutex;
+    size_t data[capacity];
+    size_t head;
+    size_t size;
+} ring;
+
+static int locked_produce(void* arg)
+{
+    (void) arg;
+    for (size_t i = 0 ; i < per_producer ; )
+    {
+        bool full;
+        mtx_lock(&ring.mutex);
+        full = ring.size == capacity;
+        if (not full)
+        {
+            ring.data[(ring.head + ring.size++) % capacity] = i++;
+        }
+        mtx_unlock(&ring.mutex);
+        if (full)
+        {
+            thrd_yield();
+        }
+    }
+    return 0;
+}
+
+static int locked_consume(void* arg)
+{
+    (void) arg;
+    while (atomic_load_explicit(&consumed, memory_order_relaxed) < total)
+    {
+        bool found = false;
+        size_t value;
+        mtx_lock(&ring.mutex);
+        if (ring.size)
+        {
+            value = ring.data[ring.head];
+            ring.head = (ring.head + 1) % capacity;
+            --ring.size;
+            found = true;
+        }
+        mtx_unlock(&ring.mutex);
+        if (found)
+        {
+            bench_sink += value;
+            atomic_fetch_add_explicit(&consumed, 1, memory_order_relaxed);
+        }
+        else
+        {
+            thrd_yield();
+        }
+    }
+    return 0;
+}
+
+////////////////////////////////////////////////////////////
+// Lock-free queue, one element or one batch at a time
+
+static sgl_mpmc_queue(size_t)* queue;
+
+static int single_produce(void* arg)
+{
+    (void) arg;
+    for (size_t i = 0 ; i < per_producer ; ++i)
+    {
+        sgl_push(queue, i);
+    }
+    return 0;
+}
+
+static int single_consume(void* arg)
+{
+    (void) arg;
+    while (atomic_load_explicit(&consumed, memory_order_relaxed) < total)
+    {
+        size_t value;
+        if (sgl_try_pop(queue, &value))
+        {
+            bench_sink += value;
+            atomic_fetch_add_explicit(&consumed, 1, memory_order_relaxed);
+        }
+        else
+        {
+            thrd_yield();
+        }
+    }
+    return 0;
+}
+
+static int batch_produce(void* arg)
+{
+    (void) arg;
+    size_t batch[batch_size];
+    for (size_t i = 0 ; i < per_producer ; )
+    {
+        size_t n = 0;
+        while (n < batch_size && i + n < per_producer)
+        {
+            batch[n] = i + n;
+            ++n;
+        }
+        size_t pushed = sgl_push_n(queue, batch, n);
+        if (pushed == 0)
+        {
+            thrd_yield();
+        }
+        i += pushed;
+    }
+    return 0;
+}
+
+static int batch_consume(void* arg)
+{
+    (void) arg;
+    while (atomic_load_explicit(&consumed, memory_order_relaxed) < total)
+    {
+        size_t batch[batch_size];
+        size_t n = sgl_pop_n(queue, batch, batch_size);
+        for (size_t i = 0 ; i < n ; ++i)
+        {
+            bench_sink += batch[i];
+        }
+        if (n)
+        {
+            atomic_fetch_add_explicit(&consumed, n, memory_order_relaxed);
+        }
+        else
+        {
+            thrd_yield();
+        }
+    }
+    return 0;
+}
+
+static double run(int pairs, thrd_start_t produce, thrd_start_t consume)
+{
+    thrd_t threads[2 * max_threads];
+    atomic_store(&consumed, 0);
+    double start = bench_now();
+    for (int i = 0 ; i < pairs ; ++i)
+    {
+        thrd_create(&threads[2 * i], produce, NULL);
+        thrd_create(&threads[2 * i + 1], consume, NULL);
+    }
+    for (int i = 0 ; i < 2 * pairs ; ++i)
+    {
+        thrd_join(threads[i], NULL);
+    }
+    return bench_now() - start;
+}
+
+int main(int argc, char* argv[])
+{
+    size_t count = bench_arg(argc, argv, 1, 10000000);
+    int pairs = (int) bench_arg(argc, argv, 2, 4);
+    if (pairs > max_threads)
+    {
+        pairs = max_threads;
+    }
+    printf("%zu elements, Mops/s for n producers and n consumers\n", count);
+    printf(" n  mutex+ring  mpmc single  mpmc batch %d\n", batch_size);
+
+    mtx_init(&ring.mutex, mtx_plain);
+    queue = sgl_new_with_capacity(sgl_mpmc_queue(size_t), capacity);
+    for (int n = 1 ; n <= pairs ; ++n)
+    {
+        per_producer = count / n;
+        total = per_producer * n;
+        double locked = run(n, &locked_produce, &locked_consume);
+        double single = run(n, &single_produce, &single_consume);
+        double batched = run(n, &batch_produce, &batch_consume);
+        printf("%2d %11.2f %12.2f %13.2f\n", n,
+               total / locked * 1e-6,
+               total / single * 1e-6,
+               total / batched * 1e-6);
+    }
+    sgl_delete(queue);
+    mtx_destroy(&ring.mutex);
+}
@@ -0,0 +1,68 @@
+/*
+ * Copyright (C) 2015 Morwenn
+ *
+ * The SGL is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * The SGL is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program. If not,
+ * see <http://www.gnu.org/licenses/>.
+ */
+// cc -std=c11 -O2 -Iinclude benchmarks/parallel_sort.c src/thread.c src/exception.c -lpthread
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sgl/algorithm.h>
+#include <sgl/thread.h>
+#include <sgl/utility.h>
+#include "bench.h"
+
+sgl_define(sgl_sort(int))
+sgl_define(sgl_parallel_sort(int))
+
+// Usage: parallel_sort [size] [max threads]
+int main(int argc, char* argv[])
+{
+    size_t size = bench_arg(argc, argv, 1, 20000000);
+    size_t max_threads = bench_arg(argc, argv, 2, sgl_hardware_concurrency());
+    int* original = malloc(size * sizeof(int));
+    int* values = malloc(size * sizeof(int));
+
+    uint64_t state = 42;
+    for (size_t i = 0 ; i < size ; ++i)
+    {
+        state = state * UINT64_C(6364136223846793005) + UINT64_C(1442695040888963407);
+        original[i] = (int) (state >> 33);
+    }
+
+    memcpy(values, original, size * sizeof(int));
+    double start = bench_now();
+    sgl_sort(int)(values, values + size);
+    double serial_time = bench_now() - start;
+    bench_sink += (size_t) values[size / 2];
+
+    printf("%zu random ints, %zu processors\n", size, sgl_hardware_concurrency());
+    printf("%-10s %10s %10s\n", "threads", "ms", "speedup");
+    printf("%-10s %10.3f %10.2f\n", "sgl_sort", serial_time * 1e3, 1.0);
+    for (size_t threads = 1 ; threads <= max_threads ; ++threads)
+    {
+        memcpy(values, original, size * sizeof(int));
+        start = bench_now();
+        sgl_parallel_sort(int)(values, values + size, threads);
+        double time = bench_now() - start;
+        printf("%-10zu %10.3f %10.2f\n", threads, time * 1e3, serial_time / time);
+        bench_sink += (size_t) values[size / 2];
+    }
+
+    free(values);
+    free(original);
+}
@@ -0,0 +1,104 @@
+/*
+ * Copyright (C) 2015 Morwenn
+ *
+ * The SGL is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * The SGL is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program. If not,
+ * see <http://www.gnu.org/licenses/>.
+ */
+// cc -std=c11 -O2 -Iinclude benchmarks/priority_queue.c src/exception.c
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <sgl/priority_queue.h>
+#include <sgl/utility.h>
+#include <sgl/vector.h>
+#include "bench.h"
+
+// The arity is read when the types are defined, and the types
+// need different comparison names to get different names
+#define binary_less(lhs, rhs) ((lhs) < (rhs))
+#define quaternary_less(lhs, rhs) ((lhs) < (rhs))
+#define octonary_less(lhs, rhs) ((lhs) < (rhs))
+
+sgl_define(sgl_vector(unsigned))
+
+#undef SGL_PRIORITY_QUEUE_ARITY
+#define SGL_PRIORITY_QUEUE_ARITY 2
+sgl_define(sgl_priority_queue(unsigned, binary_less))
+
+#undef SGL_PRIORITY_QUEUE_ARITY
+#define SGL_PRIORITY_QUEUE_ARITY 4
+sgl_define(sgl_priority_queue(unsigned, quaternary_less))
+
+#undef SGL_PRIORITY_QUEUE_ARITY
+#define SGL_PRIORITY_QUEUE_ARITY 8
+sgl_define(sgl_priority_queue(unsigned, octonary_less))
+
+static unsigned next_random(unsigned* state)
+{
+    *state = *state * 1103515245u + 12345u;
+    return *state >> 1;
+}
+
+// Pushes n random values then pops them all, then runs n
+// pop + push operations on a full queue, like a timer wheel
+#define BENCH_QUEUE(name, type)                                                     \
+    do {                                                                            \
+        type* queue = sgl_new(type);                                                \
+        unsigned state = 42;                                                        \
+        double start = bench_now();                                                 \
+        for (size_t i = 0 ; i < count ; ++i)                                        \
+        {                                                                           \
+            sgl_push(queue, next_random(&state));                                   \
+        }                                                                           \
+        double push = bench_now() - start;                                          \
+        start = bench_now();                                                        \
+        while (not sgl_is_empty(queue))                                             \
+        {                                                                           \
+            bench_sink += sgl_top(queue);                                           \
+            sgl_pop(queue, NULL);                                                   \
+        }                                                                           \
+        double pop = bench_now() - start;                                           \
+                                                                                    \
+        sgl_vector(unsigned)* values = sgl_new_with_capacity(sgl_vector(unsigned),  \
+                                                             count);                \
+        for (size_t i = 0 ; i < count ; ++i)                                        \
+        {                                                                           \
+            sgl_push_back(values, next_random(&state));                             \
+        }                                                                           \
+        start = bench_now();                                                        \
+        sgl_make_heap_vector(queue, values);                                        \
+        double heapify = bench_now() - start;                                       \
+        start = bench_now();                                                        \
+        for (size_t i = 0 ; i < count ; ++i)                                        \
+        {                                                                           \
+            unsigned top;                                                           \
+            sgl_pop(queue, &top);                                                   \
+            sgl_push(queue, top - next_random(&state) % 1024);                      \
+        }                                                                           \
+        double hold = bench_now() - start;                                          \
+        printf("%-8s %10.3f %10.3f %10.3f %10.3f\n", name,                          \
+               push * 1e3, pop * 1e3, heapify * 1e3, hold * 1e3);                   \
+        sgl_delete(values);                                                         \
+        sgl_delete(queue);                                                          \
+    } while (false)
+
+int main(int argc, char* argv[])
+{
+    size_t count = bench_arg(argc, argv, 1, 1000000);
+    printf("%zu elements, times in ms\n", count);
+    printf("arity          push        pop  make_heap  pop+push\n");
+    BENCH_QUEUE("2", sgl_priority_queue(unsigned, binary_less));
+    BENCH_QUEUE("4", sgl_priority_queue(unsigned, quaternary_less));
+    BENCH_QUEUE("8", sgl_priority_queue(unsigned, octonary_less));
+}
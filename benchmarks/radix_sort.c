@@ -0,0 +1,97 @@
+/*
+ * Copyright (C) 2015 Morwenn
+ *
+ * The SGL is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * The SGL is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program. If not,
+ * see <http://www.gnu.org/licenses/>.
+ */
+// cc -std=c11 -O2 -Iinclude benchmarks/radix_sort.c src/radix_sort.c src/exception.c
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sgl/algorithm.h>
+#include <sgl/utility.h>
+#include "bench.h"
+
+sgl_define(sgl_sort(int))
+sgl_define(sgl_sort(unsigned))
+sgl_define(sgl_sort(float))
+sgl_define(sgl_sort(double))
+
+#define compare(T)                                                                  \
+    static int compare_##T(const void* lhs, const void* rhs)                        \
+    {                                                                               \
+        T a = *(const T*) lhs;                                                      \
+        T b = *(const T*) rhs;                                                      \
+        return (a > b) - (a < b);                                                   \
+    }
+
+compare(int)
+compare(unsigned)
+compare(float)
+compare(double)
+
+static uint64_t next_random(uint64_t* state)
+{
+    *state = *state * UINT64_C(6364136223846793005) + UINT64_C(1442695040888963407);
+    return *state >> 16;
+}
+
+// Times qsort, sgl_sort and sgl_radix_sort on the same values
+#define run(T, name, make)                                                          \
+    do {                                                                            \
+        T* original = malloc(size * sizeof(T));                                     \
+        T* values = malloc(size * sizeof(T));                                       \
+        uint64_t state = 42;                                                        \
+        for (size_t i = 0 ; i < size ; ++i)                                         \
+        {                                                                           \
+            uint64_t bits = next_random(&state);                                    \
+            original[i] = make;                                                     \
+        }                                                                           \
+                                                                                    \
+        memcpy(values, original, size * sizeof(T));                                 \
+        double start = bench_now();                                                 \
+        qsort(values, size, sizeof(T), &compare_##T);                               \
+        double qsort_time = bench_now() - start;                                    \
+                                                                                    \
+        memcpy(values, original, size * sizeof(T));                                 \
+        start = bench_now();                                                        \
+        sgl_sort(T)(values, values + size);                                         \
+        double sort_time = bench_now() - start;                                     \
+                                                                                    \
+        memcpy(values, original, size * sizeof(T));                                 \
+        start = bench_now();                                                        \
+        sgl_radix_sort(values, values + size);                                      \
+        double radix_time = bench_now() - start;                                    \
+                                                                                    \
+        printf("%-18s %10.3f %10.3f %10.3f %10.1f\n", name, qsort_time * 1e3,       \
+               sort_time * 1e3, radix_time * 1e3, size / radix_time * 1e-6);        \
+        bench_sink += (size_t) values[size / 2];                                    \
+        free(values);                                                               \
+        free(original);                                                             \
+    } while (false)
+
+int main(int argc, char* argv[])
+{
+    size_t size = bench_arg(argc, argv, 1, 10000000);
+
+    printf("%zu elements, times in ms\n", size);
+    printf("%-18s %10s %10s %10s %10s\n", "", "qsort", "sgl_sort", "radix", "Mkeys/s");
+    run(int, "int", (int) bits);
+    run(int, "int [0, 1000)", (int) (bits % 1000));
+    run(unsigned, "unsigned", (unsigned) bits);
+    run(float, "float", (float) (int32_t) bits * 1e-3f);
+    run(double, "double", (double) (int64_t) (bits << 16) * 1e-9);
+}
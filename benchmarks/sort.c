@@ -0,0 +1,116 @@
+/*
+ * Copyright (C) 2015 Morwenn
+ *
+ * The SGL is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * The SGL is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program. If not,
+ * see <http://www.gnu.org/licenses/>.
+ */
+// cc -std=c11 -O2 -Iinclude benchmarks/sort.c src/exception.c
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sgl/algorithm.h>
+#include <sgl/utility.h>
+#include "bench.h"
+
+sgl_define(sgl_sort(int))
+sgl_define(sgl_stable_sort(int))
+sgl_define(sgl_sort(double))
+
+static int compare_int(const void* lhs, const void* rhs)
+{
+    int a = *(const int*) lhs;
+    int b = *(const int*) rhs;
+    return (a > b) - (a < b);
+}
+
+static int compare_double(const void* lhs, const void* rhs)
+{
+    double a = *(const double*) lhs;
+    double b = *(const double*) rhs;
+    return (a > b) - (a < b);
+}
+
+static const char* patterns[] = { "random", "sorted", "reversed", "few unique" };
+
+static int pattern_value(int pattern, size_t i, size_t size)
+{
+    switch (pattern)
+    {
+        case 0: return rand();
+        case 1: return (int) i;
+        case 2: return (int) (size - i);
+        default: return rand() % 100;
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    size_t size = bench_arg(argc, argv, 1, 1000000);
+    int* original = malloc(size * sizeof(int));
+    int* values = malloc(size * sizeof(int));
+    double* doubles = malloc(size * sizeof(double));
+
+    printf("%zu elements, times in ms\n", size);
+    printf("%-12s %10s %10s %12s %12s %12s\n", "int", "qsort", "sgl_sort",
+           "stable_sort", "qsort double", "sgl double");
+    for (int pattern = 0 ; pattern < 4 ; ++pattern)
+    {
+        srand(42);
+        for (size_t i = 0 ; i < size ; ++i)
+        {
+            original[i] = pattern_value(pattern, i, size);
+        }
+
+        memcpy(values, original, size * sizeof(int));
+        double start = bench_now();
+        qsort(values, size, sizeof(int), &compare_int);
+        double qsort_time = bench_now() - start;
+
+        memcpy(values, original, size * sizeof(int));
+        start = bench_now();
+        sgl_sort(int)(values, values + size);
+        double sort_time = bench_now() - start;
+
+        memcpy(values, original, size * sizeof(int));
+        start = bench_now();
+        sgl_stable_sort(int)(values, values + size);
+        double stable_time = bench_now() - start;
+
+        for (size_t i = 0 ; i < size ; ++i)
+        {
+            doubles[i] = original[i] * 0.5;
+        }
+        start = bench_now();
+        qsort(doubles, size, sizeof(double), &compare_double);
+        double qsort_double_time = bench_now() - start;
+
+        for (size_t i = 0 ; i < size ; ++i)
+        {
+            doubles[i] = original[i] * 0.5;
+        }
+        start = bench_now();
+        sgl_sort(double)(doubles, doubles + size);
+        double sort_double_time = bench_now() - start;
+
+        printf("%-12s %10.3f %10.3f %12.3f %12.3f %12.3f\n", patterns[pattern],
+               qsort_time * 1e3, sort_time * 1e3, stable_time * 1e3,
+               qsort_double_time * 1e3, sort_double_time * 1e3);
+        bench_sink += values[size / 2] + (size_t) doubles[size / 2];
+    }
+
+    free(doubles);
+    free(values);
+    free(original);
+}
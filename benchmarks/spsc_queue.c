@@ -0,0 +1,247 @@
+/*
+ * Copyright (C) 2015 Morwenn
+ *
+ * The SGL is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * The SGL is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program. If not,
+ * see <http://www.gnu.org/licenses/>.
+ */
+// cc -std=c11 -O2 -Iinclude benchmarks/spsc_queue.c src/exception.c -lpthread
+
+#include <stdio.h>
+#include <threads.h>
+#include <sgl/spsc_queue.h>
+#include <sgl/utility.h>
+#include <sgl/vector.h>
+#include "bench.h"
+
+sgl_define(sgl_vector(size_t))
+sgl_define(sgl_spsc_queue(size_t))
+
+enum { batch_size = 64 };
+
+static size_t count;
+
+////////////////////////////////////////////////////////////
+// Baseline: a vector protected by a mutex, the consumer
+// swaps it with an empty one to drain it
+
+static mtx_t mutex;
+static sgl_vector(size_t)* shared;
+
+static int locked_produce(void* arg)
+{
+    (void) arg;
+    for (size_t i = 0 ; i < count ; ++i)
+    {
+        mtx_lock(&mutex);
+        sgl_push_back(shared, i);
+        mtx_unlock(&mutex);
+    }
+    return 0;
+}
+
+static double locked_run(void)
+{
+    mtx_init(&mutex, mtx_plain);
+    shared = sgl_new(sgl_vector(size_t));
+    sgl_vector(size_t)* local = sgl_new(sgl_vector(size_t));
+
+    double start = bench_now();
+    thrd_t producer;
+    thrd_create(&producer, &locked_produce, NULL);
+    size_t received = 0;
+    while (received < count)
+    {
+        mtx_lock(&mutex);
+        sgl_vector(size_t)* tmp = shared;
+        shared = local;
+        local = tmp;
+        mtx_unlock(&mutex);
+        for (size_t i = 0 ; i < sgl_size(local) ; ++i)
+        {
+            bench_sink += sgl_at(local, i);
+        }
+        received += sgl_size(local);
+        if (sgl_is_empty(local))
+        {
+            thrd_yield();
+        }
+        sgl_clear(local);
+    }
+    thrd_join(producer, NULL);
+    double elapsed = bench_now() - start;
+
+    sgl_delete(shared);
+    sgl_delete(local);
+    mtx_destroy(&mutex);
+    return elapsed;
+}
+
+////////////////////////////////////////////////////////////
+// Lock-free queue, one element or one batch at a time
+
+static sgl_spsc_queue(size_t)* queue;
+
+static int single_produce(void* arg)
+{
+    (void) arg;
+    for (size_t i = 0 ; i < count ; ++i)
+    {
+        while (not sgl_try_push(queue, i))
+        {
+            thrd_yield();
+        }
+    }
+    return 0;
+}
+
+static int batch_produce(void* arg)
+{
+    (void) arg;
+    size_t batch[batch_size];
+    for (size_t i = 0 ; i < count ; )
+    {
+        size_t n = 0;
+        while (n < batch_size && i + n < count)
+        {
+            batch[n] = i + n;
+            ++n;
+        }
+        for (size_t done = 0 ; done < n ; )
+        {
+            size_t pushed = sgl_push_n(queue, batch + done, n - done);
+            if (pushed == 0)
+            {
+                thrd_yield();
+            }
+            done += pushed;
+        }
+        i += n;
+    }
+    return 0;
+}
+
+static double queue_run(bool batched)
+{
+    queue = sgl_new_with_capacity(sgl_spsc_queue(size_t), 4096);
+
+    double start = bench_now();
+    thrd_t producer;
+    thrd_create(&producer, batched ? &batch_produce : &single_produce, NULL);
+    size_t received = 0;
+    while (received < count)
+    {
+        if (batched)
+        {
+            size_t batch[batch_size];
+            size_t n = sgl_pop_n(queue, batch, batch_size);
+            for (size_t i = 0 ; i < n ; ++i)
+            {
+                bench_sink += batch[i];
+            }
+            received += n;
+            if (n == 0)
+            {
+                thrd_yield();
+            }
+        }
+        else
+        {
+            size_t value;
+            if (sgl_try_pop(queue, &value))
+            {
+                bench_sink += value;
+                ++received;
+            }
+            else
+            {
+                thrd_yield();
+            }
+        }
+    }
+    thrd_join(producer, NULL);
+    double elapsed = bench_now() - start;
+
+    sgl_delete(queue);
+    return elapsed;
+}
+
+////////////////////////////////////////////////////////////
+// Latency: a value goes back and forth between two threads
+
+static sgl_spsc_queue(size_t)* ping;
+static sgl_spsc_queue(size_t)* pong;
+
+static int echo(void* arg)
+{
+    size_t round_trips = *(size_t*) arg;
+    for (size_t i = 0 ; i < round_trips ; ++i)
+    {
+        size_t value;
+        while (not sgl_try_pop(ping, &value))
+        {
+            thrd_yield();
+        }
+        while (not sgl_try_push(pong, value))
+        {
+            thrd_yield();
+        }
+    }
+    return 0;
+}
+
+static double latency_run(size_t round_trips)
+{
+    ping = sgl_new_with_capacity(sgl_spsc_queue(size_t), 16);
+    pong = sgl_new_with_capacity(sgl_spsc_queue(size_t), 16);
+
+    thrd_t echoer;
+    thrd_create(&echoer, &echo, &round_trips);
+    double start = bench_now();
+    for (size_t i = 0 ; i < round_trips ; ++i)
+    {
+        size_t value;
+        sgl_try_push(ping, i);
+        while (not sgl_try_pop(pong, &value))
+        {
+            thrd_yield();
+        }
+        bench_sink += value;
+    }
+    double elapsed = bench_now() - start;
+    thrd_join(echoer, NULL);
+
+    sgl_delete(ping);
+    sgl_delete(pong);
+    return elapsed;
+}
+
+int main(int argc, char* argv[])
+{
+    count = bench_arg(argc, argv, 1, 10000000);
+    size_t round_trips = bench_arg(argc, argv, 2, 100000);
+    printf("%zu elements from one thread to another\n", count);
+
+    double elapsed = locked_run();
+    printf("mutex + vector: %10.3f ms %8.2f Mops/s\n",
+           elapsed * 1e3, count / elapsed * 1e-6);
+    elapsed = queue_run(false);
+    printf("spsc single:    %10.3f ms %8.2f Mops/s\n",
+           elapsed * 1e3, count / elapsed * 1e-6);
+    elapsed = queue_run(true);
+    printf("spsc batch %d:  %10.3f ms %8.2f Mops/s\n", batch_size,
+           elapsed * 1e3, count / elapsed * 1e-6);
+
+    elapsed = latency_run(round_trips);
+    printf("round trip:     %10.3f ns\n", elapsed / round_trips * 1e9);
+}
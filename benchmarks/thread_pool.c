@@ -0,0 +1,154 @@
+/*
+ * Copyright (C) 2015 Morwenn
+ *
+ * The SGL is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * The SGL is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program. If not,
+ * see <http://www.gnu.org/licenses/>.
+ */
+// cc -std=c11 -O2 -Iinclude benchmarks/thread_pool.c src/thread_pool.c src/thread.c src/exception.c -lm -lpthread
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <sgl/thread.h>
+#include <sgl/utility.h>
+#include <sgl/vector.h>
+#include "bench.h"
+
+sgl_define(sgl_vector(double))
+
+////////////////////////////////////////////////////////////
+// Fork-join fibonacci, one task per call above the cutoff
+
+typedef struct
+{
+    sgl_thread_pool* pool;
+    int n;
+    int cutoff;
+    long result;
+} fib_args;
+
+static long serial_fib(int n)
+{
+    return n < 2 ? n : serial_fib(n - 1) + serial_fib(n - 2);
+}
+
+static void fib(void* arg)
+{
+    fib_args* args = arg;
+    if (args->n <= args->cutoff)
+    {
+        args->result = serial_fib(args->n);
+        return;
+    }
+    fib_args left = { args->pool, args->n - 1, args->cutoff, 0 };
+    fib_args right = { args->pool, args->n - 2, args->cutoff, 0 };
+    sgl_task_group group;
+    sgl_task_group_init(&group, args->pool);
+    sgl_spawn(&group, &fib, &left);
+    fib(&right);
+    sgl_wait(&group);
+    args->result = left.result + right.result;
+}
+
+////////////////////////////////////////////////////////////
+// Parallel for over a vector, split in halves down to a grain
+
+typedef struct
+{
+    sgl_thread_pool* pool;
+    double* first;
+    double* last;
+    size_t grain;
+} for_args;
+
+static void process(double* first, double* last)
+{
+    for (; first != last ; ++first)
+    {
+        *first = sqrt(*first * *first + 1.0);
+    }
+}
+
+static void parallel_for(void* arg)
+{
+    for_args* args = arg;
+    size_t size = (size_t) (args->last - args->first);
+    if (size <= args->grain)
+    {
+        process(args->first, args->last);
+        return;
+    }
+    double* middle = args->first + size / 2;
+    for_args left = { args->pool, args->first, middle, args->grain };
+    for_args right = { args->pool, middle, args->last, args->grain };
+    sgl_task_group group;
+    sgl_task_group_init(&group, args->pool);
+    sgl_spawn(&group, &parallel_for, &left);
+    parallel_for(&right);
+    sgl_wait(&group);
+}
+
+// Usage: thread_pool [fib n] [vector size] [max threads]
+int main(int argc, char* argv[])
+{
+    int n = (int) bench_arg(argc, argv, 1, 30);
+    size_t size = bench_arg(argc, argv, 2, 10000000);
+    size_t max_threads = bench_arg(argc, argv, 3, sgl_hardware_concurrency());
+
+    sgl_vector(double)* vec = sgl_new(sgl_vector(double));
+    for (size_t i = 0 ; i < size ; ++i)
+    {
+        sgl_push_back(vec, (double) i);
+    }
+
+    double start = bench_now();
+    bench_sink += (size_t) serial_fib(n);
+    double fib_time = bench_now() - start;
+
+    start = bench_now();
+    process(sgl_begin(vec), sgl_end(vec));
+    double for_time = bench_now() - start;
+
+    printf("fib(%d) and parallel for over %zu doubles, times in ms\n", n, size);
+    printf("%-10s %12s %12s %12s %12s\n", "threads", "fib cutoff 0",
+           "fib cutoff 16", "for grain 1k", "for grain 64k");
+    printf("%-10s %12.3f %12.3f %12.3f %12.3f\n", "serial", fib_time * 1e3,
+           fib_time * 1e3, for_time * 1e3, for_time * 1e3);
+    for (size_t threads = 1 ; threads <= max_threads ; ++threads)
+    {
+        sgl_thread_pool* pool = sgl_thread_pool_new(threads);
+        double times[4];
+        for (int i = 0 ; i < 2 ; ++i)
+        {
+            fib_args args = { pool, n, i == 0 ? 1 : 16, 0 };
+            start = bench_now();
+            fib(&args);
+            times[i] = bench_now() - start;
+            bench_sink += (size_t) args.result;
+        }
+        for (int i = 0 ; i < 2 ; ++i)
+        {
+            size_t grain = i == 0 ? 1024 : 65536;
+            for_args args = { pool, sgl_begin(vec), sgl_end(vec), grain };
+            start = bench_now();
+            parallel_for(&args);
+            times[i + 2] = bench_now() - start;
+        }
+        printf("%-10zu %12.3f %12.3f %12.3f %12.3f\n", threads, times[0] * 1e3,
+               times[1] * 1e3, times[2] * 1e3, times[3] * 1e3);
+        sgl_thread_pool_delete(pool);
+    }
+    bench_sink += (size_t) sgl_at(vec, size / 2);
+    sgl_delete(vec);
+}
@@ -0,0 +1,124 @@
+/*
+ * Copyright (C) 2015 Morwenn
+ *
+ * The SGL is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * The SGL is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program. If not,
+ * see <http://www.gnu.org/licenses/>.
+ */
+// cc -std=c11 -O2 -Iinclude benchmarks/try_push_back.c src/exception.c
+
+#include <stdio.h>
+#include <sgl/collection.h>
+#include <sgl/exception.h>
+#include <sgl/utility.h>
+#include <sgl/vector.h>
+#include "bench.h"
+
+sgl_define(sgl_vector(double))
+
+// Every variant fills the same vector, whose memory is already
+// reserved, so that only the error handling costs are measured
+
+static void fill_unchecked(sgl_vector(double)* vec, size_t count)
+{
+    for (size_t i = 0 ; i < count ; ++i)
+    {
+        sgl_push_back(vec, (double) i);
+    }
+}
+
+static bool push_back_in_try(sgl_vector(double)* vec, double value)
+{
+    sgl_try
+    {
+        sgl_push_back(vec, value);
+    }
+    sgl_catch(sgl_bad_alloc)
+    {
+        return false;
+    }
+    sgl_endtry
+    return true;
+}
+
+static void fill_try_per_call(sgl_vector(double)* vec, size_t count)
+{
+    for (size_t i = 0 ; i < count ; ++i)
+    {
+        if (not push_back_in_try(vec, (double) i))
+        {
+            return;
+        }
+    }
+}
+
+static void fill_try_once(sgl_vector(double)* vec, size_t count)
+{
+    sgl_try
+    {
+        fill_unchecked(vec, count);
+    }
+    sgl_catch(sgl_bad_alloc)
+    {
+        return;
+    }
+    sgl_endtry
+}
+
+static void fill_error_code(sgl_vector(double)* vec, size_t count)
+{
+    for (size_t i = 0 ; i < count ; ++i)
+    {
+        if (sgl_try_push_back(vec, (double) i) != sgl_no_exception)
+        {
+            return;
+        }
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    size_t count = bench_arg(argc, argv, 1, 1000000);
+    size_t rounds = bench_arg(argc, argv, 2, 20);
+    printf("push_back of %zu doubles, %zu rounds\n", count, rounds);
+
+    struct
+    {
+        const char* name;
+        void (*fill)(sgl_vector(double)*, size_t);
+    } variants[] = {
+        { "unchecked", fill_unchecked },
+        { "sgl_try per call", fill_try_per_call },
+        { "sgl_try per loop", fill_try_once },
+        { "error code", fill_error_code }
+    };
+
+    sgl_vector(double)* vec = sgl_new(sgl_vector(double));
+    sgl_reserve(vec, count);
+
+    for (size_t i = 0 ; i < sizeof variants / sizeof *variants ; ++i)
+    {
+        double start = bench_now();
+        for (size_t j = 0 ; j < rounds ; ++j)
+        {
+            sgl_clear(vec);
+            variants[i].fill(vec, count);
+            bench_sink += sgl_size(vec);
+        }
+        double elapsed = bench_now() - start;
+        printf("%-18s %10.3f ms  %8.2f ns/elem\n", variants[i].name,
+               elapsed * 1e3, elapsed / (count * rounds) * 1e9);
+    }
+
+    sgl_delete(vec);
+}
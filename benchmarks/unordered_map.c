@@ -0,0 +1,227 @@
+/*
+ * Copyright (C) 2015 Morwenn
+ *
+ * The SGL is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * The SGL is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program. If not,
+ * see <http://www.gnu.org/licenses/>.
+ */
+// Usage: unordered_map [max_keys]
+// Runs with 1M, 10M, 100M... keys up to max_keys (10M by default).
+// 100M keys need about 8GB of memory.
+
+#include <stdint.h>
+#include <stdio.h>
+#include <sgl/hash.h>
+#include <sgl/unordered_map.h>
+#include <sgl/utility.h>
+#include "bench.h"
+
+sgl_define(sgl_unordered_map(uint64_t, uint64_t))
+
+////////////////////////////////////////////////////////////
+// Chained hash table, one allocation per node
+
+typedef struct chained_node
+{
+    struct chained_node* next;
+    uint64_t key;
+    uint64_t value;
+} chained_node;
+
+typedef struct
+{
+    chained_node** buckets;
+    size_t bucket_count;
+    size_t size;
+} chained_table;
+
+static size_t chained_bucket(const chained_table* table, uint64_t key)
+{
+    return sgl_hash(key) & (table->bucket_count - 1);
+}
+
+static void chained_grow(chained_table* table)
+{
+    size_t old_count = table->bucket_count;
+    chained_node** old_buckets = table->buckets;
+    table->bucket_count = old_count ? old_count * 2 : 16;
+    table->buckets = calloc(table->bucket_count, sizeof(chained_node*));
+    for (size_t i = 0 ; i < old_count ; ++i)
+    {
+        chained_node* node = old_buckets[i];
+        while (node)
+        {
+            chained_node* next = node->next;
+            size_t bucket = chained_bucket(table, node->key);
+            node->next = table->buckets[bucket];
+            table->buckets[bucket] = node;
+            node = next;
+        }
+    }
+    free(old_buckets);
+}
+
+static uint64_t* chained_find(const chained_table* table, uint64_t key)
+{
+    if (table->size == 0)
+    {
+        return NULL;
+    }
+    for (chained_node* node = table->buckets[chained_bucket(table, key)] ;
+         node ; node = node->next)
+    {
+        if (node->key == key)
+        {
+            return &node->value;
+        }
+    }
+    return NULL;
+}
+
+static void chained_insert(chained_table* table, uint64_t key, uint64_t value)
+{
+    if (chained_find(table, key))
+    {
+        return;
+    }
+    if (table->size >= table->bucket_count)
+    {
+        chained_grow(table);
+    }
+    chained_node* node = malloc(sizeof(chained_node));
+    size_t bucket = chained_bucket(table, key);
+    node->key = key;
+    node->value = value;
+    node->next = table->buckets[bucket];
+    table->buckets[bucket] = node;
+    ++table->size;
+}
+
+static void chained_destroy(chained_table* table)
+{
+    for (size_t i = 0 ; i < table->bucket_count ; ++i)
+    {
+        chained_node* node = table->buckets[i];
+        while (node)
+        {
+            chained_node* next = node->next;
+            free(node);
+            node = next;
+        }
+    }
+    free(table->buckets);
+}
+
+////////////////////////////////////////////////////////////
+// Benchmark
+
+static uint64_t random_key(uint64_t* state)
+{
+    // splitmix64
+    uint64_t z = (*state += UINT64_C(0x9e3779b97f4a7c15));
+    z = (z ^ (z >> 30)) * UINT64_C(0xbf58476d1ce4e5b9);
+    z = (z ^ (z >> 27)) * UINT64_C(0x94d049bb133111eb);
+    return z ^ (z >> 31);
+}
+
+static void report(const char* name, double elapsed, size_t count)
+{
+    printf("  %-22s %10.3f ms  %8.2f Mops/s\n", name, elapsed * 1e3,
+           count / elapsed * 1e-6);
+}
+
+static void run(size_t count)
+{
+    printf("%zu keys\n", count);
+
+    // Look the keys up in another order than the insertion one so
+    // that the nodes of the chained table are not read sequentially
+    uint64_t* keys = malloc(count * sizeof(uint64_t));
+    uint64_t* lookups = malloc(count * sizeof(uint64_t));
+    uint64_t* misses = malloc(count * sizeof(uint64_t));
+    uint64_t state = 0;
+    for (size_t i = 0 ; i < count ; ++i)
+    {
+        keys[i] = lookups[i] = random_key(&state);
+        misses[i] = random_key(&state);
+    }
+    for (size_t i = count - 1 ; i > 0 ; --i)
+    {
+        size_t j = random_key(&state) % (i + 1);
+        uint64_t tmp = lookups[i];
+        lookups[i] = lookups[j];
+        lookups[j] = tmp;
+    }
+
+    // Swiss table
+    sgl_unordered_map(uint64_t, uint64_t)* map =
+        sgl_new(sgl_unordered_map(uint64_t, uint64_t));
+    double start = bench_now();
+    for (size_t i = 0 ; i < count ; ++i)
+    {
+        sgl_insert(map, keys[i], i);
+    }
+    report("sgl insert", bench_now() - start, count);
+
+    start = bench_now();
+    for (size_t i = 0 ; i < count ; ++i)
+    {
+        bench_sink += *sgl_find(map, lookups[i]);
+    }
+    report("sgl find (hit)", bench_now() - start, count);
+
+    start = bench_now();
+    for (size_t i = 0 ; i < count ; ++i)
+    {
+        bench_sink += sgl_find(map, misses[i]) != NULL;
+    }
+    report("sgl find (miss)", bench_now() - start, count);
+    sgl_delete(map);
+
+    // Chained table
+    chained_table table = { NULL, 0, 0 };
+    start = bench_now();
+    for (size_t i = 0 ; i < count ; ++i)
+    {
+        chained_insert(&table, keys[i], i);
+    }
+    report("chained insert", bench_now() - start, count);
+
+    start = bench_now();
+    for (size_t i = 0 ; i < count ; ++i)
+    {
+        bench_sink += *chained_find(&table, lookups[i]);
+    }
+    report("chained find (hit)", bench_now() - start, count);
+
+    start = bench_now();
+    for (size_t i = 0 ; i < count ; ++i)
+    {
+        bench_sink += chained_find(&table, misses[i]) != NULL;
+    }
+    report("chained find (miss)", bench_now() - start, count);
+    chained_destroy(&table);
+
+    free(keys);
+    free(lookups);
+    free(misses);
+}
+
+int main(int argc, char* argv[])
+{
+    size_t max_keys = bench_arg(argc, argv, 1, 10000000);
+    for (size_t count = 1000000 ; count <= max_keys ; count *= 10)
+    {
+        run(count);
+    }
+}
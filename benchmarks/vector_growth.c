@@ -0,0 +1,63 @@
+/*
+ * Copyright (C) 2015 Morwenn
+ *
+ * The SGL is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * The SGL is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program. If not,
+ * see <http://www.gnu.org/licenses/>.
+ */
+#include <stdio.h>
+#include <sgl/memory.h>
+#include <sgl/utility.h>
+#include <sgl/vector.h>
+#include "bench.h"
+
+sgl_define(sgl_vector(double))
+
+static double fill(sgl_growth_policy policy, size_t count)
+{
+    sgl_set_growth_policy(sgl_vector(double), policy);
+    double start = bench_now();
+
+    sgl_vector(double)* vec = sgl_new(sgl_vector(double));
+    for (size_t i = 0 ; i < count ; ++i)
+    {
+        sgl_push_back(vec, (double) i);
+    }
+    bench_sink += sgl_size(vec);
+    sgl_delete(vec);
+
+    return bench_now() - start;
+}
+
+int main(int argc, char* argv[])
+{
+    size_t count = bench_arg(argc, argv, 1, 1000000);
+    printf("push_back of %zu doubles\n", count);
+
+    struct
+    {
+        const char* name;
+        sgl_growth_policy policy;
+    } policies[] = {
+        { "linear (+40)", sgl_growth_linear },
+        { "factor 1.5", sgl_growth_factor_1_5 },
+        { "factor 2", sgl_growth_factor_2 }
+    };
+
+    for (size_t i = 0 ; i < sizeof policies / sizeof *policies ; ++i)
+    {
+        double elapsed = fill(policies[i].policy, count);
+        printf("%-14s %10.3f ms  %8.1f Mops/s\n", policies[i].name,
+               elapsed * 1e3, count / elapsed * 1e-6);
+    }
+}
@@ -31,16 +31,14 @@ int main()
     sgl_vector(double)* vec_d = sgl_new(sgl_vector(double));
 
     printf("is_empty: %d\n", sgl_is_empty(vec_i));
-    printf("size: %u\n", sgl_size(vec_i));
-    printf("max_size: %u\n", sgl_max_size(vec_i));
-    printf("capacity: %u\n", sgl_capacity(vec_i));
-    printf("front: %d == %d\n", sgl_front(vec_i), sgl_at(vec_i, 0));
-    printf("back: %d == %d\n", sgl_back(vec_i), sgl_at(vec_i, 2));
+    printf("size: %zu\n", sgl_size(vec_i));
+    printf("max_size: %zu\n", sgl_max_size(vec_i));
+    printf("capacity: %zu\n", sgl_capacity(vec_i)); // 0
 
     sgl_reserve(vec_d, 56);
-    printf("capacity: %d\n", sgl_capacity(vec_d)); // 56
+    printf("capacity: %zu\n", sgl_capacity(vec_d)); // 56
     sgl_reserve(vec_d, 30);
-    printf("capacity: %d\n", sgl_capacity(vec_d)); // 56
+    printf("capacity: %zu\n", sgl_capacity(vec_d)); // 56
 
     for (int i = 0 ; i < 3 ; ++i)
     {
@@ -56,7 +54,7 @@ int main()
     printf("\n");
 
     sgl_shrink_to_fit(vec_d);
-    printf("capacity: %d\n", sgl_capacity(vec_d)); // 3
+    printf("capacity: %zu\n", sgl_capacity(vec_d)); // 3
 
     assert(sgl_data(vec_d) == vec_d->_data);
     assert(sgl_back(vec_d) == sgl_at(vec_d, 2));
@@ -65,17 +63,19 @@ int main()
     {
         sgl_push_back(vec_i, i);
     }
-    printf("size: %u\n", sgl_size(vec_i)); // 5
-    printf("capacity: %d\n", sgl_capacity(vec_i)); // 40
+    printf("size: %zu\n", sgl_size(vec_i)); // 5
+    printf("capacity: %zu\n", sgl_capacity(vec_i)); // 6
+    printf("front: %d == %d\n", sgl_front(vec_i), sgl_at(vec_i, 0));
+    printf("back: %d == %d\n", sgl_back(vec_i), sgl_at(vec_i, 4));
     sgl_pop_back(vec_i);
     sgl_pop_back(vec_i);
     sgl_shrink_to_fit(vec_i);
-    printf("size: %u\n", sgl_size(vec_i)); // 3
-    printf("capacity: %d\n", sgl_capacity(vec_i)); // 3
+    printf("size: %zu\n", sgl_size(vec_i)); // 3
+    printf("capacity: %zu\n", sgl_capacity(vec_i)); // 3
     int foo = 8;
     sgl_push_back(vec_i, foo);
-    printf("size: %u\n", sgl_size(vec_i)); // 4
-    printf("capacity: %d\n", sgl_capacity(vec_i)); // 43
+    printf("size: %zu\n", sgl_size(vec_i)); // 4
+    printf("capacity: %zu\n", sgl_capacity(vec_i)); // 4
 
     sgl_delete(vec_i);
     sgl_delete(vec_d);
@@ -110,8 +110,32 @@ int main()
         printf("%d ", sgl_at(vi, i));
     }
 
+    // insert methods (overloading test)
+    printf("\n");
+    sgl_insert(vi, sgl_begin(vi), 0);
+    sgl_insert(vi, sgl_begin(vi)+3, 3, 4);
+    int values[] = { 3, 4, 5 };
+    sgl_insert(vi, sgl_begin(vi)+3, values, values+3);
+    for (size_t i = 0 ; i < sgl_size(vi) ; ++i)
+    {
+        // 0 1 2 3 4 5 4 4 4 6 7 8 9
+        printf("%d ", sgl_at(vi, i));
+    }
+
     sgl_delete(vi);
 
+    // vector with automatic storage duration
+    sgl_vector(int) local;
+    sgl_init(sgl_vector(int), &local);
+    printf("\ncapacity: %zu\n", sgl_capacity(&local)); // 0
+    sgl_push_back(&local, 42);
+    printf("%d\n", sgl_front(&local)); // 42
+    sgl_destroy(&local);
+
+    sgl_vector(int)* big = sgl_new_with_capacity(sgl_vector(int), 1000);
+    printf("capacity: %zu\n", sgl_capacity(big)); // 1000
+    sgl_delete(big);
+
     // resize methods (overloading test)
     sgl_vector(float)* vf = sgl_new(sgl_vector(float));
 
@@ -122,7 +146,7 @@ int main()
         printf("%f ", sgl_at(vf, i));
     }
     sgl_resize(vf, 3);
-    printf("\n%d\n", sgl_size(vf));
+    printf("\n%zu\n", sgl_size(vf));
 
     sgl_resize(vf, 8, 2.5);
     for (size_t i = 0 ; i < sgl_size(vf) ; ++i)
@@ -130,6 +154,21 @@ int main()
         printf("%f ", sgl_at(vf, i));
     }
 
+
+    // bulk methods
+    float floats[] = { 1.0f, 2.0f, 3.0f };
+    sgl_assign(vf, floats, floats+3);
+    sgl_append(vf, floats, 3);
+    sgl_append_vector(vf, vf);
+    printf("\n");
+    for (size_t i = 0 ; i < sgl_size(vf) ; ++i)
+    {
+        // 1.0 2.0 3.0 1.0 2.0 3.0 1.0 2.0 3.0 1.0 2.0 3.0
+        printf("%f ", sgl_at(vf, i));
+    }
+    sgl_assign(vf, 2, 0.5f);
+    printf("\n%zu\n", sgl_size(vf)); // 2
+
     sgl_delete(vf);
 
     // Operators tests
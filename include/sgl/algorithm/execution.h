@@ -0,0 +1,403 @@
+/*
+ * Copyright (C) 2015 Morwenn
+ *
+ * The SGL is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * The SGL is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program. If not,
+ * see <http://www.gnu.org/licenses/>.
+ */
+#ifndef SGL_ALGORITHM_EXECUTION_H_
+#define SGL_ALGORITHM_EXECUTION_H_
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <stddef.h>
+#include <sgl/memory/allocator.h>
+#include <sgl/detail/common.h>
+
+#ifndef SGL_PARALLEL_GRAIN
+
+    /**
+     * @def SGL_PARALLEL_GRAIN
+     *
+     * Minimal number of elements given to a task by the parallel
+     * algorithms. Ranges smaller than twice this number are always
+     * processed by the calling thread. It can be set with the
+     * compiler option -DSGL_PARALLEL_GRAIN=size when compiling
+     * execution.c.
+     */
+    #define SGL_PARALLEL_GRAIN 16384
+
+#endif
+
+/**
+ * @brief Execution policy of an algorithm.
+ *
+ * Every algorithm of this file takes an execution policy as first
+ * argument, which can not be omitted:
+ *
+ *   - sgl_seq processes the range in order in the calling thread.
+ *   - sgl_par splits the range into chunks processed concurrently
+ *     by the default thread pool and the calling thread. There are
+ *     at most four chunks per thread and at least
+ *     SGL_PARALLEL_GRAIN elements per chunk.
+ *   - sgl_par_unseq additionally lets sgl_reduce combine the
+ *     elements of a chunk in several interleaved accumulators,
+ *     which the compiler can vectorize; op must then also be
+ *     commutative. The loops of the other algorithms can already
+ *     be vectorized with every policy.
+ *
+ * With the parallel policies, the functions may be called
+ * concurrently from several threads and must not throw. When the
+ * default thread pool or the memory needed by an algorithm can
+ * not be obtained, the range is processed by the calling thread.
+ */
+typedef enum
+{
+    sgl_seq,
+    sgl_par,
+    sgl_par_unseq
+} sgl_execution_policy;
+
+/**
+ * @def sgl_for_each(T, func)
+ *
+ * Name of the function generated for the given element type and
+ * function, which calls func(ptr) for every element of the range
+ * [first, last), ptr being a T* to the element:
+ *
+ *     #define scale(ptr) (*(ptr) *= 2)
+ *     sgl_define(sgl_for_each(int, scale))
+ *     sgl_for_each(int, scale)(sgl_par, sgl_begin(vec), sgl_end(vec));
+ *
+ * Like the comparison of sgl_sort, func is the name of a function
+ * or function-like macro and is called directly.
+ */
+#define sgl_for_each(T, func) \
+    sgl_for_each_##T##_##func
+
+/**
+ * @def sgl_transform(T, U, func)
+ *
+ * Name of the function generated for the given element types and
+ * function, which assigns func(value) to the element of type U at
+ * the same position in the range beginning at out, for every
+ * element value of type T of [first, last). The ranges may be the
+ * same but must not overlap otherwise.
+ */
+#define sgl_transform(T, U, func) \
+    sgl_transform_##T##_##U##_##func
+
+/**
+ * @def sgl_reduce(T, op)
+ *
+ * Name of the function generated for the given element type and
+ * operation, which returns the combination of init and of the
+ * elements of [first, last), op(acc, value) returning the
+ * combination of acc and value. The parallel policies reduce every
+ * chunk separately then combine the partial results in order, so
+ * op must be associative.
+ */
+#define sgl_reduce(T, op) \
+    sgl_reduce_##T##_##op
+
+/**
+ * @def sgl_count_if(T, pred)
+ *
+ * Name of the function generated for the given element type and
+ * predicate, which returns the number of elements value of
+ * [first, last) for which pred(value) is true.
+ */
+#define sgl_count_if(T, pred) \
+    sgl_count_if_##T##_##pred
+
+/**
+ * @def sgl_fill(policy, first, last, value)
+ *
+ * Assigns value to every element of [first, last). first and last
+ * may be evaluated more than once. The value is assigned to the
+ * first element, which is then copied with memcpy to the other
+ * ones, so no function has to be generated.
+ */
+#define sgl_fill(policy, first, last, value)                                        \
+    ((first) != (last) ? (void) (*(first) = (value)) : (void) 0,                    \
+     sgl_detail_fill_n((policy), (first), (size_t) ((last) - (first)),              \
+                       sizeof *(first)))
+
+////////////////////////////////////////////////////////////
+// Definition macros
+
+#define sgl_define_sgl_for_each(T, func)                                            \
+    sgl_declare_sgl_for_each(T, func)                                               \
+    sgl_instantiate_sgl_for_each(T, func)
+
+#define sgl_declare_sgl_for_each(T, func)                                           \
+    void sgl_for_each_##T##_##func(sgl_execution_policy policy,                     \
+                                   T* first, T* last);
+
+#define sgl_instantiate_sgl_for_each(T, func) \
+    sgl_detail_instantiate_for_each(T, func, T##_##func)
+
+#define sgl_define_sgl_transform(T, U, func)                                        \
+    sgl_declare_sgl_transform(T, U, func)                                           \
+    sgl_instantiate_sgl_transform(T, U, func)
+
+#define sgl_declare_sgl_transform(T, U, func)                                       \
+    void sgl_transform_##T##_##U##_##func(sgl_execution_policy policy,              \
+                                          const T* first, const T* last,            \
+                                          U* out);
+
+#define sgl_instantiate_sgl_transform(T, U, func) \
+    sgl_detail_instantiate_transform(T, U, func, T##_##U##_##func)
+
+#define sgl_define_sgl_reduce(T, op)                                                \
+    sgl_declare_sgl_reduce(T, op)                                                   \
+    sgl_instantiate_sgl_reduce(T, op)
+
+#define sgl_declare_sgl_reduce(T, op)                                               \
+    T sgl_reduce_##T##_##op(sgl_execution_policy policy,                            \
+                            const T* first, const T* last, T init);
+
+#define sgl_instantiate_sgl_reduce(T, op) \
+    sgl_detail_instantiate_reduce(T, op, T##_##op)
+
+#define sgl_define_sgl_count_if(T, pred)                                            \
+    sgl_declare_sgl_count_if(T, pred)                                               \
+    sgl_instantiate_sgl_count_if(T, pred)
+
+#define sgl_declare_sgl_count_if(T, pred)                                           \
+    size_t sgl_count_if_##T##_##pred(sgl_execution_policy policy,                   \
+                                     const T* first, const T* last);
+
+#define sgl_instantiate_sgl_count_if(T, pred) \
+    sgl_detail_instantiate_count_if(T, pred, T##_##pred)
+
+////////////////////////////////////////////////////////////
+// for_each
+
+#define sgl_detail_instantiate_for_each(T, func, N)                                 \
+                                                                                    \
+static void sgl_detail_for_each_chunk_##N(void* context, size_t index,              \
+                                          size_t first, size_t last)                \
+{                                                                                   \
+    (void) index;                                                                   \
+    T* data = context;                                                              \
+    for (size_t i = first ; i < last ; ++i)                                         \
+    {                                                                               \
+        func(data + i);                                                             \
+    }                                                                               \
+}                                                                                   \
+                                                                                    \
+void sgl_for_each_##N(sgl_execution_policy policy, T* first, T* last)               \
+{                                                                                   \
+    size_t size = (size_t) (last - first);                                          \
+    sgl_detail_run_chunks(sgl_detail_chunk_count(policy, size), size,               \
+                          &sgl_detail_for_each_chunk_##N, first);                   \
+}
+
+////////////////////////////////////////////////////////////
+// transform
+
+#define sgl_detail_instantiate_transform(T, U, func, N)                             \
+                                                                                    \
+typedef struct                                                                      \
+{                                                                                   \
+    const T* data;                                                                  \
+    U* out;                                                                         \
+} sgl_detail_transform_context_##N;                                                 \
+                                                                                    \
+static void sgl_detail_transform_chunk_##N(void* context, size_t index,             \
+                                           size_t first, size_t last)               \
+{                                                                                   \
+    (void) index;                                                                   \
+    sgl_detail_transform_context_##N* ctx = context;                                \
+    const T* data = ctx->data;                                                      \
+    U* out = ctx->out;                                                              \
+    for (size_t i = first ; i < last ; ++i)                                         \
+    {                                                                               \
+        out[i] = func(data[i]);                                                     \
+    }                                                                               \
+}                                                                                   \
+                                                                                    \
+void sgl_transform_##N(sgl_execution_policy policy, const T* first,                 \
+                       const T* last, U* out)                                       \
+{                                                                                   \
+    size_t size = (size_t) (last - first);                                          \
+    sgl_detail_transform_context_##N ctx = { first, out };                          \
+    sgl_detail_run_chunks(sgl_detail_chunk_count(policy, size), size,               \
+                          &sgl_detail_transform_chunk_##N, &ctx);                   \
+}
+
+////////////////////////////////////////////////////////////
+// reduce
+
+// Number of interleaved accumulators of sgl_reduce with sgl_par_unseq;
+// GCC keeps four of them in registers at -O2, but not eight
+enum { sgl_detail_reduce_lanes = 4 };
+
+#define sgl_detail_instantiate_reduce(T, op, N)                                     \
+                                                                                    \
+typedef struct                                                                      \
+{                                                                                   \
+    const T* data;                                                                  \
+    T* partials;                                                                    \
+    bool unseq;                                                                     \
+} sgl_detail_reduce_context_##N;                                                    \
+                                                                                    \
+/* Combines acc with the elements of [first, last) in order */                      \
+static inline T sgl_detail_reduce_fold_##N(const T* data, size_t first,             \
+                                           size_t last, T acc)                      \
+{                                                                                   \
+    for (size_t i = first ; i < last ; ++i)                                         \
+    {                                                                               \
+        acc = op(acc, data[i]);                                                     \
+    }                                                                               \
+    return acc;                                                                     \
+}                                                                                   \
+                                                                                    \
+/* Same as above, except that the elements are first combined in */                 \
+/* interleaved accumulators, which do not depend on each other */                   \
+static inline T sgl_detail_reduce_fold_unseq_##N(const T* data, size_t first,       \
+                                                 size_t last, T acc)                \
+{                                                                                   \
+    if (last - first >= 2 * sgl_detail_reduce_lanes)                                \
+    {                                                                               \
+        T lanes[sgl_detail_reduce_lanes];                                           \
+        for (size_t k = 0 ; k < sgl_detail_reduce_lanes ; ++k)                      \
+        {                                                                           \
+            lanes[k] = data[first + k];                                             \
+        }                                                                           \
+        first += sgl_detail_reduce_lanes;                                           \
+        for (; last - first >= sgl_detail_reduce_lanes ;                            \
+             first += sgl_detail_reduce_lanes)                                      \
+        {                                                                           \
+            for (size_t k = 0 ; k < sgl_detail_reduce_lanes ; ++k)                  \
+            {                                                                       \
+                lanes[k] = op(lanes[k], data[first + k]);                           \
+            }                                                                       \
+        }                                                                           \
+        acc = sgl_detail_reduce_fold_##N(lanes, 0, sgl_detail_reduce_lanes, acc);   \
+    }                                                                               \
+    return sgl_detail_reduce_fold_##N(data, first, last, acc);                      \
+}                                                                                   \
+                                                                                    \
+/* Every chunk starts from its first element, so no identity */                     \
+/* value is needed */                                                               \
+static void sgl_detail_reduce_chunk_##N(void* context, size_t index,                \
+                                        size_t first, size_t last)                  \
+{                                                                                   \
+    sgl_detail_reduce_context_##N* ctx = context;                                   \
+    const T* data = ctx->data;                                                      \
+    ctx->partials[index] = ctx->unseq                                               \
+        ? sgl_detail_reduce_fold_unseq_##N(data, first + 1, last, data[first])      \
+        : sgl_detail_reduce_fold_##N(data, first + 1, last, data[first]);           \
+}                                                                                   \
+                                                                                    \
+T sgl_reduce_##N(sgl_execution_policy policy, const T* first,                       \
+                 const T* last, T init)                                             \
+{                                                                                   \
+    size_t size = (size_t) (last - first);                                          \
+    size_t count = sgl_detail_chunk_count(policy, size);                            \
+    T* partials = count > 1                                                         \
+                ? sgl_detail_allocate(NULL, count * sizeof(T), alignof(T))          \
+                : NULL;                                                             \
+    if (not partials)                                                               \
+    {                                                                               \
+        return policy == sgl_par_unseq                                              \
+            ? sgl_detail_reduce_fold_unseq_##N(first, 0, size, init)                \
+            : sgl_detail_reduce_fold_##N(first, 0, size, init);                     \
+    }                                                                               \
+                                                                                    \
+    sgl_detail_reduce_context_##N ctx = {                                           \
+        first, partials, policy == sgl_par_unseq                                    \
+    };                                                                              \
+    sgl_detail_run_chunks(count, size, &sgl_detail_reduce_chunk_##N, &ctx);         \
+    init = sgl_detail_reduce_fold_##N(partials, 0, count, init);                    \
+    sgl_detail_deallocate(NULL, partials, count * sizeof(T));                       \
+    return init;                                                                    \
+}
+
+////////////////////////////////////////////////////////////
+// count_if
+
+#define sgl_detail_instantiate_count_if(T, pred, N)                                 \
+                                                                                    \
+typedef struct                                                                      \
+{                                                                                   \
+    const T* data;                                                                  \
+    size_t* counts;                                                                 \
+} sgl_detail_count_if_context_##N;                                                  \
+                                                                                    \
+static void sgl_detail_count_if_chunk_##N(void* context, size_t index,              \
+                                          size_t first, size_t last)                \
+{                                                                                   \
+    sgl_detail_count_if_context_##N* ctx = context;                                 \
+    const T* data = ctx->data;                                                      \
+    size_t count = 0;                                                               \
+    for (size_t i = first ; i < last ; ++i)                                         \
+    {                                                                               \
+        count += pred(data[i]) ? 1 : 0;                                             \
+    }                                                                               \
+    ctx->counts[index] = count;                                                     \
+}                                                                                   \
+                                                                                    \
+size_t sgl_count_if_##N(sgl_execution_policy policy, const T* first,                \
+                        const T* last)                                              \
+{                                                                                   \
+    size_t res = 0;                                                                 \
+    size_t size = (size_t) (last - first);                                          \
+    size_t count = sgl_detail_chunk_count(policy, size);                            \
+    size_t* counts = count > 1                                                      \
+                   ? sgl_detail_allocate(NULL, count * sizeof(size_t),              \
+                                         alignof(size_t))                           \
+                   : NULL;                                                          \
+    if (not counts)                                                                 \
+    {                                                                               \
+        counts = &res;                                                              \
+        count = 1;                                                                  \
+    }                                                                               \
+                                                                                    \
+    sgl_detail_count_if_context_##N ctx = { first, counts };                        \
+    sgl_detail_run_chunks(count, size, &sgl_detail_count_if_chunk_##N, &ctx);       \
+    if (counts != &res)                                                             \
+    {                                                                               \
+        for (size_t i = 0 ; i < count ; ++i)                                        \
+        {                                                                           \
+            res += counts[i];                                                       \
+        }                                                                           \
+        sgl_detail_deallocate(NULL, counts, count * sizeof(size_t));                \
+    }                                                                               \
+    return res;                                                                     \
+}
+
+////////////////////////////////////////////////////////////
+// Implementation functions
+
+// Processes the elements [first, last) of a range, index being
+// the position of the chunk
+typedef void (*sgl_detail_chunk_func)(void* context, size_t index,
+                                      size_t first, size_t last);
+
+// Number of chunks a range of the given size is split into
+size_t sgl_detail_chunk_count(sgl_execution_policy policy, size_t size);
+
+// Calls func for count chunks of [0, size) of about the same size,
+// the last one in the calling thread and the other ones on the
+// default thread pool
+void sgl_detail_run_chunks(size_t count, size_t size,
+                           sgl_detail_chunk_func func, void* context);
+
+void sgl_detail_fill_n(sgl_execution_policy policy, void* first,
+                       size_t size, size_t width);
+
+#endif // SGL_ALGORITHM_EXECUTION_H_
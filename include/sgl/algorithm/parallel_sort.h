@@ -0,0 +1,293 @@
+/*
+ * Copyright (C) 2015 Morwenn
+ *
+ * The SGL is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * The SGL is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program. If not,
+ * see <http://www.gnu.org/licenses/>.
+ */
+#ifndef SGL_ALGORITHM_PARALLEL_SORT_H_
+#define SGL_ALGORITHM_PARALLEL_SORT_H_
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <stdlib.h>
+#include <string.h>
+#include <sgl/algorithm/sort.h>
+#include <sgl/memory/allocator.h>
+#include <sgl/thread/concurrency.h>
+#include <sgl/utility/compare.h>
+#include <sgl/utility/dispatch.h>
+#include <sgl/detail/common.h>
+
+#ifndef SGL_PARALLEL_SORT_THRESHOLD
+
+    /**
+     * @def SGL_PARALLEL_SORT_THRESHOLD
+     *
+     * Ranges with fewer elements than this are sorted by a single
+     * thread, and every thread of a parallel sort is given at least
+     * half of this number of elements. It can be set with the
+     * compiler option -DSGL_PARALLEL_SORT_THRESHOLD=size and is
+     * read when the sort function is defined.
+     */
+    #define SGL_PARALLEL_SORT_THRESHOLD 65536
+
+#endif
+
+/**
+ * @def sgl_parallel_sort(T, cmp)
+ *
+ * Name of the parallel sort function generated for the given
+ * element type and comparison, which sorts the range [first, last)
+ * with at most the given number of threads, or with one thread per
+ * processor when the hint is 0:
+ *
+ *     sgl_define(sgl_sort(int))
+ *     sgl_define(sgl_parallel_sort(int))
+ *     sgl_parallel_sort(int)(sgl_begin(vec), sgl_end(vec), 0);
+ *
+ * The function sgl_sort(T, cmp) must have been declared before. The
+ * range is split into one chunk per thread, the chunks are sorted
+ * concurrently with sgl_sort, then pairs of sorted runs are merged
+ * until one run remains. Every merge round is parallel as well:
+ * each thread writes an equal share of the output and finds the
+ * matching parts of both runs with a binary search.
+ *
+ * The merges need a buffer the size of the range; when it can not
+ * be allocated, the range is sorted by the calling thread. Like
+ * sgl_sort, the parallel sort is not stable.
+ */
+#define sgl_parallel_sort(...) \
+    sgl_dispatch(sgl_detail_parallel_sort, __VA_ARGS__)(__VA_ARGS__)
+
+#define sgl_detail_parallel_sort1(T) \
+    sgl_parallel_sort_##T##_sgl_less
+
+#define sgl_detail_parallel_sort2(T, cmp) \
+    sgl_parallel_sort_##T##_##cmp
+
+////////////////////////////////////////////////////////////
+// Definition macros
+
+#define sgl_define_sgl_parallel_sort(...) \
+    sgl_dispatch(sgl_detail_define_parallel_sort, __VA_ARGS__)(__VA_ARGS__)
+
+#define sgl_declare_sgl_parallel_sort(...) \
+    sgl_dispatch(sgl_detail_declare_parallel_sort, __VA_ARGS__)(__VA_ARGS__)
+
+#define sgl_instantiate_sgl_parallel_sort(...) \
+    sgl_dispatch(sgl_detail_instantiate_parallel_sort, __VA_ARGS__)(__VA_ARGS__)
+
+#define sgl_detail_define_parallel_sort1(T) \
+    sgl_detail_define_parallel_sort2(T, sgl_less)
+
+#define sgl_detail_define_parallel_sort2(T, cmp)                                    \
+    sgl_detail_declare_parallel_sort2(T, cmp)                                       \
+    sgl_detail_instantiate_parallel_sort2(T, cmp)
+
+#define sgl_detail_declare_parallel_sort1(T) \
+    sgl_detail_declare_parallel_sort2(T, sgl_less)
+
+#define sgl_detail_declare_parallel_sort2(T, cmp) \
+    void sgl_parallel_sort_##T##_##cmp(T* first, T* last, size_t threads);
+
+#define sgl_detail_instantiate_parallel_sort1(T) \
+    sgl_detail_instantiate_parallel_sort2(T, sgl_less)
+
+#define sgl_detail_instantiate_parallel_sort2(T, cmp) \
+    sgl_detail_instantiate_parallel_sort(T, cmp, T##_##cmp)
+
+////////////////////////////////////////////////////////////
+// Parallel merge sort
+
+#define sgl_detail_instantiate_parallel_sort(T, cmp, N)                             \
+                                                                                    \
+/* Work of one thread: the chunk it sorts, then the part of the  */                 \
+/* output of every merge round it writes, are the elements of    */                 \
+/* [bounds[index], bounds[index + 1])                            */                 \
+typedef struct                                                                      \
+{                                                                                   \
+    T* src;                                                                         \
+    T* dst;                                                                         \
+    const size_t* bounds;                                                           \
+    size_t count;                                                                   \
+    size_t width;                                                                   \
+    size_t index;                                                                   \
+} sgl_detail_parallel_sort_job_##N;                                                 \
+                                                                                    \
+static int sgl_detail_parallel_sort_chunk_##N(void* arg)                            \
+{                                                                                   \
+    sgl_detail_parallel_sort_job_##N* job = arg;                                    \
+    sgl_sort_##N(job->src + job->bounds[job->index],                                \
+                 job->src + job->bounds[job->index + 1]);                           \
+    return 0;                                                                       \
+}                                                                                   \
+                                                                                    \
+/* Returns how many of the first k merged elements come from a, */                  \
+/* equal elements being taken from a first */                                       \
+static inline size_t sgl_detail_merge_split_##N(const T* a, size_t a_size,          \
+                                                const T* b, size_t b_size,          \
+                                                size_t k)                           \
+{                                                                                   \
+    size_t lo = k > b_size ? k - b_size : 0;                                        \
+    size_t hi = k < a_size ? k : a_size;                                            \
+    while (lo < hi)                                                                 \
+    {                                                                               \
+        size_t mid = lo + (hi - lo) / 2;                                            \
+        size_t j = k - mid;                                                         \
+        if (j > 0 and not cmp(b[j - 1], a[mid]))                                    \
+        {                                                                           \
+            lo = mid + 1;                                                           \
+        }                                                                           \
+        else                                                                        \
+        {                                                                           \
+            hi = mid;                                                               \
+        }                                                                           \
+    }                                                                               \
+    return lo;                                                                      \
+}                                                                                   \
+                                                                                    \
+static int sgl_detail_parallel_sort_merge_##N(void* arg)                            \
+{                                                                                   \
+    sgl_detail_parallel_sort_job_##N* job = arg;                                    \
+    const size_t* bounds = job->bounds;                                             \
+    /* The runs are made of width chunks, the part of the output */                 \
+    /* of the thread is inside the merge of a single pair of runs */                \
+    size_t first_chunk = job->index / (2 * job->width) * (2 * job->width);          \
+    size_t mid_chunk = first_chunk + job->width;                                    \
+    size_t last_chunk = mid_chunk + job->width;                                     \
+    size_t start = bounds[first_chunk];                                             \
+    size_t mid = bounds[mid_chunk < job->count ? mid_chunk : job->count];           \
+    size_t end = bounds[last_chunk < job->count ? last_chunk : job->count];         \
+                                                                                    \
+    const T* a = job->src + start;                                                  \
+    const T* b = job->src + mid;                                                    \
+    size_t a_size = mid - start;                                                    \
+    size_t b_size = end - mid;                                                      \
+    size_t lo = bounds[job->index] - start;                                         \
+    size_t hi = bounds[job->index + 1] - start;                                     \
+    size_t a_lo = sgl_detail_merge_split_##N(a, a_size, b, b_size, lo);             \
+    size_t a_hi = sgl_detail_merge_split_##N(a, a_size, b, b_size, hi);             \
+                                                                                    \
+    const T* left = a + a_lo;                                                       \
+    const T* left_end = a + a_hi;                                                   \
+    const T* right = b + (lo - a_lo);                                               \
+    const T* right_end = b + (hi - a_hi);                                           \
+    T* out = job->dst + start + lo;                                                 \
+    while (left != left_end and right != right_end)                                 \
+    {                                                                               \
+        if (cmp(*right, *left))                                                     \
+        {                                                                           \
+            *out++ = *right++;                                                      \
+        }                                                                           \
+        else                                                                        \
+        {                                                                           \
+            *out++ = *left++;                                                       \
+        }                                                                           \
+    }                                                                               \
+    memcpy(out, left, (size_t) (left_end - left) * sizeof(T));                      \
+    out += left_end - left;                                                         \
+    memcpy(out, right, (size_t) (right_end - right) * sizeof(T));                   \
+    return 0;                                                                       \
+}                                                                                   \
+                                                                                    \
+static int sgl_detail_parallel_sort_copy_##N(void* arg)                             \
+{                                                                                   \
+    sgl_detail_parallel_sort_job_##N* job = arg;                                    \
+    size_t lo = job->bounds[job->index];                                            \
+    size_t hi = job->bounds[job->index + 1];                                        \
+    memcpy(job->dst + lo, job->src + lo, (hi - lo) * sizeof(T));                    \
+    return 0;                                                                       \
+}                                                                                   \
+                                                                                    \
+void sgl_parallel_sort_##N(T* first, T* last, size_t threads)                       \
+{                                                                                   \
+    size_t size = (size_t) (last - first);                                          \
+    size_t max_threads = size / (SGL_PARALLEL_SORT_THRESHOLD / 2);                  \
+    if (threads == 0)                                                               \
+    {                                                                               \
+        threads = sgl_hardware_concurrency();                                       \
+    }                                                                               \
+    if (threads > max_threads)                                                      \
+    {                                                                               \
+        threads = max_threads;                                                      \
+    }                                                                               \
+    if (size < SGL_PARALLEL_SORT_THRESHOLD or threads < 2)                          \
+    {                                                                               \
+        sgl_sort_##N(first, last);                                                  \
+        return;                                                                     \
+    }                                                                               \
+                                                                                    \
+    T* buffer = sgl_detail_allocate(NULL, size * sizeof(T), alignof(T));            \
+    sgl_detail_parallel_sort_job_##N* jobs = malloc(threads * sizeof *jobs);        \
+    size_t* bounds = malloc((threads + 1) * sizeof *bounds);                        \
+    if (not buffer or not jobs or not bounds)                                       \
+    {                                                                               \
+        sgl_detail_deallocate(NULL, buffer, size * sizeof(T));                      \
+        free(jobs);                                                                 \
+        free(bounds);                                                               \
+        sgl_sort_##N(first, last);                                                  \
+        return;                                                                     \
+    }                                                                               \
+                                                                                    \
+    for (size_t i = 0 ; i <= threads ; ++i)                                         \
+    {                                                                               \
+        size_t extra = size % threads;                                              \
+        bounds[i] = size / threads * i + (i < extra ? i : extra);                   \
+    }                                                                               \
+    for (size_t i = 0 ; i < threads ; ++i)                                          \
+    {                                                                               \
+        jobs[i] = (sgl_detail_parallel_sort_job_##N) {                              \
+            .src = first,                                                           \
+            .bounds = bounds,                                                       \
+            .count = threads,                                                       \
+            .index = i                                                              \
+        };                                                                          \
+    }                                                                               \
+    sgl_detail_parallel_invoke(threads, &sgl_detail_parallel_sort_chunk_##N,        \
+                               jobs, sizeof *jobs);                                 \
+                                                                                    \
+    T* src = first;                                                                 \
+    T* dst = buffer;                                                                \
+    for (size_t width = 1 ; width < threads ; width *= 2)                           \
+    {                                                                               \
+        for (size_t i = 0 ; i < threads ; ++i)                                      \
+        {                                                                           \
+            jobs[i].src = src;                                                      \
+            jobs[i].dst = dst;                                                      \
+            jobs[i].width = width;                                                  \
+        }                                                                           \
+        sgl_detail_parallel_invoke(threads, &sgl_detail_parallel_sort_merge_##N,    \
+                                   jobs, sizeof *jobs);                             \
+        T* tmp = src;                                                               \
+        src = dst;                                                                  \
+        dst = tmp;                                                                  \
+    }                                                                               \
+    if (src != first)                                                               \
+    {                                                                               \
+        for (size_t i = 0 ; i < threads ; ++i)                                      \
+        {                                                                           \
+            jobs[i].src = src;                                                      \
+            jobs[i].dst = first;                                                    \
+        }                                                                           \
+        sgl_detail_parallel_invoke(threads, &sgl_detail_parallel_sort_copy_##N,     \
+                                   jobs, sizeof *jobs);                             \
+    }                                                                               \
+                                                                                    \
+    free(bounds);                                                                   \
+    free(jobs);                                                                     \
+    sgl_detail_deallocate(NULL, buffer, size * sizeof(T));                          \
+}
+
+#endif // SGL_ALGORITHM_PARALLEL_SORT_H_
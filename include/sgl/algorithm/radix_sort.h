@@ -0,0 +1,89 @@
+/*
+ * Copyright (C) 2015 Morwenn
+ *
+ * The SGL is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * The SGL is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program. If not,
+ * see <http://www.gnu.org/licenses/>.
+ */
+#ifndef SGL_ALGORITHM_RADIX_SORT_H_
+#define SGL_ALGORITHM_RADIX_SORT_H_
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <stddef.h>
+#include <sgl/type_traits/is_floating_point.h>
+#include <sgl/type_traits/is_signed.h>
+#include <sgl/type_traits/is_unsigned.h>
+#include <sgl/detail/common.h>
+
+/**
+ * @def sgl_radix_sort(first, last)
+ *
+ * Sorts the range [first, last) of integers or floating point
+ * numbers in ascending order with a least significant digit radix
+ * sort, which does not compare the elements:
+ *
+ *     sgl_radix_sort(sgl_begin(vec), sgl_end(vec));
+ *
+ * The element type is deduced from first and must be a signed or
+ * unsigned integer or a floating point type of 32 or 64 bits; any
+ * other type is rejected at compile time. The bits of the elements
+ * are transformed into unsigned keys with the same order, sorted
+ * 11 bits at a time, then transformed back. Passes whose digit is
+ * the same for every element are skipped.
+ *
+ * The sort is stable and needs a scratch buffer the size of the
+ * range; it throws sgl_bad_alloc when it can not be allocated.
+ * Floating point numbers are ordered by their bit pattern: -0.0
+ * comes before 0.0, and NaNs come first or last depending on
+ * their sign bit.
+ */
+#define sgl_radix_sort(first, last)                                                 \
+    sgl_detail_radix_sort((first), (size_t) ((last) - (first)),                     \
+                          sgl_detail_radix_width(*(first)),                         \
+                          sgl_detail_radix_kind_of(*(first)))
+
+// Size of value, if its type can be radix sorted
+#define sgl_detail_radix_width(value)                                               \
+    sizeof(struct {                                                                 \
+        _Static_assert((sgl_is_signed(value) or sgl_is_unsigned(value)              \
+                        or sgl_is_floating_point(value))                            \
+                       and (sizeof(value) == 4 or sizeof(value) == 8),              \
+                       "sgl_radix_sort: unsupported element type");                 \
+        char _bytes[sizeof(value)];                                                 \
+    })
+
+#define sgl_detail_radix_kind_of(value)                                             \
+    (sgl_is_floating_point(value) ? sgl_detail_radix_floating_point :               \
+     sgl_is_signed(value) ? sgl_detail_radix_signed :                               \
+     sgl_detail_radix_unsigned)
+
+/**
+ * Transformation applied to the bits of an element to get a key
+ * whose unsigned order is the order of the elements: nothing for
+ * unsigned integers, a sign bit flip for signed integers, and a
+ * sign bit flip or a flip of every bit for the non-negative and
+ * negative IEEE 754 floating point numbers.
+ */
+typedef enum
+{
+    sgl_detail_radix_unsigned,
+    sgl_detail_radix_signed,
+    sgl_detail_radix_floating_point
+} sgl_detail_radix_kind;
+
+void sgl_detail_radix_sort(void* data, size_t size, size_t width,
+                           sgl_detail_radix_kind kind);
+
+#endif // SGL_ALGORITHM_RADIX_SORT_H_
@@ -0,0 +1,545 @@
+/*
+ * Copyright (C) 2015 Morwenn
+ *
+ * The SGL is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * The SGL is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program. If not,
+ * see <http://www.gnu.org/licenses/>.
+ */
+#ifndef SGL_ALGORITHM_SORT_H_
+#define SGL_ALGORITHM_SORT_H_
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <stdint.h>
+#include <string.h>
+#include <sgl/exception.h>
+#include <sgl/memory/allocator.h>
+#include <sgl/utility/compare.h>
+#include <sgl/utility/dispatch.h>
+#include <sgl/detail/common.h>
+
+/**
+ * @def sgl_sort(T, cmp)
+ *
+ * Name of the sort function generated for the given element type
+ * and comparison, which sorts the range [first, last) of elements
+ * of type T in place:
+ *
+ *     sgl_define(sgl_sort(int))
+ *     sgl_sort(int)(sgl_begin(vec), sgl_end(vec));
+ *
+ * cmp is the name of a function or function-like macro such that
+ * cmp(a, b) is true when a is ordered before b, and defaults to
+ * sgl_less. It is called directly and can therefore be inlined,
+ * unlike the comparison function of qsort.
+ *
+ * The algorithm is pattern-defeating quicksort: introsort with a
+ * median of 3 or pseudo-median of 9 pivot, insertion sort for
+ * small ranges, linear time on sorted, reversed and equal ranges,
+ * and a heapsort fallback guaranteeing O(n log n) comparisons. It
+ * is not stable.
+ */
+#define sgl_sort(...) \
+    sgl_dispatch(sgl_detail_sort, __VA_ARGS__)(__VA_ARGS__)
+
+#define sgl_detail_sort1(T) \
+    sgl_sort_##T##_sgl_less
+
+#define sgl_detail_sort2(T, cmp) \
+    sgl_sort_##T##_##cmp
+
+/**
+ * @def sgl_stable_sort(T, cmp)
+ *
+ * Same as sgl_sort, except that the generated function keeps the
+ * relative order of the equivalent elements. It is a merge sort
+ * which allocates a buffer of half the size of the range, and
+ * throws sgl_bad_alloc when it can not.
+ */
+#define sgl_stable_sort(...) \
+    sgl_dispatch(sgl_detail_stable_sort, __VA_ARGS__)(__VA_ARGS__)
+
+#define sgl_detail_stable_sort1(T) \
+    sgl_stable_sort_##T##_sgl_less
+
+#define sgl_detail_stable_sort2(T, cmp) \
+    sgl_stable_sort_##T##_##cmp
+
+////////////////////////////////////////////////////////////
+// Definition macros
+
+#define sgl_define_sgl_sort(...) \
+    sgl_dispatch(sgl_detail_define_sort, __VA_ARGS__)(__VA_ARGS__)
+
+#define sgl_declare_sgl_sort(...) \
+    sgl_dispatch(sgl_detail_declare_sort, __VA_ARGS__)(__VA_ARGS__)
+
+#define sgl_instantiate_sgl_sort(...) \
+    sgl_dispatch(sgl_detail_instantiate_sort, __VA_ARGS__)(__VA_ARGS__)
+
+#define sgl_define_sgl_stable_sort(...) \
+    sgl_dispatch(sgl_detail_define_stable_sort, __VA_ARGS__)(__VA_ARGS__)
+
+#define sgl_declare_sgl_stable_sort(...) \
+    sgl_dispatch(sgl_detail_declare_stable_sort, __VA_ARGS__)(__VA_ARGS__)
+
+#define sgl_instantiate_sgl_stable_sort(...) \
+    sgl_dispatch(sgl_detail_instantiate_stable_sort, __VA_ARGS__)(__VA_ARGS__)
+
+#define sgl_detail_define_sort1(T) \
+    sgl_detail_define_sort2(T, sgl_less)
+
+#define sgl_detail_define_sort2(T, cmp)                                             \
+    sgl_detail_declare_sort2(T, cmp)                                                \
+    sgl_detail_instantiate_sort2(T, cmp)
+
+#define sgl_detail_declare_sort1(T) \
+    sgl_detail_declare_sort2(T, sgl_less)
+
+#define sgl_detail_declare_sort2(T, cmp) \
+    void sgl_sort_##T##_##cmp(T* first, T* last);
+
+#define sgl_detail_instantiate_sort1(T) \
+    sgl_detail_instantiate_sort2(T, sgl_less)
+
+#define sgl_detail_instantiate_sort2(T, cmp) \
+    sgl_detail_instantiate_sort(T, cmp, T##_##cmp)
+
+#define sgl_detail_define_stable_sort1(T) \
+    sgl_detail_define_stable_sort2(T, sgl_less)
+
+#define sgl_detail_define_stable_sort2(T, cmp)                                      \
+    sgl_detail_declare_stable_sort2(T, cmp)                                         \
+    sgl_detail_instantiate_stable_sort2(T, cmp)
+
+#define sgl_detail_declare_stable_sort1(T) \
+    sgl_detail_declare_stable_sort2(T, sgl_less)
+
+#define sgl_detail_declare_stable_sort2(T, cmp) \
+    void sgl_stable_sort_##T##_##cmp(T* first, T* last);
+
+#define sgl_detail_instantiate_stable_sort1(T) \
+    sgl_detail_instantiate_stable_sort2(T, sgl_less)
+
+#define sgl_detail_instantiate_stable_sort2(T, cmp) \
+    sgl_detail_instantiate_stable_sort(T, cmp, T##_##cmp)
+
+////////////////////////////////////////////////////////////
+// Pattern-defeating quicksort
+
+enum
+{
+    // Ranges smaller than this are sorted with an insertion sort
+    sgl_detail_sort_insertion_threshold = 24,
+    // Ranges larger than this use a pseudo-median of 9 as pivot
+    sgl_detail_sort_ninther_threshold = 128,
+    // Number of moves after which a partial insertion sort gives up
+    sgl_detail_sort_partial_insertion_limit = 8
+};
+
+#define sgl_detail_instantiate_sort(T, cmp, N)                                      \
+                                                                                    \
+static inline void sgl_detail_swap_##N(T* lhs, T* rhs)                              \
+{                                                                                   \
+    T tmp = *lhs;                                                                   \
+    *lhs = *rhs;                                                                    \
+    *rhs = tmp;                                                                     \
+}                                                                                   \
+                                                                                    \
+static inline void sgl_detail_sort2_##N(T* a, T* b)                                 \
+{                                                                                   \
+    if (cmp(*b, *a))                                                                \
+    {                                                                               \
+        sgl_detail_swap_##N(a, b);                                                  \
+    }                                                                               \
+}                                                                                   \
+                                                                                    \
+static inline void sgl_detail_sort3_##N(T* a, T* b, T* c)                           \
+{                                                                                   \
+    sgl_detail_sort2_##N(a, b);                                                     \
+    sgl_detail_sort2_##N(b, c);                                                     \
+    sgl_detail_sort2_##N(a, b);                                                     \
+}                                                                                   \
+                                                                                    \
+static inline void sgl_detail_insertion_sort_##N(T* first, T* last)                 \
+{                                                                                   \
+    if (first == last)                                                              \
+    {                                                                               \
+        return;                                                                     \
+    }                                                                               \
+    for (T* cur = first + 1 ; cur != last ; ++cur)                                  \
+    {                                                                               \
+        T* sift = cur;                                                              \
+        T* sift_1 = cur - 1;                                                        \
+        if (cmp(*sift, *sift_1))                                                    \
+        {                                                                           \
+            T tmp = *sift;                                                          \
+            do                                                                      \
+            {                                                                       \
+                *sift-- = *sift_1;                                                  \
+            } while (sift != first && cmp(tmp, *--sift_1));                         \
+            *sift = tmp;                                                            \
+        }                                                                           \
+    }                                                                               \
+}                                                                                   \
+                                                                                    \
+/* Same as above, but assumes that an element before first is not */                \
+/* greater than any element of the range, so there is no need to */                 \
+/* check for the beginning of the range */                                          \
+static inline void sgl_detail_unguarded_insertion_sort_##N(T* first, T* last)       \
+{                                                                                   \
+    if (first == last)                                                              \
+    {                                                                               \
+        return;                                                                     \
+    }                                                                               \
+    for (T* cur = first + 1 ; cur != last ; ++cur)                                  \
+    {                                                                               \
+        T* sift = cur;                                                              \
+        T* sift_1 = cur - 1;                                                        \
+        if (cmp(*sift, *sift_1))                                                    \
+        {                                                                           \
+            T tmp = *sift;                                                          \
+            do                                                                      \
+            {                                                                       \
+                *sift-- = *sift_1;                                                  \
+            } while (cmp(tmp, *--sift_1));                                          \
+            *sift = tmp;                                                            \
+        }                                                                           \
+    }                                                                               \
+}                                                                                   \
+                                                                                    \
+/* Insertion sort which gives up when it has to move too many */                    \
+/* elements, returns whether the range was sorted */                                \
+static inline bool sgl_detail_partial_insertion_sort_##N(T* first, T* last)         \
+{                                                                                   \
+    if (first == last)                                                              \
+    {                                                                               \
+        return true;                                                                \
+    }                                                                               \
+    size_t moves = 0;                                                               \
+    for (T* cur = first + 1 ; cur != last ; ++cur)                                  \
+    {                                                                               \
+        T* sift = cur;                                                              \
+        T* sift_1 = cur - 1;                                                        \
+        if (cmp(*sift, *sift_1))                                                    \
+        {                                                                           \
+            T tmp = *sift;                                                          \
+            do                                                                      \
+            {                                                                       \
+                *sift-- = *sift_1;                                                  \
+            } while (sift != first && cmp(tmp, *--sift_1));                         \
+            *sift = tmp;                                                            \
+            moves += (size_t) (cur - sift);                                         \
+            if (moves > sgl_detail_sort_partial_insertion_limit)                    \
+            {                                                                       \
+                return false;                                                       \
+            }                                                                       \
+        }                                                                           \
+    }                                                                               \
+    return true;                                                                    \
+}                                                                                   \
+                                                                                    \
+static inline void sgl_detail_sort_sift_down_##N(T* first, size_t size,             \
+                                                 size_t index)                      \
+{                                                                                   \
+    T value = first[index];                                                         \
+    for (;;)                                                                        \
+    {                                                                               \
+        size_t child = 2 * index + 1;                                               \
+        if (child >= size)                                                          \
+        {                                                                           \
+            break;                                                                  \
+        }                                                                           \
+        if (child + 1 < size && cmp(first[child], first[child + 1]))                \
+        {                                                                           \
+            ++child;                                                                \
+        }                                                                           \
+        if (not cmp(value, first[child]))                                           \
+        {                                                                           \
+            break;                                                                  \
+        }                                                                           \
+        first[index] = first[child];                                                \
+        index = child;                                                              \
+    }                                                                               \
+    first[index] = value;                                                           \
+}                                                                                   \
+                                                                                    \
+static inline void sgl_detail_heap_sort_##N(T* first, T* last)                      \
+{                                                                                   \
+    size_t size = (size_t) (last - first);                                          \
+    for (size_t index = size / 2 ; index-- > 0 ; )                                  \
+    {                                                                               \
+        sgl_detail_sort_sift_down_##N(first, size, index);                          \
+    }                                                                               \
+    while (size > 1)                                                                \
+    {                                                                               \
+        sgl_detail_swap_##N(first, first + --size);                                 \
+        sgl_detail_sort_sift_down_##N(first, size, 0);                              \
+    }                                                                               \
+}                                                                                   \
+                                                                                    \
+/* Partitions [first, last) around the pivot *first, the elements */                \
+/* equal to the pivot go to the right. Returns the position of the */               \
+/* pivot and tells whether the range was already partitioned */                     \
+static inline T* sgl_detail_partition_right_##N(T* first, T* last,                  \
+                                                bool* already_partitioned)          \
+{                                                                                   \
+    T pivot = *first;                                                               \
+    T* begin = first;                                                               \
+    /* There is an element not less than the pivot after it (the */                 \
+    /* median of 3), and one not greater than it before last when */                \
+    /* first is moved: the loops do not need to check the bounds */                 \
+    while (cmp(*++first, pivot));                                                   \
+    if (first - 1 == begin)                                                         \
+    {                                                                               \
+        while (first < last && not cmp(*--last, pivot));                            \
+    }                                                                               \
+    else                                                                            \
+    {                                                                               \
+        while (not cmp(*--last, pivot));                                            \
+    }                                                                               \
+    *already_partitioned = first >= last;                                           \
+    while (first < last)                                                            \
+    {                                                                               \
+        sgl_detail_swap_##N(first, last);                                           \
+        while (cmp(*++first, pivot));                                               \
+        while (not cmp(*--last, pivot));                                            \
+    }                                                                               \
+    T* pivot_pos = first - 1;                                                       \
+    *begin = *pivot_pos;                                                            \
+    *pivot_pos = pivot;                                                             \
+    return pivot_pos;                                                               \
+}                                                                                   \
+                                                                                    \
+/* Partitions [first, last) around the pivot *first, the elements */                \
+/* equal to the pivot go to the left. It is used when the pivot is */               \
+/* equal to the element before first, in which case no element of */                \
+/* the range is less than the pivot and the elements equal to it */                 \
+/* end up sorted after one pass */                                                  \
+static inline T* sgl_detail_partition_left_##N(T* first, T* last)                   \
+{                                                                                   \
+    T pivot = *first;                                                               \
+    T* begin = first;                                                               \
+    T* end = last;                                                                  \
+    while (cmp(pivot, *--last));                                                    \
+    if (last + 1 == end)                                                            \
+    {                                                                               \
+        while (first < last && not cmp(pivot, *++first));                           \
+    }                                                                               \
+    else                                                                            \
+    {                                                                               \
+        while (not cmp(pivot, *++first));                                           \
+    }                                                                               \
+    while (first < last)                                                            \
+    {                                                                               \
+        sgl_detail_swap_##N(first, last);                                           \
+        while (cmp(pivot, *--last));                                                \
+        while (not cmp(pivot, *++first));                                           \
+    }                                                                               \
+    *begin = *last;                                                                 \
+    *last = pivot;                                                                  \
+    return last;                                                                    \
+}                                                                                   \
+                                                                                    \
+static void sgl_detail_pdqsort_loop_##N(T* first, T* last,                          \
+                                         int bad_allowed, bool leftmost)            \
+{                                                                                   \
+    for (;;)                                                                        \
+    {                                                                               \
+        size_t size = (size_t) (last - first);                                      \
+        if (size < sgl_detail_sort_insertion_threshold)                             \
+        {                                                                           \
+            if (leftmost)                                                           \
+            {                                                                       \
+                sgl_detail_insertion_sort_##N(first, last);                         \
+            }                                                                       \
+            else                                                                    \
+            {                                                                       \
+                sgl_detail_unguarded_insertion_sort_##N(first, last);               \
+            }                                                                       \
+            return;                                                                 \
+        }                                                                           \
+                                                                                    \
+        /* Choose the pivot and put it at the beginning */                          \
+        size_t half = size / 2;                                                     \
+        if (size > sgl_detail_sort_ninther_threshold)                               \
+        {                                                                           \
+            sgl_detail_sort3_##N(first, first + half, last - 1);                    \
+            sgl_detail_sort3_##N(first + 1, first + (half - 1), last - 2);          \
+            sgl_detail_sort3_##N(first + 2, first + (half + 1), last - 3);          \
+            sgl_detail_sort3_##N(first + (half - 1), first + half,                  \
+                                 first + (half + 1));                               \
+            sgl_detail_swap_##N(first, first + half);                               \
+        }                                                                           \
+        else                                                                        \
+        {                                                                           \
+            sgl_detail_sort3_##N(first + half, first, last - 1);                    \
+        }                                                                           \
+                                                                                    \
+        /* If the pivot is equal to the element before the range, */                \
+        /* which is the pivot of a previous partition, the range */                 \
+        /* contains many equal elements */                                          \
+        if (not leftmost && not cmp(*(first - 1), *first))                          \
+        {                                                                           \
+            first = sgl_detail_partition_left_##N(first, last) + 1;                 \
+            continue;                                                               \
+        }                                                                           \
+                                                                                    \
+        bool already_partitioned;                                                   \
+        T* pivot_pos = sgl_detail_partition_right_##N(first, last,                  \
+                                                      &already_partitioned);        \
+        size_t left_size = (size_t) (pivot_pos - first);                            \
+        size_t right_size = (size_t) (last - (pivot_pos + 1));                      \
+                                                                                    \
+        if (left_size < size / 8 || right_size < size / 8)                          \
+        {                                                                           \
+            /* Fall back to heapsort after too many bad partitions */               \
+            if (--bad_allowed == 0)                                                 \
+            {                                                                       \
+                sgl_detail_heap_sort_##N(first, last);                              \
+                return;                                                             \
+            }                                                                       \
+            /* Otherwise swap a few elements to break the patterns */               \
+            if (left_size >= sgl_detail_sort_insertion_threshold)                   \
+            {                                                                       \
+                size_t quarter = left_size / 4;                                     \
+                sgl_detail_swap_##N(first, first + quarter);                        \
+                sgl_detail_swap_##N(pivot_pos - 1, pivot_pos - quarter);            \
+                if (left_size > sgl_detail_sort_ninther_threshold)                  \
+                {                                                                   \
+                    sgl_detail_swap_##N(first + 1, first + (quarter + 1));          \
+                    sgl_detail_swap_##N(first + 2, first + (quarter + 2));          \
+                    sgl_detail_swap_##N(pivot_pos - 2, pivot_pos - (quarter + 1));  \
+                    sgl_detail_swap_##N(pivot_pos - 3, pivot_pos - (quarter + 2));  \
+                }                                                                   \
+            }                                                                       \
+            if (right_size >= sgl_detail_sort_insertion_threshold)                  \
+            {                                                                       \
+                size_t quarter = right_size / 4;                                    \
+                sgl_detail_swap_##N(pivot_pos + 1, pivot_pos + (1 + quarter));      \
+                sgl_detail_swap_##N(last - 1, last - quarter);                      \
+                if (right_size > sgl_detail_sort_ninther_threshold)                 \
+                {                                                                   \
+                    sgl_detail_swap_##N(pivot_pos + 2, pivot_pos + (2 + quarter));  \
+                    sgl_detail_swap_##N(pivot_pos + 3, pivot_pos + (3 + quarter));  \
+                    sgl_detail_swap_##N(last - 2, last - (1 + quarter));            \
+                    sgl_detail_swap_##N(last - 3, last - (2 + quarter));            \
+                }                                                                   \
+            }                                                                       \
+        }                                                                           \
+        else if (already_partitioned                                                \
+                 && sgl_detail_partial_insertion_sort_##N(first, pivot_pos)         \
+                 && sgl_detail_partial_insertion_sort_##N(pivot_pos + 1, last))     \
+        {                                                                           \
+            /* The range was probably already sorted */                             \
+            return;                                                                 \
+        }                                                                           \
+                                                                                    \
+        /* Recurse into the left part and loop on the right one */                  \
+        sgl_detail_pdqsort_loop_##N(first, pivot_pos, bad_allowed, leftmost);       \
+        first = pivot_pos + 1;                                                      \
+        leftmost = false;                                                           \
+    }                                                                               \
+}                                                                                   \
+                                                                                    \
+void sgl_sort_##N(T* first, T* last)                                                \
+{                                                                                   \
+    int bad_allowed = 0;                                                            \
+    for (size_t size = (size_t) (last - first) ; size > 1 ; size >>= 1)             \
+    {                                                                               \
+        ++bad_allowed;                                                              \
+    }                                                                               \
+    sgl_detail_pdqsort_loop_##N(first, last, bad_allowed, true);                    \
+}
+
+////////////////////////////////////////////////////////////
+// Merge sort
+
+#define sgl_detail_instantiate_stable_sort(T, cmp, N)                               \
+                                                                                    \
+/* Stable insertion sort used for the small ranges */                               \
+static inline void sgl_detail_stable_insertion_sort_##N(T* first, T* last)          \
+{                                                                                   \
+    for (T* cur = first + 1 ; cur < last ; ++cur)                                   \
+    {                                                                               \
+        T tmp = *cur;                                                               \
+        T* sift = cur;                                                              \
+        while (sift != first && cmp(tmp, sift[-1]))                                 \
+        {                                                                           \
+            *sift = sift[-1];                                                       \
+            --sift;                                                                 \
+        }                                                                           \
+        *sift = tmp;                                                                \
+    }                                                                               \
+}                                                                                   \
+                                                                                    \
+/* Sorts [first, last) with a buffer of at least half its size */                   \
+static void sgl_detail_merge_sort_##N(T* first, T* last, T* buffer)                 \
+{                                                                                   \
+    size_t size = (size_t) (last - first);                                          \
+    if (size <= sgl_detail_sort_insertion_threshold)                                \
+    {                                                                               \
+        sgl_detail_stable_insertion_sort_##N(first, last);                          \
+        return;                                                                     \
+    }                                                                               \
+    T* middle = first + size / 2;                                                   \
+    sgl_detail_merge_sort_##N(first, middle, buffer);                               \
+    sgl_detail_merge_sort_##N(middle, last, buffer);                                \
+    if (not cmp(*middle, middle[-1]))                                               \
+    {                                                                               \
+        /* The halves are already in order */                                       \
+        return;                                                                     \
+    }                                                                               \
+                                                                                    \
+    /* Move the left half to the buffer and merge it back, the */                   \
+    /* elements of the left half go first when they are equal */                    \
+    size_t left_size = (size_t) (middle - first);                                   \
+    memcpy(buffer, first, left_size * sizeof(T));                                   \
+    T* left = buffer;                                                               \
+    T* left_end = buffer + left_size;                                               \
+    T* right = middle;                                                              \
+    T* out = first;                                                                 \
+    while (left != left_end && right != last)                                       \
+    {                                                                               \
+        if (cmp(*right, *left))                                                     \
+        {                                                                           \
+            *out++ = *right++;                                                      \
+        }                                                                           \
+        else                                                                        \
+        {                                                                           \
+            *out++ = *left++;                                                       \
+        }                                                                           \
+    }                                                                               \
+    memcpy(out, left, (size_t) (left_end - left) * sizeof(T));                      \
+}                                                                                   \
+                                                                                    \
+void sgl_stable_sort_##N(T* first, T* last)                                         \
+{                                                                                   \
+    size_t size = (size_t) (last - first);                                          \
+    if (size <= sgl_detail_sort_insertion_threshold)                                \
+    {                                                                               \
+        sgl_detail_stable_insertion_sort_##N(first, last);                          \
+        return;                                                                     \
+    }                                                                               \
+    size_t buffer_size = (size / 2 + 1) * sizeof(T);                                \
+    T* buffer = sgl_detail_allocate(NULL, buffer_size, alignof(T));                 \
+    if (not buffer)                                                                 \
+    {                                                                               \
+        sgl_throw(sgl_bad_alloc);                                                   \
+    }                                                                               \
+    sgl_detail_merge_sort_##N(first, last, buffer);                                 \
+    sgl_detail_deallocate(NULL, buffer, buffer_size);                               \
+}
+
+#endif // SGL_ALGORITHM_SORT_H_
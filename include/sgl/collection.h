@@ -21,21 +21,41 @@
 ////////////////////////////////////////////////////////////
 // Headers
 ////////////////////////////////////////////////////////////
+#include <sgl/collection/append.h>
+#include <sgl/collection/assign.h>
 #include <sgl/collection/at.h>
 #include <sgl/collection/back.h>
 #include <sgl/collection/begin.h>
 #include <sgl/collection/capacity.h>
+#include <sgl/collection/clear.h>
 #include <sgl/collection/data.h>
 #include <sgl/collection/end.h>
+#include <sgl/collection/equal.h>
 #include <sgl/collection/erase.h>
+#include <sgl/collection/find.h>
 #include <sgl/collection/front.h>
+#include <sgl/collection/insert.h>
 #include <sgl/collection/is_empty.h>
+#include <sgl/collection/lexicographical_compare.h>
 #include <sgl/collection/max_size.h>
+#include <sgl/collection/pop.h>
 #include <sgl/collection/pop_back.h>
+#include <sgl/collection/pop_front.h>
+#include <sgl/collection/pop_n.h>
+#include <sgl/collection/push.h>
 #include <sgl/collection/push_back.h>
+#include <sgl/collection/push_front.h>
+#include <sgl/collection/push_n.h>
+#include <sgl/collection/rehash.h>
 #include <sgl/collection/reserve.h>
 #include <sgl/collection/resize.h>
 #include <sgl/collection/shrink_to_fit.h>
 #include <sgl/collection/size.h>
+#include <sgl/collection/top.h>
+#include <sgl/collection/try_pop.h>
+#include <sgl/collection/try_push.h>
+#include <sgl/collection/try_push_back.h>
+#include <sgl/collection/try_reserve.h>
+#include <sgl/collection/try_shrink_to_fit.h>
 
 #endif // SGL_COLLECTION_H_
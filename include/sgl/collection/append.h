@@ -0,0 +1,46 @@
+/*
+ * Copyright (C) 2015 Morwenn
+ *
+ * The SGL is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * The SGL is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program. If not,
+ * see <http://www.gnu.org/licenses/>.
+ */
+#ifndef SGL_COLLECTION_APPEND_H_
+#define SGL_COLLECTION_APPEND_H_
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <sgl/detail/common.h>
+#include <sgl/collection/data.h>
+#include <sgl/collection/size.h>
+
+/**
+ * @def sgl_append(collection, values, count)
+ *
+ * Appends a copy of the count elements pointed to by values
+ * at the end of the collection, reallocating at most once.
+ */
+#define sgl_append(collection, values, count) \
+    (collection)->_functions->append(collection, values, count)
+
+/**
+ * @def sgl_append_vector(collection, other)
+ *
+ * Appends a copy of the elements of a contiguous collection
+ * at the end of the collection. Both can be the same.
+ */
+#define sgl_append_vector(collection, other) \
+    sgl_append(collection, sgl_data(other), sgl_size(other))
+
+#endif // SGL_COLLECTION_APPEND_H_
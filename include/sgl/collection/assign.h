@@ -0,0 +1,42 @@
+/*
+ * Copyright (C) 2015 Morwenn
+ *
+ * The SGL is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * The SGL is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program. If not,
+ * see <http://www.gnu.org/licenses/>.
+ */
+#ifndef SGL_COLLECTION_ASSIGN_H_
+#define SGL_COLLECTION_ASSIGN_H_
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <sgl/detail/common.h>
+#include <sgl/detail/select_integer.h>
+
+/**
+ * @def sgl_assign(collection, ...)
+ *
+ * Replaces the contents of the collection:
+ * - sgl_assign(collection, count, value) fills the collection
+ *   with count copies of value.
+ * - sgl_assign(collection, first, last) copies the elements
+ *   of the range [first, last) into the collection.
+ */
+#define sgl_assign(collection, count_or_first, value_or_last) \
+    sgl_detail_select_integer(count_or_first,                 \
+        (collection)->_functions->assign,                     \
+        (collection)->_functions->assign_range                \
+    )(collection, count_or_first, value_or_last)
+
+#endif // SGL_COLLECTION_ASSIGN_H_
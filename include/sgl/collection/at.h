@@ -23,7 +23,18 @@
 ////////////////////////////////////////////////////////////
 #include <sgl/detail/common.h>
 
-#define sgl_at(collection, index) \
-    (*((collection)->_functions->at(collection, index)))
+#ifdef SGL_STATIC_DISPATCH
+
+    #define sgl_at(collection, index)                                               \
+        (*sgl_detail_static_dispatch(collection,                                    \
+            sgl_detail_members(collection)->_data + (index),                        \
+            (collection)->_functions->at(collection, index)))
+
+#else
+
+    #define sgl_at(collection, index) \
+        (*((collection)->_functions->at(collection, index)))
+
+#endif
 
 #endif // SGL_COLLECTION_AT_H_
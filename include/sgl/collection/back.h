@@ -23,7 +23,19 @@
 ////////////////////////////////////////////////////////////
 #include <sgl/detail/common.h>
 
-#define sgl_back(collection) \
-    (*((collection)->_functions->back(collection)))
+#ifdef SGL_STATIC_DISPATCH
+
+    #define sgl_back(collection)                                                    \
+        (*sgl_detail_static_dispatch(collection,                                    \
+            sgl_detail_members(collection)->_data                                   \
+                + sgl_detail_members(collection)->_size - 1,                        \
+            (collection)->_functions->back(collection)))
+
+#else
+
+    #define sgl_back(collection) \
+        (*((collection)->_functions->back(collection)))
+
+#endif
 
 #endif // SGL_COLLECTION_BACK_H_
@@ -23,10 +23,26 @@
 ////////////////////////////////////////////////////////////
 #include <sgl/detail/common.h>
 
-#define sgl_begin(collection) \
-    (collection)->_functions->begin(collection)
+#ifdef SGL_STATIC_DISPATCH
 
-#define sgl_cbegin(collection) \
-    (collection)->_functions->cbegin(collection)
+    #define sgl_begin(collection)                                                   \
+        sgl_detail_static_dispatch(collection,                                      \
+            sgl_detail_members(collection)->_data + 0,                              \
+            (collection)->_functions->begin(collection))
+
+    #define sgl_cbegin(collection)                                                  \
+        sgl_detail_static_dispatch(collection,                                      \
+            sgl_detail_members_cdata(collection, cbegin),                           \
+            (collection)->_functions->cbegin(collection))
+
+#else
+
+    #define sgl_begin(collection) \
+        (collection)->_functions->begin(collection)
+
+    #define sgl_cbegin(collection) \
+        (collection)->_functions->cbegin(collection)
+
+#endif
 
 #endif // SGL_COLLECTION_BEGIN_H_
@@ -23,7 +23,18 @@
 ////////////////////////////////////////////////////////////
 #include <sgl/detail/common.h>
 
-#define sgl_capacity(collection) \
-    (collection)->_functions->capacity(collection)
+#ifdef SGL_STATIC_DISPATCH
+
+    #define sgl_capacity(collection)                                                \
+        sgl_detail_static_dispatch(collection,                                      \
+            sgl_detail_members(collection)->_capacity + 0,                          \
+            (collection)->_functions->capacity(collection))
+
+#else
+
+    #define sgl_capacity(collection) \
+        (collection)->_functions->capacity(collection)
+
+#endif
 
 #endif // SGL_COLLECTION_CAPACITY_H_
@@ -23,7 +23,18 @@
 ////////////////////////////////////////////////////////////
 #include <sgl/detail/common.h>
 
-#define sgl_data(collection) \
-    (collection)->_functions->data(collection)
+#ifdef SGL_STATIC_DISPATCH
+
+    #define sgl_data(collection)                                                    \
+        sgl_detail_static_dispatch(collection,                                      \
+            sgl_detail_members(collection)->_data + 0,                              \
+            (collection)->_functions->data(collection))
+
+#else
+
+    #define sgl_data(collection) \
+        (collection)->_functions->data(collection)
+
+#endif
 
 #endif // SGL_COLLECTION_DATA_H_
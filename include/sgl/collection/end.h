@@ -23,10 +23,28 @@
 ////////////////////////////////////////////////////////////
 #include <sgl/detail/common.h>
 
-#define sgl_end(collection) \
-    (collection)->_functions->end(collection)
+#ifdef SGL_STATIC_DISPATCH
 
-#define sgl_cend(collection) \
-    (collection)->_functions->cend(collection)
+    #define sgl_end(collection)                                                     \
+        sgl_detail_static_dispatch(collection,                                      \
+            sgl_detail_members(collection)->_data                                   \
+                + sgl_detail_members(collection)->_size,                            \
+            (collection)->_functions->end(collection))
+
+    #define sgl_cend(collection)                                                    \
+        sgl_detail_static_dispatch(collection,                                      \
+            sgl_detail_members_cdata(collection, cend)                              \
+                + sgl_detail_members(collection)->_size,                            \
+            (collection)->_functions->cend(collection))
+
+#else
+
+    #define sgl_end(collection) \
+        (collection)->_functions->end(collection)
+
+    #define sgl_cend(collection) \
+        (collection)->_functions->cend(collection)
+
+#endif
 
 #endif // SGL_COLLECTION_END_H_
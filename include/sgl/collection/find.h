@@ -0,0 +1,35 @@
+/*
+ * Copyright (C) 2015 Morwenn
+ *
+ * The SGL is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * The SGL is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program. If not,
+ * see <http://www.gnu.org/licenses/>.
+ */
+#ifndef SGL_COLLECTION_FIND_H_
+#define SGL_COLLECTION_FIND_H_
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <sgl/detail/common.h>
+
+/**
+ * @def sgl_find(collection, key)
+ *
+ * Returns a pointer to the element associated to key in an
+ * associative collection, or NULL if there is none.
+ */
+#define sgl_find(collection, key) \
+    (collection)->_functions->find(collection, key)
+
+#endif // SGL_COLLECTION_FIND_H_
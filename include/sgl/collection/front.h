@@ -23,7 +23,18 @@
 ////////////////////////////////////////////////////////////
 #include <sgl/detail/common.h>
 
-#define sgl_front(collection) \
-    (*((collection)->_functions->front(collection)))
+#ifdef SGL_STATIC_DISPATCH
+
+    #define sgl_front(collection)                                                   \
+        (*sgl_detail_static_dispatch(collection,                                    \
+            sgl_detail_members(collection)->_data,                                  \
+            (collection)->_functions->front(collection)))
+
+#else
+
+    #define sgl_front(collection) \
+        (*((collection)->_functions->front(collection)))
+
+#endif
 
 #endif // SGL_COLLECTION_FRONT_H_
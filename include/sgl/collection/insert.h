@@ -0,0 +1,60 @@
+/*
+ * Copyright (C) 2015 Morwenn
+ *
+ * The SGL is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * The SGL is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program. If not,
+ * see <http://www.gnu.org/licenses/>.
+ */
+#ifndef SGL_COLLECTION_INSERT_H_
+#define SGL_COLLECTION_INSERT_H_
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <sgl/detail/common.h>
+#include <sgl/detail/select_integer.h>
+#include <sgl/utility/dispatch.h>
+
+/**
+ * @def sgl_insert(collection, pos, ...)
+ *
+ * Inserts elements before pos and returns an iterator to the
+ * first inserted element:
+ * - sgl_insert(collection, pos, value) inserts value.
+ * - sgl_insert(collection, pos, count, value) inserts count
+ *   copies of value.
+ * - sgl_insert(collection, pos, first, last) inserts a copy of
+ *   the range [first, last).
+ *
+ * Associative collections take the element to insert instead:
+ * - sgl_insert(set, key) returns whether key was inserted.
+ * - sgl_insert(map, key, value) returns a pointer to the value
+ *   associated to key, which is not replaced if key was already
+ *   in the map.
+ */
+#define sgl_insert(collection, ...) \
+    sgl_dispatch(sgl_insert, __VA_ARGS__)(collection, __VA_ARGS__)
+
+#define sgl_insert1(collection, key) \
+    (collection)->_functions->insert1(collection, key)
+
+#define sgl_insert2(collection, pos, value) \
+    (collection)->_functions->insert2(collection, pos, value)
+
+#define sgl_insert3(collection, pos, count_or_first, value_or_last) \
+    sgl_detail_select_integer(count_or_first,                       \
+        (collection)->_functions->insert3,                          \
+        (collection)->_functions->insert_range                      \
+    )(collection, pos, count_or_first, value_or_last)
+
+#endif // SGL_COLLECTION_INSERT_H_
@@ -23,7 +23,18 @@
 ////////////////////////////////////////////////////////////
 #include <sgl/detail/common.h>
 
-#define sgl_is_empty(collection) \
-    (collection)->_functions->is_empty(collection)
+#ifdef SGL_STATIC_DISPATCH
+
+    #define sgl_is_empty(collection)                                                \
+        sgl_detail_static_dispatch(collection,                                      \
+            sgl_detail_members(collection)->_size == 0,                             \
+            (collection)->_functions->is_empty(collection))
+
+#else
+
+    #define sgl_is_empty(collection) \
+        (collection)->_functions->is_empty(collection)
+
+#endif
 
 #endif // SGL_COLLECTION_IS_EMPTY_H_
@@ -23,7 +23,20 @@
 ////////////////////////////////////////////////////////////
 #include <sgl/detail/common.h>
 
-#define sgl_pop_back(collection) \
-    (collection)->_functions->pop_back(collection)
+#ifdef SGL_STATIC_DISPATCH
+
+    #define sgl_pop_back(collection)                                                \
+        sgl_detail_static_dispatch(collection,                                      \
+            (sgl_detail_members(collection)->_size > 0                              \
+                ? (void) --sgl_detail_members(collection)->_size                    \
+                : (void) 0),                                                        \
+            (collection)->_functions->pop_back(collection))
+
+#else
+
+    #define sgl_pop_back(collection) \
+        (collection)->_functions->pop_back(collection)
+
+#endif
 
 #endif // SGL_COLLECTION_POP_BACK_H_
@@ -0,0 +1,35 @@
+/*
+ * Copyright (C) 2015 Morwenn
+ *
+ * The SGL is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * The SGL is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program. If not,
+ * see <http://www.gnu.org/licenses/>.
+ */
+#ifndef SGL_COLLECTION_POP_N_H_
+#define SGL_COLLECTION_POP_N_H_
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <sgl/detail/common.h>
+
+/**
+ * @def sgl_pop_n(collection, out, count)
+ *
+ * Removes up to count elements from a queue into the array out
+ * without blocking, and returns the number of elements removed.
+ */
+#define sgl_pop_n(collection, out, count) \
+    (collection)->_functions->pop_n(collection, out, count)
+
+#endif // SGL_COLLECTION_POP_N_H_
@@ -23,7 +23,22 @@
 ////////////////////////////////////////////////////////////
 #include <sgl/detail/common.h>
 
-#define sgl_push_back(collection, elem) \
-    (collection)->_functions->push_back(collection, elem)
+#ifdef SGL_STATIC_DISPATCH
+
+    // Only the reallocation goes through the function table
+    #define sgl_push_back(collection, elem)                                         \
+        sgl_detail_static_dispatch(collection,                                      \
+            (sgl_detail_members(collection)->_size                                  \
+                    < sgl_detail_members(collection)->_capacity                     \
+                ? (void) (sgl_detail_members_push_slot(collection) = (elem))        \
+                : (collection)->_functions->push_back(collection, elem)),           \
+            (collection)->_functions->push_back(collection, elem))
+
+#else
+
+    #define sgl_push_back(collection, elem) \
+        (collection)->_functions->push_back(collection, elem)
+
+#endif
 
 #endif // SGL_COLLECTION_PUSH_BACK_H_
@@ -23,7 +23,18 @@
 ////////////////////////////////////////////////////////////
 #include <sgl/detail/common.h>
 
-#define sgl_size(collection) \
-    (collection)->_functions->size(collection)
+#ifdef SGL_STATIC_DISPATCH
+
+    #define sgl_size(collection)                                                    \
+        sgl_detail_static_dispatch(collection,                                      \
+            sgl_detail_members(collection)->_size + 0,                              \
+            (collection)->_functions->size(collection))
+
+#else
+
+    #define sgl_size(collection) \
+        (collection)->_functions->size(collection)
+
+#endif
 
 #endif // SGL_COLLECTION_SIZE_H_
@@ -0,0 +1,55 @@
+/*
+ * Copyright (C) 2015 Morwenn
+ *
+ * The SGL is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * The SGL is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program. If not,
+ * see <http://www.gnu.org/licenses/>.
+ */
+#ifndef SGL_COLLECTION_TRY_PUSH_BACK_H_
+#define SGL_COLLECTION_TRY_PUSH_BACK_H_
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <sgl/exception.h>
+#include <sgl/detail/common.h>
+
+/**
+ * @def sgl_try_push_back(collection, elem)
+ *
+ * Same as sgl_push_back, but returns sgl_length_error or
+ * sgl_bad_alloc instead of throwing them, and sgl_no_exception on
+ * success. The collection is unchanged on failure, which lets
+ * latency-critical loops check a return value instead of entering
+ * a sgl_try block.
+ */
+#ifdef SGL_STATIC_DISPATCH
+
+    // Only the reallocation goes through the function table
+    #define sgl_try_push_back(collection, elem)                                     \
+        sgl_detail_static_dispatch(collection,                                      \
+            (sgl_detail_members(collection)->_size                                  \
+                    < sgl_detail_members(collection)->_capacity                     \
+                ? (sgl_detail_members_push_slot(collection) = (elem),               \
+                   sgl_no_exception)                                                \
+                : (collection)->_functions->try_push_back(collection, elem)),       \
+            (collection)->_functions->try_push_back(collection, elem))
+
+#else
+
+    #define sgl_try_push_back(collection, elem) \
+        (collection)->_functions->try_push_back(collection, elem)
+
+#endif
+
+#endif // SGL_COLLECTION_TRY_PUSH_BACK_H_
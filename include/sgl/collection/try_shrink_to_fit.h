@@ -0,0 +1,36 @@
+/*
+ * Copyright (C) 2015 Morwenn
+ *
+ * The SGL is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * The SGL is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program. If not,
+ * see <http://www.gnu.org/licenses/>.
+ */
+#ifndef SGL_COLLECTION_TRY_SHRINK_TO_FIT_H_
+#define SGL_COLLECTION_TRY_SHRINK_TO_FIT_H_
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <sgl/detail/common.h>
+
+/**
+ * @def sgl_try_shrink_to_fit(collection)
+ *
+ * Same as sgl_shrink_to_fit, but returns sgl_bad_alloc instead of
+ * throwing it, and sgl_no_exception on success. The collection is
+ * unchanged on failure.
+ */
+#define sgl_try_shrink_to_fit(collection) \
+    (collection)->_functions->try_shrink_to_fit(collection)
+
+#endif // SGL_COLLECTION_TRY_SHRINK_TO_FIT_H_
@@ -0,0 +1,437 @@
+/*
+ * Copyright (C) 2015 Morwenn
+ *
+ * The SGL is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * The SGL is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program. If not,
+ * see <http://www.gnu.org/licenses/>.
+ */
+#ifndef SGL_DEQUE_H_
+#define SGL_DEQUE_H_
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sgl/collection.h>
+#include <sgl/exception.h>
+#include <sgl/memory/allocator.h>
+#include <sgl/detail/common.h>
+
+#ifndef SGL_DEQUE_CHUNK_BYTES
+
+    /**
+     * @def SGL_DEQUE_CHUNK_BYTES
+     *
+     * Size in bytes of the chunks of the sgl_deque types. Chunks
+     * hold at least 16 elements whatever the size of the elements.
+     * It can be set with the compiler option
+     * -DSGL_DEQUE_CHUNK_BYTES=size.
+     */
+    #define SGL_DEQUE_CHUNK_BYTES 512
+
+#endif
+
+/**
+ * @def sgl_deque(T)
+ *
+ * Alias for the sgl_deque_T type.
+ */
+#define sgl_deque(T) \
+    sgl_deque_##T
+
+/**
+ * @def sgl_define_sgl_deque(T)
+ * Creates all the methods for a sgl_deque of given type.
+ */
+#define sgl_define_sgl_deque(T)                                                     \
+    sgl_declare_sgl_deque(T)                                                        \
+    sgl_instantiate_sgl_deque(T)
+
+/**
+ * @def sgl_declare_sgl_deque(T)
+ * Declares the type and the methods of a sgl_deque of given type.
+ * A deque stores its elements in fixed-size chunks referenced by a
+ * map of chunk pointers. Elements can be pushed and popped at both
+ * ends in O(1) and accessed by index, and they never move: their
+ * addresses stay valid until they are popped. Popping from an
+ * empty deque does nothing.
+ *
+ * The elements are not contiguous, so the accessors of the deque
+ * always go through its function table, even with
+ * SGL_STATIC_DISPATCH.
+ */
+#define sgl_declare_sgl_deque(T)                                                    \
+                                                                                    \
+    typedef struct sgl_detail_deque_##T sgl_deque(T);                               \
+                                                                                    \
+    typedef T sgl_deque_##T##_value_type;                                           \
+    typedef size_t sgl_deque_##T##_size_type;                                       \
+    typedef ptrdiff_t sgl_deque_##T##_difference_type;                              \
+                                                                                    \
+    enum                                                                            \
+    {                                                                               \
+        sgl_detail_deque_chunk_##T =                                                \
+            sizeof(T) < SGL_DEQUE_CHUNK_BYTES / 16                                  \
+                ? SGL_DEQUE_CHUNK_BYTES / sizeof(T)                                 \
+                : 16                                                                \
+    };                                                                              \
+                                                                                    \
+    typedef struct                                                                  \
+    {                                                                               \
+        void (*delete)(sgl_deque(T)*);                                              \
+        void (*destroy)(sgl_deque(T)*);                                             \
+        T* (*at)(const sgl_deque(T)*, size_t);                                      \
+        T* (*front)(const sgl_deque(T)*);                                           \
+        T* (*back)(const sgl_deque(T)*);                                            \
+        bool (*is_empty)(const sgl_deque(T)*);                                      \
+        size_t (*size)(const sgl_deque(T)*);                                        \
+        size_t (*max_size)(void);                                                   \
+        void (*shrink_to_fit)(sgl_deque(T)*);                                       \
+        void (*clear)(sgl_deque(T)*);                                               \
+        void (*push_back)(sgl_deque(T)*, T);                                        \
+        void (*pop_back)(sgl_deque(T)*);                                            \
+        void (*push_front)(sgl_deque(T)*, T);                                       \
+        void (*pop_front)(sgl_deque(T)*);                                           \
+        sgl_detail_opaque_layout _layout;                                           \
+    } sgl_detail_deque_functions_##T;                                               \
+                                                                                    \
+    struct sgl_detail_deque_##T                                                     \
+    {                                                                               \
+        T** _map;                                                                   \
+        size_t _map_size;                                                           \
+        size_t _start;                                                              \
+        size_t _size;                                                               \
+        T* _spare;                                                                  \
+        const sgl_allocator* _allocator;                                            \
+        const sgl_detail_deque_functions_##T* _functions;                           \
+    };                                                                              \
+                                                                                    \
+sgl_deque(T)* sgl_new_sgl_deque_##T();                                              \
+sgl_deque(T)* sgl_new_with_allocator_sgl_deque_##T(const sgl_allocator*);           \
+void sgl_init_sgl_deque_##T(sgl_deque(T)*);                                         \
+void sgl_init_with_allocator_sgl_deque_##T(sgl_deque(T)*, const sgl_allocator*);    \
+void sgl_deque_delete_##T(sgl_deque(T)*);                                           \
+void sgl_deque_destroy_##T(sgl_deque(T)*);                                          \
+T* sgl_deque_at_##T(const sgl_deque(T)*, size_t);                                   \
+T* sgl_deque_front_##T(const sgl_deque(T)*);                                        \
+T* sgl_deque_back_##T(const sgl_deque(T)*);                                         \
+bool sgl_deque_is_empty_##T(const sgl_deque(T)*);                                   \
+size_t sgl_deque_size_##T(const sgl_deque(T)*);                                     \
+size_t sgl_deque_max_size_##T(void);                                                \
+void sgl_deque_shrink_to_fit_##T(sgl_deque(T)*);                                    \
+void sgl_deque_clear_##T(sgl_deque(T)*);                                            \
+void sgl_deque_push_back_##T(sgl_deque(T)*, T);                                     \
+void sgl_deque_pop_back_##T(sgl_deque(T)*);                                         \
+void sgl_deque_push_front_##T(sgl_deque(T)*, T);                                    \
+void sgl_deque_pop_front_##T(sgl_deque(T)*);                                        \
+                                                                                    \
+extern const sgl_detail_deque_functions_##T sgl_detail_deque_funcs_##T;
+
+/**
+ * @def sgl_instantiate_sgl_deque(T)
+ * Defines the methods of a sgl_deque of given type, which must
+ * have been declared beforehand. It shall appear in exactly one
+ * translation unit.
+ */
+#define sgl_instantiate_sgl_deque(T)                                                \
+                                                                                    \
+/* Returns an empty chunk, the spare one if there is one */                         \
+static inline T* sgl_detail_deque_new_chunk_##T(sgl_deque(T)* deque)                \
+{                                                                                   \
+    T* chunk = deque->_spare;                                                       \
+    if (chunk)                                                                      \
+    {                                                                               \
+        deque->_spare = NULL;                                                       \
+        return chunk;                                                               \
+    }                                                                               \
+    chunk = sgl_detail_allocate(deque->_allocator,                                  \
+                                sgl_detail_deque_chunk_##T * sizeof(T),             \
+                                alignof(T));                                        \
+    if (not chunk)                                                                  \
+    {                                                                               \
+        sgl_throw(sgl_bad_alloc);                                                   \
+    }                                                                               \
+    return chunk;                                                                   \
+}                                                                                   \
+                                                                                    \
+/* Releases the chunk in the given slot of the map, which is kept as */             \
+/* the spare chunk so that a deque oscillating around the boundary */               \
+/* of a chunk does not allocate memory every time */                                \
+static inline void sgl_detail_deque_release_chunk_##T(sgl_deque(T)* deque,          \
+                                                      size_t slot)                  \
+{                                                                                   \
+    if (deque->_spare)                                                              \
+    {                                                                               \
+        sgl_detail_deallocate(deque->_allocator, deque->_map[slot],                 \
+                              sgl_detail_deque_chunk_##T * sizeof(T));              \
+    }                                                                               \
+    else                                                                            \
+    {                                                                               \
+        deque->_spare = deque->_map[slot];                                          \
+    }                                                                               \
+    deque->_map[slot] = NULL;                                                       \
+}                                                                                   \
+                                                                                    \
+/* Makes room for one more chunk at both ends of the map, moving the */             \
+/* chunk pointers to its middle; the chunks themselves do not move */               \
+static inline void sgl_detail_deque_grow_map_##T(sgl_deque(T)* deque)               \
+{                                                                                   \
+    size_t chunk = sgl_detail_deque_chunk_##T;                                      \
+    size_t first = deque->_start / chunk;                                           \
+    size_t used = (deque->_start + deque->_size + chunk - 1) / chunk - first;       \
+    size_t new_first;                                                               \
+                                                                                    \
+    if (deque->_map_size >= 2 * (used + 1))                                         \
+    {                                                                               \
+        /* Recenter the chunks in the current map */                                \
+        new_first = (deque->_map_size - used) / 2;                                  \
+        memmove(deque->_map + new_first, deque->_map + first, used * sizeof(T*));   \
+        for (size_t i = 0 ; i < deque->_map_size ; ++i)                             \
+        {                                                                           \
+            if (i < new_first || i >= new_first + used)                             \
+            {                                                                       \
+                deque->_map[i] = NULL;                                              \
+            }                                                                       \
+        }                                                                           \
+    }                                                                               \
+    else                                                                            \
+    {                                                                               \
+        size_t new_size = deque->_map_size ? deque->_map_size : 4;                  \
+        while (new_size < 2 * (used + 1))                                           \
+        {                                                                           \
+            if (new_size > SIZE_MAX / (2 * sizeof(T*)))                             \
+            {                                                                       \
+                sgl_throw(sgl_length_error);                                        \
+            }                                                                       \
+            new_size *= 2;                                                          \
+        }                                                                           \
+        T** map = sgl_detail_allocate(deque->_allocator,                            \
+                                      new_size * sizeof(T*), alignof(T*));          \
+        if (not map)                                                                \
+        {                                                                           \
+            sgl_throw(sgl_bad_alloc);                                               \
+        }                                                                           \
+        new_first = (new_size - used) / 2;                                          \
+        for (size_t i = 0 ; i < new_size ; ++i)                                     \
+        {                                                                           \
+            map[i] = NULL;                                                          \
+        }                                                                           \
+        if (used)                                                                   \
+        {                                                                           \
+            memcpy(map + new_first, deque->_map + first, used * sizeof(T*));        \
+        }                                                                           \
+        if (deque->_map)                                                            \
+        {                                                                           \
+            sgl_detail_deallocate(deque->_allocator, deque->_map,                   \
+                                  deque->_map_size * sizeof(T*));                   \
+        }                                                                           \
+        deque->_map = map;                                                          \
+        deque->_map_size = new_size;                                                \
+    }                                                                               \
+    deque->_start = new_first * chunk + deque->_start % chunk;                      \
+}                                                                                   \
+                                                                                    \
+void sgl_deque_delete_##T(sgl_deque(T)* deque)                                      \
+{                                                                                   \
+    sgl_deque_destroy_##T(deque);                                                   \
+    sgl_detail_deallocate(deque->_allocator, deque, sizeof(sgl_deque(T)));          \
+}                                                                                   \
+                                                                                    \
+void sgl_deque_destroy_##T(sgl_deque(T)* deque)                                     \
+{                                                                                   \
+    sgl_deque_clear_##T(deque);                                                     \
+    sgl_deque_shrink_to_fit_##T(deque);                                             \
+}                                                                                   \
+                                                                                    \
+T* sgl_deque_at_##T(const sgl_deque(T)* deque, size_t index)                        \
+{                                                                                   \
+    size_t pos = deque->_start + index;                                             \
+    return deque->_map[pos / sgl_detail_deque_chunk_##T]                            \
+         + pos % sgl_detail_deque_chunk_##T;                                        \
+}                                                                                   \
+                                                                                    \
+T* sgl_deque_front_##T(const sgl_deque(T)* deque)                                   \
+{                                                                                   \
+    return sgl_deque_at_##T(deque, 0);                                              \
+}                                                                                   \
+                                                                                    \
+T* sgl_deque_back_##T(const sgl_deque(T)* deque)                                    \
+{                                                                                   \
+    return sgl_deque_at_##T(deque, deque->_size - 1);                               \
+}                                                                                   \
+                                                                                    \
+bool sgl_deque_is_empty_##T(const sgl_deque(T)* deque)                              \
+{                                                                                   \
+    return deque->_size == 0;                                                       \
+}                                                                                   \
+                                                                                    \
+size_t sgl_deque_size_##T(const sgl_deque(T)* deque)                                \
+{                                                                                   \
+    return deque->_size;                                                            \
+}                                                                                   \
+                                                                                    \
+size_t sgl_deque_max_size_##T(void)                                                 \
+{                                                                                   \
+    return SIZE_MAX / sizeof(T);                                                    \
+}                                                                                   \
+                                                                                    \
+void sgl_deque_shrink_to_fit_##T(sgl_deque(T)* deque)                               \
+{                                                                                   \
+    if (deque->_spare)                                                              \
+    {                                                                               \
+        sgl_detail_deallocate(deque->_allocator, deque->_spare,                     \
+                              sgl_detail_deque_chunk_##T * sizeof(T));              \
+        deque->_spare = NULL;                                                       \
+    }                                                                               \
+    if (deque->_size == 0 && deque->_map)                                           \
+    {                                                                               \
+        /* Go back to the unallocated state */                                      \
+        sgl_detail_deallocate(deque->_allocator, deque->_map,                       \
+                              deque->_map_size * sizeof(T*));                       \
+        deque->_map = NULL;                                                         \
+        deque->_map_size = 0;                                                       \
+        deque->_start = 0;                                                          \
+    }                                                                               \
+}                                                                                   \
+                                                                                    \
+void sgl_deque_clear_##T(sgl_deque(T)* deque)                                       \
+{                                                                                   \
+    size_t chunk = sgl_detail_deque_chunk_##T;                                      \
+    size_t first = deque->_start / chunk;                                           \
+    size_t last = (deque->_start + deque->_size + chunk - 1) / chunk;               \
+    for (size_t slot = first ; slot < last ; ++slot)                                \
+    {                                                                               \
+        sgl_detail_deque_release_chunk_##T(deque, slot);                            \
+    }                                                                               \
+    deque->_start = deque->_map_size / 2 * chunk;                                   \
+    deque->_size = 0;                                                               \
+}                                                                                   \
+                                                                                    \
+void sgl_deque_push_back_##T(sgl_deque(T)* deque, T value)                          \
+{                                                                                   \
+    size_t pos = deque->_start + deque->_size;                                      \
+    if (pos / sgl_detail_deque_chunk_##T == deque->_map_size)                       \
+    {                                                                               \
+        sgl_detail_deque_grow_map_##T(deque);                                       \
+        pos = deque->_start + deque->_size;                                         \
+    }                                                                               \
+    T** slot = deque->_map + pos / sgl_detail_deque_chunk_##T;                      \
+    if (*slot == NULL)                                                              \
+    {                                                                               \
+        *slot = sgl_detail_deque_new_chunk_##T(deque);                              \
+    }                                                                               \
+    (*slot)[pos % sgl_detail_deque_chunk_##T] = value;                              \
+    ++deque->_size;                                                                 \
+}                                                                                   \
+                                                                                    \
+void sgl_deque_pop_back_##T(sgl_deque(T)* deque)                                    \
+{                                                                                   \
+    if (deque->_size == 0)                                                          \
+    {                                                                               \
+        return;                                                                     \
+    }                                                                               \
+    size_t pos = deque->_start + --deque->_size;                                    \
+    if (pos % sgl_detail_deque_chunk_##T == 0)                                      \
+    {                                                                               \
+        sgl_detail_deque_release_chunk_##T(deque,                                   \
+                                           pos / sgl_detail_deque_chunk_##T);       \
+    }                                                                               \
+}                                                                                   \
+                                                                                    \
+void sgl_deque_push_front_##T(sgl_deque(T)* deque, T value)                         \
+{                                                                                   \
+    if (deque->_start == 0)                                                         \
+    {                                                                               \
+        sgl_detail_deque_grow_map_##T(deque);                                       \
+    }                                                                               \
+    size_t pos = deque->_start - 1;                                                 \
+    T** slot = deque->_map + pos / sgl_detail_deque_chunk_##T;                      \
+    if (*slot == NULL)                                                              \
+    {                                                                               \
+        *slot = sgl_detail_deque_new_chunk_##T(deque);                              \
+    }                                                                               \
+    (*slot)[pos % sgl_detail_deque_chunk_##T] = value;                              \
+    deque->_start = pos;                                                            \
+    ++deque->_size;                                                                 \
+}                                                                                   \
+                                                                                    \
+void sgl_deque_pop_front_##T(sgl_deque(T)* deque)                                   \
+{                                                                                   \
+    if (deque->_size == 0)                                                          \
+    {                                                                               \
+        return;                                                                     \
+    }                                                                               \
+    size_t pos = deque->_start++;                                                   \
+    --deque->_size;                                                                 \
+    if (deque->_start % sgl_detail_deque_chunk_##T == 0)                            \
+    {                                                                               \
+        sgl_detail_deque_release_chunk_##T(deque,                                   \
+                                           pos / sgl_detail_deque_chunk_##T);       \
+    }                                                                               \
+}                                                                                   \
+                                                                                    \
+const sgl_detail_deque_functions_##T sgl_detail_deque_funcs_##T = {                 \
+    &sgl_deque_delete_##T,                                                          \
+    &sgl_deque_destroy_##T,                                                         \
+    &sgl_deque_at_##T,                                                              \
+    &sgl_deque_front_##T,                                                           \
+    &sgl_deque_back_##T,                                                            \
+    &sgl_deque_is_empty_##T,                                                        \
+    &sgl_deque_size_##T,                                                            \
+    &sgl_deque_max_size_##T,                                                        \
+    &sgl_deque_shrink_to_fit_##T,                                                   \
+    &sgl_deque_clear_##T,                                                           \
+    &sgl_deque_push_back_##T,                                                       \
+    &sgl_deque_pop_back_##T,                                                        \
+    &sgl_deque_push_front_##T,                                                      \
+    &sgl_deque_pop_front_##T,                                                       \
+    { 0 }                                                                           \
+};                                                                                  \
+                                                                                    \
+void sgl_init_with_allocator_sgl_deque_##T(sgl_deque(T)* deque,                     \
+                                           const sgl_allocator* allocator)          \
+{                                                                                   \
+    deque->_functions = &sgl_detail_deque_funcs_##T;                                \
+    deque->_allocator = allocator;                                                  \
+    deque->_map = NULL;                                                             \
+    deque->_map_size = 0;                                                           \
+    deque->_start = 0;                                                              \
+    deque->_size = 0;                                                               \
+    deque->_spare = NULL;                                                           \
+}                                                                                   \
+                                                                                    \
+void sgl_init_sgl_deque_##T(sgl_deque(T)* deque)                                    \
+{                                                                                   \
+    sgl_init_with_allocator_sgl_deque_##T(deque, NULL);                             \
+}                                                                                   \
+                                                                                    \
+sgl_deque(T)* sgl_new_with_allocator_sgl_deque_##T(const sgl_allocator* allocator)  \
+{                                                                                   \
+    sgl_deque(T)* res = sgl_detail_allocate(allocator, sizeof(sgl_deque(T)),        \
+                                            alignof(sgl_deque(T)));                 \
+    if (not res)                                                                    \
+    {                                                                               \
+        sgl_throw(sgl_bad_alloc);                                                   \
+    }                                                                               \
+    sgl_init_with_allocator_sgl_deque_##T(res, allocator);                          \
+    return res;                                                                     \
+}                                                                                   \
+                                                                                    \
+sgl_deque(T)* sgl_new_sgl_deque_##T()                                               \
+{                                                                                   \
+    return sgl_new_with_allocator_sgl_deque_##T(NULL);                              \
+}
+
+#endif // SGL_DEQUE_H_
@@ -28,4 +28,71 @@
 #include <stddef.h>
 #include <stdnoreturn.h>
 
+/**
+ * @def SGL_STATIC_DISPATCH
+ *
+ * When defined with the compiler option -DSGL_STATIC_DISPATCH, the
+ * collection accessors (sgl_at, sgl_data, sgl_size, sgl_begin...)
+ * and the fast path of sgl_push_back directly read the members of
+ * contiguous collections such as sgl_vector instead of calling a
+ * function through their function table, which allows the compiler
+ * to inline them. The choice is made at compile time for every
+ * collection type; the other collections still go through their
+ * function table. The collection argument of these accessors may be
+ * evaluated more than once in this mode.
+ */
+
+////////////////////////////////////////////////////////////
+// Static dispatch implementation
+
+// Every function table has a _layout member whose type tells the
+// collection macros whether the collection has contiguous _data,
+// _size and _capacity members that they can access directly
+typedef struct { char _unused; } sgl_detail_contiguous_layout;
+typedef struct { char _unused; } sgl_detail_opaque_layout;
+
+// Members read by the unselected branches of the collection macros
+// for collections which do not have them; they are never evaluated
+typedef struct
+{
+    char* _data;
+    size_t _size;
+    size_t _capacity;
+} sgl_detail_opaque_members;
+
+// Expands to direct for contiguous collections and to indirect for
+// the other ones; both expressions have to compile for any collection
+#define sgl_detail_static_dispatch(collection, direct, indirect)                    \
+    _Generic(&(collection)->_functions->_layout,                                    \
+             const sgl_detail_contiguous_layout*: direct,                           \
+             default: indirect)
+
+// Collection whose _data, _size and _capacity members can be named
+// in the direct branch of sgl_detail_static_dispatch
+#define sgl_detail_members(collection)                                              \
+    sgl_detail_static_dispatch(collection, (collection),                            \
+                               (sgl_detail_opaque_members*) NULL)
+
+// _data member of contiguous collections, fallback expression of the
+// same type for the other ones, when the type of the elements matters
+// in the unselected branch
+#define sgl_detail_members_data(collection, fallback)                               \
+    sgl_detail_static_dispatch(collection,                                          \
+                               sgl_detail_members(collection)->_data, fallback)
+
+// Same as sgl_detail_members_data, with the const qualifier taken by
+// the conditional operator from the result of the given function
+#define sgl_detail_members_cdata(collection, function)                              \
+    (1 ? sgl_detail_members_data(collection,                                        \
+                                 (collection)->_functions->function(collection))    \
+       : (collection)->_functions->function(collection))
+
+// Slot past the last element of a contiguous collection, whose size
+// is incremented; push_back collections without _data give its type
+// through their front function
+#define sgl_detail_members_push_slot(collection)                                    \
+    sgl_detail_members_data(collection,                                             \
+                            (collection)->_functions->front(collection))            \
+        [sgl_detail_members(collection)->_size++]
+
 #endif // SGL_DETAIL_COMMON_H_
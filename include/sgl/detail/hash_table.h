@@ -0,0 +1,400 @@
+/*
+ * Copyright (C) 2015 Morwenn
+ *
+ * The SGL is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * The SGL is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program. If not,
+ * see <http://www.gnu.org/licenses/>.
+ */
+#ifndef SGL_DETAIL_HASH_TABLE_H_
+#define SGL_DETAIL_HASH_TABLE_H_
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <stdint.h>
+#include <string.h>
+#include <sgl/exception.h>
+#include <sgl/hash.h>
+#include <sgl/memory/allocator.h>
+#include <sgl/detail/common.h>
+
+#if defined(__SSE2__) || defined(_M_X64)
+    #include <emmintrin.h>
+    #define SGL_DETAIL_HASH_TABLE_SSE2
+#endif
+
+// Note: the hash tables follow the layout of the Swiss tables.
+//       Every slot has a control byte which is either empty or
+//       holds the 7 low bits of the hash of the key in the slot.
+//       Lookups compare the control bytes of 16 consecutive slots
+//       at once. The first group of control bytes is duplicated
+//       after the last one so that a group can start anywhere.
+//
+//       A key is stored in the first empty slot found when probing
+//       linearly from its home slot, and erasing a key shifts the
+//       following keys backward instead of leaving a tombstone,
+//       which keeps every slot between the home of a key and the
+//       key itself full.
+
+////////////////////////////////////////////////////////////
+// Control bytes
+
+#define SGL_DETAIL_GROUP_WIDTH 16
+#define SGL_DETAIL_CTRL_EMPTY ((int8_t) -128)
+
+static inline size_t sgl_detail_hash_h1(size_t hash)
+{
+    return hash >> 7;
+}
+
+static inline int8_t sgl_detail_hash_h2(size_t hash)
+{
+    return (int8_t) (hash & 0x7f);
+}
+
+// Returns a mask of the slots of the group whose control byte is h2
+static inline unsigned sgl_detail_group_match(const int8_t* group, int8_t h2)
+{
+#ifdef SGL_DETAIL_HASH_TABLE_SSE2
+    __m128i ctrl = _mm_loadu_si128((const __m128i*) group);
+    return (unsigned) _mm_movemask_epi8(_mm_cmpeq_epi8(ctrl, _mm_set1_epi8(h2)));
+#else
+    unsigned res = 0;
+    for (unsigned i = 0 ; i < SGL_DETAIL_GROUP_WIDTH ; ++i)
+    {
+        res |= (unsigned) (group[i] == h2) << i;
+    }
+    return res;
+#endif
+}
+
+// Returns a mask of the empty slots of the group
+static inline unsigned sgl_detail_group_match_empty(const int8_t* group)
+{
+#ifdef SGL_DETAIL_HASH_TABLE_SSE2
+    // Only the empty control byte has its sign bit set
+    __m128i ctrl = _mm_loadu_si128((const __m128i*) group);
+    return (unsigned) _mm_movemask_epi8(ctrl);
+#else
+    unsigned res = 0;
+    for (unsigned i = 0 ; i < SGL_DETAIL_GROUP_WIDTH ; ++i)
+    {
+        res |= (unsigned) (group[i] < 0) << i;
+    }
+    return res;
+#endif
+}
+
+// Index of the lowest set bit of a non-null mask
+static inline unsigned sgl_detail_lowest_bit(unsigned mask)
+{
+#if defined(__GNUC__)
+    return (unsigned) __builtin_ctz(mask);
+#else
+    unsigned res = 0;
+    while (not (mask & 1u))
+    {
+        mask >>= 1;
+        ++res;
+    }
+    return res;
+#endif
+}
+
+// Number of keys a table of the given capacity can hold before
+// growing, the maximal load factor is 7/8
+static inline size_t sgl_detail_hash_table_max_load(size_t capacity)
+{
+    return capacity - capacity / 8;
+}
+
+// Smallest capacity able to hold count keys
+static inline size_t sgl_detail_hash_table_capacity_for(size_t count)
+{
+    size_t capacity = SGL_DETAIL_GROUP_WIDTH;
+    while (sgl_detail_hash_table_max_load(capacity) < count)
+    {
+        if (capacity > SIZE_MAX / 2)
+        {
+            sgl_throw(sgl_length_error);
+        }
+        capacity *= 2;
+    }
+    return capacity;
+}
+
+////////////////////////////////////////////////////////////
+// Default hash and equality
+
+#define sgl_detail_equal_object(lhs, rhs) \
+    (memcmp(lhs, rhs, sizeof *(lhs)) == 0)
+
+#ifndef SGL_UNORDERED_HASH
+
+    /**
+     * @def SGL_UNORDERED_HASH
+     *
+     * Hash function of the keys of the sgl_unordered_map and
+     * sgl_unordered_set types, read when sgl_define is called. It
+     * takes a pointer to a key and returns a size_t. The default
+     * one is sgl_hash_object. It can be redefined between
+     * two sgl_define calls to give different hash functions to
+     * different key types.
+     */
+    #define SGL_UNORDERED_HASH sgl_hash_object
+
+#endif
+
+#ifndef SGL_UNORDERED_EQUAL
+
+    /**
+     * @def SGL_UNORDERED_EQUAL
+     *
+     * Equality function of the keys of the sgl_unordered_map and
+     * sgl_unordered_set types, read when sgl_define is called. It
+     * takes two pointers to keys and returns whether the keys are
+     * equal. The default one compares the bytes of the keys, which
+     * is wrong for keys with padding or pointers to strings.
+     */
+    #define SGL_UNORDERED_EQUAL sgl_detail_equal_object
+
+#endif
+
+////////////////////////////////////////////////////////////
+// Generic implementation
+
+/**
+ * @def sgl_detail_instantiate_hash_table(N, E, K, hash, equal)
+ *
+ * Defines the static functions shared by the sgl_N hash tables,
+ * whose slots of type E start with a member key of type K. The
+ * tables have the members _ctrl, _slots, _size, _capacity and
+ * _allocator. The hash function takes a const K* and returns a
+ * size_t, the equality function takes two const K*.
+ */
+#define sgl_detail_instantiate_hash_table(N, E, K, hash, equal)                     \
+                                                                                    \
+static inline size_t sgl_detail_##N##_bytes(size_t capacity)                        \
+{                                                                                   \
+    return capacity * sizeof(E) + capacity + SGL_DETAIL_GROUP_WIDTH;                \
+}                                                                                   \
+                                                                                    \
+static inline void sgl_detail_##N##_set_ctrl(sgl_##N* table,                        \
+                                             size_t index, int8_t value)            \
+{                                                                                   \
+    table->_ctrl[index] = value;                                                    \
+    if (index < SGL_DETAIL_GROUP_WIDTH)                                             \
+    {                                                                               \
+        /* Keep the cloned group up to date */                                      \
+        table->_ctrl[table->_capacity + index] = value;                             \
+    }                                                                               \
+}                                                                                   \
+                                                                                    \
+/* Returns the slot of key, or SIZE_MAX if it is not in the table */                \
+static inline size_t sgl_detail_##N##_find(const sgl_##N* table,                    \
+                                           const K* key, size_t hash_value)         \
+{                                                                                   \
+    if (table->_size == 0)                                                          \
+    {                                                                               \
+        return SIZE_MAX;                                                            \
+    }                                                                               \
+    int8_t h2 = sgl_detail_hash_h2(hash_value);                                     \
+    size_t mask = table->_capacity - 1;                                             \
+    size_t pos = sgl_detail_hash_h1(hash_value) & mask;                             \
+    for (;;)                                                                        \
+    {                                                                               \
+        const int8_t* group = table->_ctrl + pos;                                   \
+        unsigned match = sgl_detail_group_match(group, h2);                         \
+        while (match)                                                               \
+        {                                                                           \
+            size_t index = (pos + sgl_detail_lowest_bit(match)) & mask;             \
+            if (equal(&table->_slots[index].key, key))                              \
+            {                                                                       \
+                return index;                                                       \
+            }                                                                       \
+            match &= match - 1;                                                     \
+        }                                                                           \
+        if (sgl_detail_group_match_empty(group))                                    \
+        {                                                                           \
+            return SIZE_MAX;                                                        \
+        }                                                                           \
+        pos = (pos + SGL_DETAIL_GROUP_WIDTH) & mask;                                \
+    }                                                                               \
+}                                                                                   \
+                                                                                    \
+/* Returns the first empty slot from the home of the hash */                        \
+static inline size_t sgl_detail_##N##_find_empty(const sgl_##N* table,              \
+                                                 size_t hash_value)                 \
+{                                                                                   \
+    size_t mask = table->_capacity - 1;                                             \
+    size_t pos = sgl_detail_hash_h1(hash_value) & mask;                             \
+    for (;;)                                                                        \
+    {                                                                               \
+        unsigned empty = sgl_detail_group_match_empty(table->_ctrl + pos);          \
+        if (empty)                                                                  \
+        {                                                                           \
+            return (pos + sgl_detail_lowest_bit(empty)) & mask;                     \
+        }                                                                           \
+        pos = (pos + SGL_DETAIL_GROUP_WIDTH) & mask;                                \
+    }                                                                               \
+}                                                                                   \
+                                                                                    \
+/* Moves the keys to a new array of slots, capacity is a power of 2 */              \
+static inline void sgl_detail_##N##_resize(sgl_##N* table, size_t capacity)         \
+{                                                                                   \
+    if (capacity > (SIZE_MAX - SGL_DETAIL_GROUP_WIDTH) / (sizeof(E) + 1))           \
+    {                                                                               \
+        sgl_throw(sgl_length_error);                                                \
+    }                                                                               \
+    E* slots = sgl_detail_allocate(table->_allocator,                               \
+                                   sgl_detail_##N##_bytes(capacity),                \
+                                   alignof(E));                                     \
+    if (not slots)                                                                  \
+    {                                                                               \
+        sgl_throw(sgl_bad_alloc);                                                   \
+    }                                                                               \
+                                                                                    \
+    E* old_slots = table->_slots;                                                   \
+    int8_t* old_ctrl = table->_ctrl;                                                \
+    size_t old_capacity = table->_capacity;                                         \
+                                                                                    \
+    table->_slots = slots;                                                          \
+    table->_ctrl = (int8_t*) (slots + capacity);                                    \
+    table->_capacity = capacity;                                                    \
+    memset(table->_ctrl, (unsigned char) SGL_DETAIL_CTRL_EMPTY,                     \
+           capacity + SGL_DETAIL_GROUP_WIDTH);                                      \
+                                                                                    \
+    for (size_t i = 0 ; i < old_capacity ; ++i)                                     \
+    {                                                                               \
+        if (old_ctrl[i] >= 0)                                                       \
+        {                                                                           \
+            size_t hash_value = hash(&old_slots[i].key);                            \
+            size_t index = sgl_detail_##N##_find_empty(table, hash_value);          \
+            sgl_detail_##N##_set_ctrl(table, index,                                 \
+                                      sgl_detail_hash_h2(hash_value));              \
+            table->_slots[index] = old_slots[i];                                    \
+        }                                                                           \
+    }                                                                               \
+    if (old_capacity)                                                               \
+    {                                                                               \
+        sgl_detail_deallocate(table->_allocator, old_slots,                         \
+                              sgl_detail_##N##_bytes(old_capacity));                \
+    }                                                                               \
+}                                                                                   \
+                                                                                    \
+/* Returns the slot of key, allocating a new one if needed */                       \
+static inline size_t sgl_detail_##N##_prepare_insert(sgl_##N* table,                \
+                                                     const K* key,                  \
+                                                     bool* inserted)                \
+{                                                                                   \
+    size_t hash_value = hash(key);                                                  \
+    size_t index = sgl_detail_##N##_find(table, key, hash_value);                   \
+    if (index != SIZE_MAX)                                                          \
+    {                                                                               \
+        *inserted = false;                                                          \
+        return index;                                                               \
+    }                                                                               \
+    if (table->_size >= sgl_detail_hash_table_max_load(table->_capacity))           \
+    {                                                                               \
+        if (table->_capacity > SIZE_MAX / 2)                                        \
+        {                                                                           \
+            sgl_throw(sgl_length_error);                                            \
+        }                                                                           \
+        sgl_detail_##N##_resize(table, table->_capacity                             \
+                                     ? table->_capacity * 2                         \
+                                     : SGL_DETAIL_GROUP_WIDTH);                     \
+    }                                                                               \
+    index = sgl_detail_##N##_find_empty(table, hash_value);                         \
+    sgl_detail_##N##_set_ctrl(table, index, sgl_detail_hash_h2(hash_value));        \
+    ++table->_size;                                                                 \
+    *inserted = true;                                                               \
+    return index;                                                                   \
+}                                                                                   \
+                                                                                    \
+/* Erases the key in the given slot with backward shift deletion */                 \
+static inline void sgl_detail_##N##_erase_at(sgl_##N* table, size_t index)          \
+{                                                                                   \
+    size_t mask = table->_capacity - 1;                                             \
+    size_t next = index;                                                            \
+    for (;;)                                                                        \
+    {                                                                               \
+        next = (next + 1) & mask;                                                   \
+        if (table->_ctrl[next] == SGL_DETAIL_CTRL_EMPTY)                            \
+        {                                                                           \
+            break;                                                                  \
+        }                                                                           \
+        /* The key can fill the hole if its home is not in (index, next] */         \
+        size_t home = sgl_detail_hash_h1(hash(&table->_slots[next].key)) & mask;    \
+        if (((next - home) & mask) >= ((next - index) & mask))                      \
+        {                                                                           \
+            table->_slots[index] = table->_slots[next];                             \
+            sgl_detail_##N##_set_ctrl(table, index, table->_ctrl[next]);            \
+            index = next;                                                           \
+        }                                                                           \
+    }                                                                               \
+    sgl_detail_##N##_set_ctrl(table, index, SGL_DETAIL_CTRL_EMPTY);                 \
+    --table->_size;                                                                 \
+}                                                                                   \
+                                                                                    \
+static inline void sgl_detail_##N##_destroy_slots(sgl_##N* table)                   \
+{                                                                                   \
+    if (table->_capacity)                                                           \
+    {                                                                               \
+        sgl_detail_deallocate(table->_allocator, table->_slots,                     \
+                              sgl_detail_##N##_bytes(table->_capacity));            \
+    }                                                                               \
+    table->_slots = NULL;                                                           \
+    table->_ctrl = NULL;                                                            \
+    table->_size = 0;                                                               \
+    table->_capacity = 0;                                                           \
+}                                                                                   \
+                                                                                    \
+static inline void sgl_detail_##N##_reserve(sgl_##N* table, size_t count)           \
+{                                                                                   \
+    if (count > sgl_detail_hash_table_max_load(table->_capacity))                   \
+    {                                                                               \
+        sgl_detail_##N##_resize(table,                                              \
+                                sgl_detail_hash_table_capacity_for(count));         \
+    }                                                                               \
+}                                                                                   \
+                                                                                    \
+static inline void sgl_detail_##N##_rehash(sgl_##N* table, size_t count)            \
+{                                                                                   \
+    if (count < table->_size)                                                       \
+    {                                                                               \
+        count = table->_size;                                                       \
+    }                                                                               \
+    size_t capacity = sgl_detail_hash_table_capacity_for(count);                    \
+    if (table->_size == 0 && count == 0)                                            \
+    {                                                                               \
+        /* Go back to the unallocated state */                                      \
+        sgl_detail_##N##_destroy_slots(table);                                      \
+        return;                                                                     \
+    }                                                                               \
+    if (capacity != table->_capacity)                                               \
+    {                                                                               \
+        sgl_detail_##N##_resize(table, capacity);                                   \
+    }                                                                               \
+}                                                                                   \
+                                                                                    \
+static inline void sgl_detail_##N##_clear(sgl_##N* table)                           \
+{                                                                                   \
+    if (table->_capacity)                                                           \
+    {                                                                               \
+        memset(table->_ctrl, (unsigned char) SGL_DETAIL_CTRL_EMPTY,                 \
+               table->_capacity + SGL_DETAIL_GROUP_WIDTH);                          \
+    }                                                                               \
+    table->_size = 0;                                                               \
+}
+
+#endif // SGL_DETAIL_HASH_TABLE_H_
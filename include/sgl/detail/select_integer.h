@@ -0,0 +1,55 @@
+/*
+ * Copyright (C) 2015 Morwenn
+ *
+ * The SGL is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * The SGL is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program. If not,
+ * see <http://www.gnu.org/licenses/>.
+ */
+#ifndef SGL_DETAIL_SELECT_INTEGER_H_
+#define SGL_DETAIL_SELECT_INTEGER_H_
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <sgl/detail/common.h>
+
+// Note: it is used to tell apart overloads taking the same number
+//       of parameters, such as (count, value) and (first, last).
+//       Since the unselected expression still has to be valid, it
+//       is better to select function designators and to call the
+//       result than to select whole function calls.
+
+/**
+ * @def sgl_detail_select_integer(value, if_integer, otherwise)
+ *
+ * Selects if_integer when value has an integer type and
+ * otherwise in any other case.
+ */
+#define sgl_detail_select_integer(value, if_integer, otherwise) \
+    _Generic( (value),                                          \
+        bool: if_integer,                                       \
+        char: if_integer,                                       \
+        signed char: if_integer,                                \
+        unsigned char: if_integer,                              \
+        signed short: if_integer,                               \
+        unsigned short: if_integer,                             \
+        signed int: if_integer,                                 \
+        unsigned int: if_integer,                               \
+        signed long: if_integer,                                \
+        unsigned long: if_integer,                              \
+        signed long long: if_integer,                           \
+        unsigned long long: if_integer,                         \
+        default: otherwise                                      \
+    )
+
+#endif // SGL_DETAIL_SELECT_INTEGER_H_
@@ -39,9 +39,14 @@
  * The default sgl_exception is not meant to be thrown nor printed.
  * It only exists so that it can be used to catch any exception in
  * a catch block.
+ *
+ * sgl_no_exception can not be thrown either: it is returned by the
+ * functions which report errors with a return value instead of
+ * throwing, such as sgl_try_push_back, when they succeed.
  */
 typedef enum
 {
+    sgl_no_exception = -2,
     sgl_exception = -1,
     sgl_logic_error,
     sgl_domain_error,
@@ -69,17 +74,59 @@ typedef enum
 
 #endif
 
+/**
+ * @def SGL_FAST_EXCEPTIONS
+ *
+ * When defined with the compiler option -DSGL_FAST_EXCEPTIONS,
+ * sgl_try and sgl_throw use __builtin_setjmp and __builtin_longjmp
+ * instead of setjmp and longjmp with the compilers which support
+ * them. These builtins only save the frame pointer, the stack
+ * pointer and the resume address, and let the compiler spill the
+ * other registers it actually uses, which makes entering a try
+ * block much cheaper. The signal mask is never saved. The whole
+ * program, including src/exception.c, must be compiled with the
+ * same setting; mixing them fails at link time. Other compilers
+ * silently use the portable functions.
+ */
+
+////////////////////////////////////////////////////////////
+// Jump buffers
+
+#if defined(SGL_FAST_EXCEPTIONS) && defined(__GNUC__)
+
+    // Frame pointer, resume address, stack pointer and two
+    // target-specific words
+    typedef void* sgl_detail_jmp_buf[5];
+
+    #define sgl_detail_setjmp(env) __builtin_setjmp(env)
+    #define sgl_detail_longjmp(env) __builtin_longjmp(env, 1)
+
+    // Different symbol than the one used with jmp_buf
+    #define sgl_detail_buf_array sgl_detail_fast_buf_array
+
+#else
+
+    typedef jmp_buf sgl_detail_jmp_buf;
+
+    #define sgl_detail_setjmp(env) setjmp(env)
+    #define sgl_detail_longjmp(env) longjmp(env, 1)
+
+#endif
+
 ////////////////////////////////////////////////////////////
 // Global implementation variables
 
-// Global array of jmp_buf
-extern jmp_buf sgl_detail_buf_array[SGL_MAX_EXCEPTIONS];
+// Every thread has its own exception state: an exception thrown in
+// a thread is caught by the innermost try block of that thread
+
+// Array of jmp_buf of the current thread
+extern _Thread_local sgl_detail_jmp_buf sgl_detail_buf_array[SGL_MAX_EXCEPTIONS];
 
 // Current exception index
-extern int sgl_detail_exceptions_index;
+extern _Thread_local int sgl_detail_exceptions_index;
 
 // Current exception
-extern sgl_exception_t sgl_detail_current_exception;
+extern _Thread_local sgl_exception_t sgl_detail_current_exception;
 
 ////////////////////////////////////////////////////////////
 // Exception handling functions
@@ -114,12 +161,22 @@ const char* sgl_what(sgl_exception_t exception);
 /**
  * @def sgl_try
  *
- * Beginning of an exception try bloc.
+ * Beginning of an exception try bloc. Entering a try bloc when
+ * SGL_MAX_EXCEPTIONS of them are already nested does not overflow
+ * the jump buffers but throws sgl_length_error to the innermost
+ * enclosing try bloc instead. Like with setjmp, the local variables
+ * modified in a try bloc and read after an exception was thrown
+ * must be volatile.
  */
-#define sgl_try                                                             \
-    do {                                                                    \
-        ++sgl_detail_exceptions_index;                                      \
-        if (not setjmp(sgl_detail_buf_array[sgl_detail_exceptions_index]))  \
+#define sgl_try                                                                        \
+    do {                                                                               \
+        volatile bool sgl_detail_caught = false;                                       \
+        if (sgl_detail_exceptions_index == SGL_MAX_EXCEPTIONS - 1)                     \
+        {                                                                              \
+            sgl_throw(sgl_length_error);                                               \
+        }                                                                              \
+        ++sgl_detail_exceptions_index;                                                 \
+        if (not sgl_detail_setjmp(sgl_detail_buf_array[sgl_detail_exceptions_index]))  \
         {
 
 /**
@@ -132,6 +189,7 @@ const char* sgl_what(sgl_exception_t exception);
         }                                                                               \
         else if (sgl_exception_inherits_from(sgl_detail_current_exception, exception))  \
         {                                                                               \
+            sgl_detail_caught = true;                                                   \
             --sgl_detail_exceptions_index;
 
 /**
@@ -155,7 +213,10 @@ const char* sgl_what(sgl_exception_t exception);
                 sgl_terminate();                    \
             }                                       \
         }                                           \
-        --sgl_detail_exceptions_index;              \
+        if (not sgl_detail_caught)                  \
+        {                                           \
+            --sgl_detail_exceptions_index;          \
+        }                                           \
     } while (0);
 
 ////////////////////////////////////////////////////////////
@@ -185,7 +246,8 @@ sgl_terminate_handler sgl_set_terminate(sgl_terminate_handler new_handler);
 /**
  * Calls the current termination handler. The default one
  * calls abort. This function is called when an exception
- * is thrown and not caught.
+ * is thrown and not caught by the throwing thread. The
+ * handler is shared by every thread.
  */
 noreturn void sgl_terminate();
 
@@ -0,0 +1,199 @@
+/*
+ * Copyright (C) 2015 Morwenn
+ *
+ * The SGL is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * The SGL is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program. If not,
+ * see <http://www.gnu.org/licenses/>.
+ */
+#ifndef SGL_HASH_H_
+#define SGL_HASH_H_
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <stdint.h>
+#include <string.h>
+#include <sgl/detail/common.h>
+#include <sgl/detail/select_integer.h>
+
+////////////////////////////////////////////////////////////
+// Mixing functions
+
+// Replaces lhs and rhs by the low and high halves of their product
+static inline void sgl_detail_hash_multiply(uint64_t* lhs, uint64_t* rhs)
+{
+#ifdef __SIZEOF_INT128__
+    __uint128_t res = (__uint128_t) *lhs * *rhs;
+    *lhs = (uint64_t) res;
+    *rhs = (uint64_t) (res >> 64);
+#else
+    uint64_t lhs_hi = *lhs >> 32, lhs_lo = (uint32_t) *lhs;
+    uint64_t rhs_hi = *rhs >> 32, rhs_lo = (uint32_t) *rhs;
+    uint64_t hi_hi = lhs_hi * rhs_hi, hi_lo = lhs_hi * rhs_lo;
+    uint64_t lo_hi = lhs_lo * rhs_hi, lo_lo = lhs_lo * rhs_lo;
+    uint64_t mid = (lo_lo >> 32) + (uint32_t) hi_lo + (uint32_t) lo_hi;
+    *lhs = (mid << 32) | (uint32_t) lo_lo;
+    *rhs = hi_hi + (hi_lo >> 32) + (lo_hi >> 32) + (mid >> 32);
+#endif
+}
+
+// Multiplies two 64-bit integers and folds the 128-bit result
+static inline uint64_t sgl_detail_hash_mix(uint64_t lhs, uint64_t rhs)
+{
+    sgl_detail_hash_multiply(&lhs, &rhs);
+    return lhs ^ rhs;
+}
+
+////////////////////////////////////////////////////////////
+// Hash functions
+
+/**
+ * Hashes an integer. Every input bit affects every output bit,
+ * so the low bits of the result can directly index a table.
+ */
+static inline size_t sgl_hash_integer_seeded(uint64_t value, uint64_t seed)
+{
+    value ^= seed ^ UINT64_C(0x2d358dccaa6c78a5);
+    uint64_t hash = sgl_detail_hash_mix(value, seed ^ UINT64_C(0x8bb84b93962eacc9));
+    return (size_t) sgl_detail_hash_mix(hash ^ UINT64_C(0x4b33a62ed433d4a3),
+                                        UINT64_C(0x4d5a2da51de1aa47));
+}
+
+static inline size_t sgl_hash_integer(uint64_t value)
+{
+    return sgl_hash_integer_seeded(value, 0);
+}
+
+/**
+ * Hashes size bytes with a function of the wyhash family, which
+ * reads 8 or 16 bytes at a time and hashes short keys without a
+ * loop. A secret seed makes the hash values unpredictable, which
+ * protects hash tables filled with untrusted keys from flooding.
+ */
+size_t sgl_hash_bytes_seeded(const void* data, size_t size, uint64_t seed);
+
+static inline size_t sgl_hash_bytes(const void* data, size_t size)
+{
+    return sgl_hash_bytes_seeded(data, size, 0);
+}
+
+/**
+ * Hashes the characters of a null-terminated string.
+ */
+static inline size_t sgl_hash_string_seeded(const char* str, uint64_t seed)
+{
+    return sgl_hash_bytes_seeded(str, strlen(str), seed);
+}
+
+static inline size_t sgl_hash_string(const char* str)
+{
+    return sgl_hash_string_seeded(str, 0);
+}
+
+// Floating point values equal to zero hash the same
+static inline size_t sgl_detail_hash_float_seeded(float value, uint64_t seed)
+{
+    uint32_t bits = 0;
+    if (value != 0.0f)
+    {
+        memcpy(&bits, &value, sizeof bits);
+    }
+    return sgl_hash_integer_seeded(bits, seed);
+}
+
+static inline size_t sgl_detail_hash_double_seeded(double value, uint64_t seed)
+{
+    uint64_t bits = 0;
+    if (value != 0.0)
+    {
+        memcpy(&bits, &value, sizeof bits);
+    }
+    return sgl_hash_integer_seeded(bits, seed);
+}
+
+static inline size_t sgl_detail_hash_pointer_seeded(const void* ptr, uint64_t seed)
+{
+    return sgl_hash_integer_seeded((uintptr_t) ptr, seed);
+}
+
+////////////////////////////////////////////////////////////
+// Generic hash
+
+/**
+ * @def sgl_hash_seeded(value, seed)
+ *
+ * Hashes a value of a scalar type with the given seed. Integers
+ * and floating point values are mixed, strings (char pointers) are
+ * hashed by content and other pointers by address. The contents of
+ * a contiguous collection such as sgl_vector can be hashed with
+ * sgl_hash_range(sgl_cbegin(vec), sgl_cend(vec)).
+ */
+#define sgl_hash_seeded(value, seed)                            \
+    _Generic( (value),                                          \
+        float: sgl_detail_hash_float_seeded,                    \
+        double: sgl_detail_hash_double_seeded,                  \
+        char*: sgl_hash_string_seeded,                          \
+        const char*: sgl_hash_string_seeded,                    \
+        default: sgl_detail_select_integer( (value),            \
+            sgl_hash_integer_seeded,                            \
+            sgl_detail_hash_pointer_seeded                      \
+        )                                                       \
+    )(value, seed)
+
+/**
+ * @def sgl_hash(value)
+ *
+ * Same as sgl_hash_seeded with a seed of 0.
+ */
+#define sgl_hash(value) \
+    sgl_hash_seeded(value, 0)
+
+/**
+ * @def sgl_hash_range(first, last)
+ *
+ * Hashes the bytes of the contiguous range [first, last).
+ */
+#define sgl_hash_range(first, last) \
+    sgl_hash_bytes(first, (const char*) (last) - (const char*) (first))
+
+////////////////////////////////////////////////////////////
+// Hash of objects
+
+// Note: these functions are used by the hash tables, whose keys
+//       are compared bytewise by default. Integers are hashed
+//       with the integer mixer and other objects bytewise.
+
+static inline size_t sgl_detail_hash_integer_at(const void* ptr, size_t size)
+{
+    if (size <= sizeof(uint64_t))
+    {
+        uint64_t value = 0;
+        memcpy(&value, ptr, size);
+        return sgl_hash_integer(value);
+    }
+    return sgl_hash_bytes(ptr, size);
+}
+
+/**
+ * @def sgl_hash_object(ptr)
+ *
+ * Hashes the object pointed to by ptr, consistently with a bytewise
+ * comparison of objects of its type.
+ */
+#define sgl_hash_object(ptr)                        \
+    sgl_detail_select_integer( *(ptr),              \
+        sgl_detail_hash_integer_at,                 \
+        sgl_hash_bytes                              \
+    )(ptr, sizeof *(ptr))
+
+#endif // SGL_HASH_H_
@@ -0,0 +1,52 @@
+/*
+ * Copyright (C) 2015 Morwenn
+ *
+ * The SGL is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * The SGL is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program. If not,
+ * see <http://www.gnu.org/licenses/>.
+ */
+#ifndef SGL_MEMORY_ALIGNMENT_H_
+#define SGL_MEMORY_ALIGNMENT_H_
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <sgl/detail/common.h>
+#include <sgl/utility/paste.h>
+
+#ifndef SGL_CACHE_LINE_SIZE
+
+    /**
+     * @def SGL_CACHE_LINE_SIZE
+     *
+     * Size in bytes of a cache line, used to keep the members of
+     * concurrent structures written by different threads apart and
+     * avoid false sharing. It can be set with the compiler option
+     * -DSGL_CACHE_LINE_SIZE=size.
+     */
+    #define SGL_CACHE_LINE_SIZE 64
+
+#endif
+
+/**
+ * @def sgl_alignment(type)
+ *
+ * Integer constant expression giving the alignment of the storage
+ * of the given collection type. For example, the data of every
+ * sgl_aligned_vector(float, 32) is aligned on 32 bytes, which can
+ * be told to the compiler with __builtin_assume_aligned.
+ */
+#define sgl_alignment(type) \
+    sgl_paste(type, _alignment)
+
+#endif // SGL_MEMORY_ALIGNMENT_H_
@@ -0,0 +1,112 @@
+/*
+ * Copyright (C) 2015 Morwenn
+ *
+ * The SGL is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * The SGL is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program. If not,
+ * see <http://www.gnu.org/licenses/>.
+ */
+#ifndef SGL_MEMORY_ALLOCATOR_H_
+#define SGL_MEMORY_ALLOCATOR_H_
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <stdlib.h>
+#include <string.h>
+#include <sgl/detail/common.h>
+
+/**
+ * @brief Memory allocator interface.
+ *
+ * An allocator is a set of functions and a context pointer which
+ * is passed back to them. Containers use them to manage memory
+ * instead of malloc, realloc and free. The sizes passed to
+ * reallocate and deallocate are those used to allocate the memory
+ * block, and alignment is a power of 2. All of the functions shall
+ * accept NULL pointers and allocate and reallocate shall return
+ * NULL when they fail.
+ *
+ * Containers store a pointer to their allocator, which must
+ * outlive them. A NULL allocator stands for the default one,
+ * which directly calls the standard library functions.
+ */
+typedef struct
+{
+    void* (*allocate)(void* context, size_t size, size_t alignment);
+    void* (*reallocate)(void* context, void* ptr, size_t old_size,
+                        size_t new_size, size_t alignment);
+    void (*deallocate)(void* context, void* ptr, size_t size);
+    void* context;
+} sgl_allocator;
+
+////////////////////////////////////////////////////////////
+// Allocation functions used by the containers
+
+// Note: the default allocator is handled directly in these
+//       functions so that it does not cost an indirect call.
+
+static inline void* sgl_detail_allocate(const sgl_allocator* allocator,
+                                        size_t size, size_t alignment)
+{
+    if (allocator != NULL)
+    {
+        return allocator->allocate(allocator->context, size, alignment);
+    }
+    if (alignment <= alignof(max_align_t))
+    {
+        return malloc(size);
+    }
+    // aligned_alloc wants a multiple of the alignment
+    size_t padded_size = (size + alignment - 1) & ~(alignment - 1);
+    if (padded_size < size)
+    {
+        return NULL;
+    }
+    return aligned_alloc(alignment, padded_size);
+}
+
+static inline void sgl_detail_deallocate(const sgl_allocator* allocator,
+                                         void* ptr, size_t size)
+{
+    if (allocator != NULL)
+    {
+        allocator->deallocate(allocator->context, ptr, size);
+        return;
+    }
+    free(ptr);
+}
+
+static inline void* sgl_detail_reallocate(const sgl_allocator* allocator,
+                                          void* ptr, size_t old_size,
+                                          size_t new_size, size_t alignment)
+{
+    if (allocator != NULL)
+    {
+        return allocator->reallocate(allocator->context, ptr, old_size,
+                                     new_size, alignment);
+    }
+    if (alignment <= alignof(max_align_t))
+    {
+        return realloc(ptr, new_size);
+    }
+    // realloc does not preserve extended alignments
+    void* res = sgl_detail_allocate(NULL, new_size, alignment);
+    if (res != NULL && ptr != NULL)
+    {
+        memcpy(res, ptr, old_size < new_size ? old_size : new_size);
+        free(ptr);
+    }
+    return res;
+}
+
+#endif // SGL_MEMORY_ALLOCATOR_H_
@@ -0,0 +1,141 @@
+/*
+ * Copyright (C) 2015 Morwenn
+ *
+ * The SGL is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * The SGL is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program. If not,
+ * see <http://www.gnu.org/licenses/>.
+ */
+#ifndef SGL_MEMORY_ARENA_H_
+#define SGL_MEMORY_ARENA_H_
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <stdint.h>
+#include <sgl/exception.h>
+#include <sgl/memory/allocator.h>
+#include <sgl/detail/common.h>
+
+////////////////////////////////////////////////////////////
+// Types
+
+// Memory chunk, defined in arena.c
+typedef struct sgl_detail_arena_chunk sgl_detail_arena_chunk;
+
+/**
+ * @brief Region-based allocator.
+ *
+ * An arena hands out memory from big chunks by bumping a pointer
+ * and frees everything at once when it is reset or destroyed.
+ * Individual deallocations are not needed and mostly ignored.
+ * Chunks are kept between resets so that an arena used for
+ * request-scoped allocations stops calling malloc once it has
+ * grown to the size of the biggest request.
+ *
+ * Containers can allocate their memory from an arena through the
+ * sgl_allocator returned by sgl_arena_allocator.
+ */
+typedef struct
+{
+    char* _ptr;
+    char* _end;
+    sgl_detail_arena_chunk* _current;
+    sgl_detail_arena_chunk* _first;
+    size_t _chunk_size;
+    sgl_allocator _allocator;
+} sgl_arena;
+
+/**
+ * @brief Position in an arena.
+ *
+ * Everything allocated after a mark has been taken can be freed
+ * at once by rewinding the arena to the mark.
+ */
+typedef struct
+{
+    char* _ptr;
+    sgl_detail_arena_chunk* _chunk;
+} sgl_arena_mark;
+
+////////////////////////////////////////////////////////////
+// Functions
+
+/**
+ * Initializes an empty arena which will allocate chunks of at
+ * least chunk_size bytes. No memory is allocated before the
+ * first allocation.
+ */
+void sgl_arena_init(sgl_arena* arena, size_t chunk_size);
+
+/**
+ * Frees every chunk of the arena.
+ */
+void sgl_arena_destroy(sgl_arena* arena);
+
+/**
+ * Frees everything allocated from the arena in O(1). The chunks
+ * are kept to serve the next allocations.
+ */
+void sgl_arena_reset(sgl_arena* arena);
+
+/**
+ * Returns the current position of the arena.
+ */
+sgl_arena_mark sgl_arena_save(const sgl_arena* arena);
+
+/**
+ * Frees everything allocated since the given mark was taken.
+ * Marks taken after this one are invalidated.
+ */
+void sgl_arena_rewind(sgl_arena* arena, sgl_arena_mark mark);
+
+/**
+ * Returns an allocator getting its memory from the arena, which
+ * can be given to sgl_new_with_allocator. The last allocated block
+ * is grown and freed in place, the other deallocations are no-ops.
+ */
+const sgl_allocator* sgl_arena_allocator(sgl_arena* arena);
+
+// Allocates from a new chunk, returns NULL on failure
+void* sgl_detail_arena_allocate_slow(sgl_arena* arena,
+                                     size_t size, size_t alignment);
+
+/**
+ * Allocates size bytes aligned on alignment, which must be a
+ * power of 2, from the arena. Throws sgl_bad_alloc on failure.
+ * Like the other allocations, a zero-size allocation returns a
+ * non-null pointer.
+ */
+static inline void* sgl_arena_allocate(sgl_arena* arena,
+                                       size_t size, size_t alignment)
+{
+    uintptr_t mask = alignment - 1;
+    uintptr_t ptr = ((uintptr_t) arena->_ptr + mask) & ~mask;
+    uintptr_t end = (uintptr_t) arena->_end;
+    // An arena without current chunk has null pointers, which
+    // would otherwise fit a zero-size allocation
+    if (ptr != 0 && ptr <= end && size <= end - ptr)
+    {
+        arena->_ptr = (char*) ptr + size;
+        return (void*) ptr;
+    }
+
+    void* res = sgl_detail_arena_allocate_slow(arena, size, alignment);
+    if (res == NULL)
+    {
+        sgl_throw(sgl_bad_alloc);
+    }
+    return res;
+}
+
+#endif // SGL_MEMORY_ARENA_H_
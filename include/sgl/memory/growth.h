@@ -0,0 +1,85 @@
+/*
+ * Copyright (C) 2015 Morwenn
+ *
+ * The SGL is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * The SGL is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program. If not,
+ * see <http://www.gnu.org/licenses/>.
+ */
+#ifndef SGL_MEMORY_GROWTH_H_
+#define SGL_MEMORY_GROWTH_H_
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <stdint.h>
+#include <sgl/detail/common.h>
+#include <sgl/utility/paste.h>
+
+/**
+ * Type of the functions used by growable collections to compute
+ * their new capacity when they run out of space. A growth policy
+ * takes the current capacity and the minimal required capacity,
+ * and returns a new capacity at least equal to the required one.
+ */
+typedef size_t (*sgl_growth_policy)(size_t capacity, size_t min_capacity);
+
+/**
+ * Grows the capacity by a fixed amount of 40 elements. Filling
+ * a collection with this policy has a quadratic complexity; it
+ * only exists for comparison purposes.
+ */
+static inline size_t sgl_growth_linear(size_t capacity, size_t min_capacity)
+{
+    size_t new_cap = capacity > SIZE_MAX - 40 ? SIZE_MAX : capacity + 40;
+    return new_cap < min_capacity ? min_capacity : new_cap;
+}
+
+/**
+ * Multiplies the capacity by 1.5, which allows the memory freed
+ * by previous allocations to be reused by later ones.
+ */
+static inline size_t sgl_growth_factor_1_5(size_t capacity, size_t min_capacity)
+{
+    size_t new_cap = capacity > SIZE_MAX - capacity / 2 ? SIZE_MAX
+                                                        : capacity + capacity / 2;
+    return new_cap < min_capacity ? min_capacity : new_cap;
+}
+
+/**
+ * Doubles the capacity.
+ */
+static inline size_t sgl_growth_factor_2(size_t capacity, size_t min_capacity)
+{
+    size_t new_cap = capacity > SIZE_MAX / 2 ? SIZE_MAX : capacity * 2;
+    return new_cap < min_capacity ? min_capacity : new_cap;
+}
+
+/**
+ * @def sgl_get_growth_policy(type)
+ *
+ * Returns the growth policy currently used by the given type.
+ */
+#define sgl_get_growth_policy(type) \
+    sgl_paste(type, _get_growth_policy)()
+
+/**
+ * @def sgl_set_growth_policy(type, policy)
+ *
+ * Sets the growth policy used by every instance of the given
+ * type and returns the old one. If \a policy is NULL, the policy
+ * chosen when the type was defined is restored.
+ */
+#define sgl_set_growth_policy(type, policy) \
+    sgl_paste(type, _set_growth_policy)(policy)
+
+#endif // SGL_MEMORY_GROWTH_H_
@@ -0,0 +1,480 @@
+/*
+ * Copyright (C) 2015 Morwenn
+ *
+ * The SGL is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * The SGL is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program. If not,
+ * see <http://www.gnu.org/licenses/>.
+ */
+#ifndef SGL_MPMC_QUEUE_H_
+#define SGL_MPMC_QUEUE_H_
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <stdatomic.h>
+#include <stdint.h>
+#include <threads.h>
+#include <sgl/collection.h>
+#include <sgl/exception.h>
+#include <sgl/memory/alignment.h>
+#include <sgl/memory/allocator.h>
+#include <sgl/detail/common.h>
+
+#ifndef SGL_MPMC_QUEUE_CAPACITY
+
+    /**
+     * @def SGL_MPMC_QUEUE_CAPACITY
+     *
+     * Capacity of the sgl_mpmc_queue types when none is given to
+     * the constructor. It can be set with the compiler option
+     * -DSGL_MPMC_QUEUE_CAPACITY=size.
+     */
+    #define SGL_MPMC_QUEUE_CAPACITY 1024
+
+#endif
+
+// Called by the blocking operations each time they fail: spins a
+// few times, then gives the processor to another thread
+static inline void sgl_detail_mpmc_queue_backoff(unsigned* attempt)
+{
+    if (++*attempt > 64)
+    {
+        thrd_yield();
+    }
+}
+
+/**
+ * @def sgl_mpmc_queue(T)
+ *
+ * Alias for the sgl_mpmc_queue_T type.
+ */
+#define sgl_mpmc_queue(T) \
+    sgl_mpmc_queue_##T
+
+/**
+ * @def sgl_define_sgl_mpmc_queue(T)
+ * Creates all the methods for a sgl_mpmc_queue of given type.
+ */
+#define sgl_define_sgl_mpmc_queue(T)                                                \
+    sgl_declare_sgl_mpmc_queue(T)                                                   \
+    sgl_instantiate_sgl_mpmc_queue(T)
+
+/**
+ * @def sgl_declare_sgl_mpmc_queue(T)
+ * Declares the type and the methods of a sgl_mpmc_queue of given
+ * type. It is a bounded lock-free queue which any number of threads
+ * can push to and pop from. The capacity is rounded up to a power
+ * of 2 and never changes.
+ *
+ * Every slot holds a sequence number telling whether it is ready
+ * to be written or read for a given turn of the ring, so producers
+ * and consumers only contend on their own index, with one
+ * compare-and-swap per operation or per batch. sgl_try_push and
+ * sgl_try_pop fail when the queue is full or empty, while sgl_push
+ * and sgl_pop wait. sgl_size is only a snapshot, and it always
+ * goes through the function table, even with SGL_STATIC_DISPATCH.
+ */
+#define sgl_declare_sgl_mpmc_queue(T)                                               \
+                                                                                    \
+    typedef struct sgl_detail_mpmc_queue_##T sgl_mpmc_queue(T);                     \
+                                                                                    \
+    typedef T sgl_mpmc_queue_##T##_value_type;                                      \
+    typedef size_t sgl_mpmc_queue_##T##_size_type;                                  \
+                                                                                    \
+    typedef struct                                                                  \
+    {                                                                               \
+        atomic_size_t _sequence;                                                    \
+        T _value;                                                                   \
+    } sgl_detail_mpmc_queue_slot_##T;                                               \
+                                                                                    \
+    typedef struct                                                                  \
+    {                                                                               \
+        void (*delete)(sgl_mpmc_queue(T)*);                                         \
+        void (*destroy)(sgl_mpmc_queue(T)*);                                        \
+        bool (*is_empty)(const sgl_mpmc_queue(T)*);                                 \
+        size_t (*size)(const sgl_mpmc_queue(T)*);                                   \
+        size_t (*capacity)(const sgl_mpmc_queue(T)*);                               \
+        bool (*try_push)(sgl_mpmc_queue(T)*, T);                                    \
+        bool (*try_pop)(sgl_mpmc_queue(T)*, T*);                                    \
+        void (*push)(sgl_mpmc_queue(T)*, T);                                        \
+        void (*pop)(sgl_mpmc_queue(T)*, T*);                                        \
+        size_t (*push_n)(sgl_mpmc_queue(T)*, const T*, size_t);                     \
+        size_t (*pop_n)(sgl_mpmc_queue(T)*, T*, size_t);                            \
+        sgl_detail_opaque_layout _layout;                                           \
+    } sgl_detail_mpmc_queue_functions_##T;                                          \
+                                                                                    \
+    struct sgl_detail_mpmc_queue_##T                                                \
+    {                                                                               \
+        alignas(SGL_CACHE_LINE_SIZE) atomic_size_t _tail;                           \
+        alignas(SGL_CACHE_LINE_SIZE) atomic_size_t _head;                           \
+        /* Never written after the initialization */                                \
+        alignas(SGL_CACHE_LINE_SIZE) sgl_detail_mpmc_queue_slot_##T* _slots;        \
+        size_t _mask;                                                               \
+        const sgl_allocator* _allocator;                                            \
+        const sgl_detail_mpmc_queue_functions_##T* _functions;                      \
+    };                                                                              \
+                                                                                    \
+sgl_mpmc_queue(T)* sgl_new_sgl_mpmc_queue_##T();                                    \
+sgl_mpmc_queue(T)* sgl_new_with_capacity_sgl_mpmc_queue_##T(size_t);                \
+sgl_mpmc_queue(T)* sgl_new_with_allocator_sgl_mpmc_queue_##T(const sgl_allocator*); \
+void sgl_init_sgl_mpmc_queue_##T(sgl_mpmc_queue(T)*);                               \
+void sgl_init_with_allocator_sgl_mpmc_queue_##T(sgl_mpmc_queue(T)*,                 \
+                                                const sgl_allocator*);              \
+void sgl_mpmc_queue_delete_##T(sgl_mpmc_queue(T)*);                                 \
+void sgl_mpmc_queue_destroy_##T(sgl_mpmc_queue(T)*);                                \
+bool sgl_mpmc_queue_is_empty_##T(const sgl_mpmc_queue(T)*);                         \
+size_t sgl_mpmc_queue_size_##T(const sgl_mpmc_queue(T)*);                           \
+size_t sgl_mpmc_queue_capacity_##T(const sgl_mpmc_queue(T)*);                       \
+bool sgl_mpmc_queue_try_push_##T(sgl_mpmc_queue(T)*, T);                            \
+bool sgl_mpmc_queue_try_pop_##T(sgl_mpmc_queue(T)*, T*);                            \
+void sgl_mpmc_queue_push_##T(sgl_mpmc_queue(T)*, T);                                \
+void sgl_mpmc_queue_pop_##T(sgl_mpmc_queue(T)*, T*);                                \
+size_t sgl_mpmc_queue_push_n_##T(sgl_mpmc_queue(T)*, const T*, size_t);             \
+size_t sgl_mpmc_queue_pop_n_##T(sgl_mpmc_queue(T)*, T*, size_t);                    \
+                                                                                    \
+extern const sgl_detail_mpmc_queue_functions_##T sgl_detail_mpmc_queue_funcs_##T;
+
+/**
+ * @def sgl_instantiate_sgl_mpmc_queue(T)
+ * Defines the methods of a sgl_mpmc_queue of given type, which
+ * must have been declared beforehand. It shall appear in exactly
+ * one translation unit.
+ */
+#define sgl_instantiate_sgl_mpmc_queue(T)                                           \
+                                                                                    \
+void sgl_mpmc_queue_delete_##T(sgl_mpmc_queue(T)* queue)                            \
+{                                                                                   \
+    sgl_mpmc_queue_destroy_##T(queue);                                              \
+    sgl_detail_deallocate(queue->_allocator, queue, sizeof(sgl_mpmc_queue(T)));     \
+}                                                                                   \
+                                                                                    \
+void sgl_mpmc_queue_destroy_##T(sgl_mpmc_queue(T)* queue)                           \
+{                                                                                   \
+    sgl_detail_deallocate(queue->_allocator, queue->_slots,                         \
+                          (queue->_mask + 1)                                        \
+                          * sizeof(sgl_detail_mpmc_queue_slot_##T));                \
+    queue->_slots = NULL;                                                           \
+}                                                                                   \
+                                                                                    \
+bool sgl_mpmc_queue_is_empty_##T(const sgl_mpmc_queue(T)* queue)                    \
+{                                                                                   \
+    return sgl_mpmc_queue_size_##T(queue) == 0;                                     \
+}                                                                                   \
+                                                                                    \
+size_t sgl_mpmc_queue_size_##T(const sgl_mpmc_queue(T)* queue)                      \
+{                                                                                   \
+    sgl_mpmc_queue(T)* q = (sgl_mpmc_queue(T)*) queue;                              \
+    size_t head = atomic_load_explicit(&q->_head, memory_order_acquire);            \
+    size_t tail = atomic_load_explicit(&q->_tail, memory_order_acquire);            \
+    /* Both indexes may move between the loads */                                   \
+    size_t size = (ptrdiff_t) (tail - head) > 0 ? tail - head : 0;                  \
+    return size > q->_mask + 1 ? q->_mask + 1 : size;                               \
+}                                                                                   \
+                                                                                    \
+size_t sgl_mpmc_queue_capacity_##T(const sgl_mpmc_queue(T)* queue)                  \
+{                                                                                   \
+    return queue->_mask + 1;                                                        \
+}                                                                                   \
+                                                                                    \
+bool sgl_mpmc_queue_try_push_##T(sgl_mpmc_queue(T)* queue, T value)                 \
+{                                                                                   \
+    sgl_detail_mpmc_queue_slot_##T* slot;                                           \
+    size_t pos = atomic_load_explicit(&queue->_tail, memory_order_relaxed);         \
+    for (;;)                                                                        \
+    {                                                                               \
+        slot = queue->_slots + (pos & queue->_mask);                                \
+        size_t seq = atomic_load_explicit(&slot->_sequence, memory_order_acquire);  \
+        ptrdiff_t diff = (ptrdiff_t) (seq - pos);                                   \
+        if (diff == 0)                                                              \
+        {                                                                           \
+            /* The slot is free for this turn, try to claim it */                   \
+            if (atomic_compare_exchange_weak_explicit(&queue->_tail, &pos, pos + 1, \
+                                                      memory_order_relaxed,         \
+                                                      memory_order_relaxed))        \
+            {                                                                       \
+                break;                                                              \
+            }                                                                       \
+        }                                                                           \
+        else if (diff < 0)                                                          \
+        {                                                                           \
+            /* The slot still holds the value of the previous turn */               \
+            return false;                                                           \
+        }                                                                           \
+        else                                                                        \
+        {                                                                           \
+            pos = atomic_load_explicit(&queue->_tail, memory_order_relaxed);        \
+        }                                                                           \
+    }                                                                               \
+    slot->_value = value;                                                           \
+    atomic_store_explicit(&slot->_sequence, pos + 1, memory_order_release);         \
+    return true;                                                                    \
+}                                                                                   \
+                                                                                    \
+bool sgl_mpmc_queue_try_pop_##T(sgl_mpmc_queue(T)* queue, T* out)                   \
+{                                                                                   \
+    sgl_detail_mpmc_queue_slot_##T* slot;                                           \
+    size_t pos = atomic_load_explicit(&queue->_head, memory_order_relaxed);         \
+    for (;;)                                                                        \
+    {                                                                               \
+        slot = queue->_slots + (pos & queue->_mask);                                \
+        size_t seq = atomic_load_explicit(&slot->_sequence, memory_order_acquire);  \
+        ptrdiff_t diff = (ptrdiff_t) (seq - (pos + 1));                             \
+        if (diff == 0)                                                              \
+        {                                                                           \
+            if (atomic_compare_exchange_weak_explicit(&queue->_head, &pos, pos + 1, \
+                                                      memory_order_relaxed,         \
+                                                      memory_order_relaxed))        \
+            {                                                                       \
+                break;                                                              \
+            }                                                                       \
+        }                                                                           \
+        else if (diff < 0)                                                          \
+        {                                                                           \
+            /* The slot has not been written for this turn yet */                   \
+            return false;                                                           \
+        }                                                                           \
+        else                                                                        \
+        {                                                                           \
+            pos = atomic_load_explicit(&queue->_head, memory_order_relaxed);        \
+        }                                                                           \
+    }                                                                               \
+    *out = slot->_value;                                                            \
+    /* Makes the slot ready for the producers of the next turn */                   \
+    atomic_store_explicit(&slot->_sequence, pos + queue->_mask + 1,                 \
+                          memory_order_release);                                    \
+    return true;                                                                    \
+}                                                                                   \
+                                                                                    \
+void sgl_mpmc_queue_push_##T(sgl_mpmc_queue(T)* queue, T value)                     \
+{                                                                                   \
+    unsigned attempt = 0;                                                           \
+    while (not sgl_mpmc_queue_try_push_##T(queue, value))                           \
+    {                                                                               \
+        sgl_detail_mpmc_queue_backoff(&attempt);                                    \
+    }                                                                               \
+}                                                                                   \
+                                                                                    \
+void sgl_mpmc_queue_pop_##T(sgl_mpmc_queue(T)* queue, T* out)                       \
+{                                                                                   \
+    unsigned attempt = 0;                                                           \
+    while (not sgl_mpmc_queue_try_pop_##T(queue, out))                              \
+    {                                                                               \
+        sgl_detail_mpmc_queue_backoff(&attempt);                                    \
+    }                                                                               \
+}                                                                                   \
+                                                                                    \
+size_t sgl_mpmc_queue_push_n_##T(sgl_mpmc_queue(T)* queue,                          \
+                                  const T* values, size_t count)                    \
+{                                                                                   \
+    size_t pos = atomic_load_explicit(&queue->_tail, memory_order_relaxed);         \
+    size_t ready;                                                                   \
+    for (;;)                                                                        \
+    {                                                                               \
+        /* Count the consecutive slots free for this turn */                        \
+        ready = 0;                                                                  \
+        while (ready < count)                                                       \
+        {                                                                           \
+            size_t seq = atomic_load_explicit(                                      \
+                &queue->_slots[(pos + ready) & queue->_mask]._sequence,             \
+                memory_order_acquire);                                              \
+            if (seq != pos + ready)                                                 \
+            {                                                                       \
+                break;                                                              \
+            }                                                                       \
+            ++ready;                                                                \
+        }                                                                           \
+        if (ready == 0)                                                             \
+        {                                                                           \
+            size_t seq = atomic_load_explicit(                                      \
+                &queue->_slots[pos & queue->_mask]._sequence,                       \
+                memory_order_relaxed);                                              \
+            if ((ptrdiff_t) (seq - pos) < 0)                                        \
+            {                                                                       \
+                return 0;                                                           \
+            }                                                                       \
+            pos = atomic_load_explicit(&queue->_tail, memory_order_relaxed);        \
+            continue;                                                               \
+        }                                                                           \
+        if (atomic_compare_exchange_weak_explicit(&queue->_tail, &pos, pos + ready, \
+                                                  memory_order_relaxed,             \
+                                                  memory_order_relaxed))            \
+        {                                                                           \
+            break;                                                                  \
+        }                                                                           \
+    }                                                                               \
+    for (size_t i = 0 ; i < ready ; ++i)                                            \
+    {                                                                               \
+        sgl_detail_mpmc_queue_slot_##T* slot =                                      \
+            queue->_slots + ((pos + i) & queue->_mask);                             \
+        slot->_value = values[i];                                                   \
+        atomic_store_explicit(&slot->_sequence, pos + i + 1, memory_order_release); \
+    }                                                                               \
+    return ready;                                                                   \
+}                                                                                   \
+                                                                                    \
+size_t sgl_mpmc_queue_pop_n_##T(sgl_mpmc_queue(T)* queue, T* out, size_t count)     \
+{                                                                                   \
+    size_t pos = atomic_load_explicit(&queue->_head, memory_order_relaxed);         \
+    size_t ready;                                                                   \
+    for (;;)                                                                        \
+    {                                                                               \
+        /* Count the consecutive slots written for this turn */                     \
+        ready = 0;                                                                  \
+        while (ready < count)                                                       \
+        {                                                                           \
+            size_t seq = atomic_load_explicit(                                      \
+                &queue->_slots[(pos + ready) & queue->_mask]._sequence,             \
+                memory_order_acquire);                                              \
+            if (seq != pos + ready + 1)                                             \
+            {                                                                       \
+                break;                                                              \
+            }                                                                       \
+            ++ready;                                                                \
+        }                                                                           \
+        if (ready == 0)                                                             \
+        {                                                                           \
+            size_t seq = atomic_load_explicit(                                      \
+                &queue->_slots[pos & queue->_mask]._sequence,                       \
+                memory_order_relaxed);                                              \
+            if ((ptrdiff_t) (seq - (pos + 1)) < 0)                                  \
+            {                                                                       \
+                return 0;                                                           \
+            }                                                                       \
+            pos = atomic_load_explicit(&queue->_head, memory_order_relaxed);        \
+            continue;                                                               \
+        }                                                                           \
+        if (atomic_compare_exchange_weak_explicit(&queue->_head, &pos, pos + ready, \
+                                                  memory_order_relaxed,             \
+                                                  memory_order_relaxed))            \
+        {                                                                           \
+            break;                                                                  \
+        }                                                                           \
+    }                                                                               \
+    for (size_t i = 0 ; i < ready ; ++i)                                            \
+    {                                                                               \
+        sgl_detail_mpmc_queue_slot_##T* slot =                                      \
+            queue->_slots + ((pos + i) & queue->_mask);                             \
+        out[i] = slot->_value;                                                      \
+        atomic_store_explicit(&slot->_sequence, pos + i + queue->_mask + 1,         \
+                              memory_order_release);                                \
+    }                                                                               \
+    return ready;                                                                   \
+}                                                                                   \
+                                                                                    \
+const sgl_detail_mpmc_queue_functions_##T sgl_detail_mpmc_queue_funcs_##T = {       \
+    &sgl_mpmc_queue_delete_##T,                                                     \
+    &sgl_mpmc_queue_destroy_##T,                                                    \
+    &sgl_mpmc_queue_is_empty_##T,                                                   \
+    &sgl_mpmc_queue_size_##T,                                                       \
+    &sgl_mpmc_queue_capacity_##T,                                                   \
+    &sgl_mpmc_queue_try_push_##T,                                                   \
+    &sgl_mpmc_queue_try_pop_##T,                                                    \
+    &sgl_mpmc_queue_push_##T,                                                       \
+    &sgl_mpmc_queue_pop_##T,                                                        \
+    &sgl_mpmc_queue_push_n_##T,                                                     \
+    &sgl_mpmc_queue_pop_n_##T,                                                      \
+    { 0 }                                                                           \
+};                                                                                  \
+                                                                                    \
+/* Allocates the slots for at least the given capacity, which is */                 \
+/* rounded up to a power of 2 and stored back into capacity */                      \
+static inline sgl_detail_mpmc_queue_slot_##T*                                       \
+sgl_detail_mpmc_queue_slots_##T(size_t* capacity, const sgl_allocator* allocator)   \
+{                                                                                   \
+    size_t size = 2;                                                                \
+    while (size < *capacity)                                                        \
+    {                                                                               \
+        if (size > SIZE_MAX / (2 * sizeof(sgl_detail_mpmc_queue_slot_##T)))         \
+        {                                                                           \
+            sgl_throw(sgl_length_error);                                            \
+        }                                                                           \
+        size *= 2;                                                                  \
+    }                                                                               \
+    sgl_detail_mpmc_queue_slot_##T* slots = sgl_detail_allocate(                    \
+        allocator,                                                                  \
+        size * sizeof(sgl_detail_mpmc_queue_slot_##T),                              \
+        alignof(sgl_detail_mpmc_queue_slot_##T));                                   \
+    if (not slots)                                                                  \
+    {                                                                               \
+        sgl_throw(sgl_bad_alloc);                                                   \
+    }                                                                               \
+    for (size_t i = 0 ; i < size ; ++i)                                             \
+    {                                                                               \
+        atomic_init(&slots[i]._sequence, i);                                        \
+    }                                                                               \
+    *capacity = size;                                                               \
+    return slots;                                                                   \
+}                                                                                   \
+                                                                                    \
+static inline void                                                                  \
+sgl_detail_init_mpmc_queue_##T(sgl_mpmc_queue(T)* queue,                            \
+                               sgl_detail_mpmc_queue_slot_##T* slots,               \
+                               size_t capacity, const sgl_allocator* allocator)     \
+{                                                                                   \
+    queue->_functions = &sgl_detail_mpmc_queue_funcs_##T;                           \
+    queue->_allocator = allocator;                                                  \
+    queue->_slots = slots;                                                          \
+    queue->_mask = capacity - 1;                                                    \
+    atomic_init(&queue->_head, 0);                                                  \
+    atomic_init(&queue->_tail, 0);                                                  \
+}                                                                                   \
+                                                                                    \
+static inline sgl_mpmc_queue(T)*                                                    \
+sgl_detail_new_mpmc_queue_##T(size_t capacity, const sgl_allocator* allocator)      \
+{                                                                                   \
+    sgl_detail_mpmc_queue_slot_##T* slots =                                         \
+        sgl_detail_mpmc_queue_slots_##T(&capacity, allocator);                      \
+    sgl_mpmc_queue(T)* res = sgl_detail_allocate(allocator,                         \
+                                                 sizeof(sgl_mpmc_queue(T)),         \
+                                                 alignof(sgl_mpmc_queue(T)));       \
+    if (not res)                                                                    \
+    {                                                                               \
+        sgl_detail_deallocate(allocator, slots,                                     \
+                              capacity * sizeof(sgl_detail_mpmc_queue_slot_##T));   \
+        sgl_throw(sgl_bad_alloc);                                                   \
+    }                                                                               \
+    sgl_detail_init_mpmc_queue_##T(res, slots, capacity, allocator);                \
+    return res;                                                                     \
+}                                                                                   \
+                                                                                    \
+void sgl_init_with_allocator_sgl_mpmc_queue_##T(sgl_mpmc_queue(T)* queue,           \
+                                                const sgl_allocator* allocator)     \
+{                                                                                   \
+    size_t capacity = SGL_MPMC_QUEUE_CAPACITY;                                      \
+    sgl_detail_mpmc_queue_slot_##T* slots =                                         \
+        sgl_detail_mpmc_queue_slots_##T(&capacity, allocator);                      \
+    sgl_detail_init_mpmc_queue_##T(queue, slots, capacity, allocator);              \
+}                                                                                   \
+                                                                                    \
+void sgl_init_sgl_mpmc_queue_##T(sgl_mpmc_queue(T)* queue)                          \
+{                                                                                   \
+    sgl_init_with_allocator_sgl_mpmc_queue_##T(queue, NULL);                        \
+}                                                                                   \
+                                                                                    \
+sgl_mpmc_queue(T)* sgl_new_with_capacity_sgl_mpmc_queue_##T(size_t capacity)        \
+{                                                                                   \
+    return sgl_detail_new_mpmc_queue_##T(capacity, NULL);                           \
+}                                                                                   \
+                                                                                    \
+sgl_mpmc_queue(T)*                                                                  \
+sgl_new_with_allocator_sgl_mpmc_queue_##T(const sgl_allocator* allocator)           \
+{                                                                                   \
+    return sgl_detail_new_mpmc_queue_##T(SGL_MPMC_QUEUE_CAPACITY, allocator);       \
+}                                                                                   \
+                                                                                    \
+sgl_mpmc_queue(T)* sgl_new_sgl_mpmc_queue_##T()                                     \
+{                                                                                   \
+    return sgl_detail_new_mpmc_queue_##T(SGL_MPMC_QUEUE_CAPACITY, NULL);            \
+}
+
+#endif // SGL_MPMC_QUEUE_H_
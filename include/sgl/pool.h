@@ -0,0 +1,514 @@
+/*
+ * Copyright (C) 2015 Morwenn
+ *
+ * The SGL is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * The SGL is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program. If not,
+ * see <http://www.gnu.org/licenses/>.
+ */
+#ifndef SGL_POOL_H_
+#define SGL_POOL_H_
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <stdint.h>
+#include <sgl/exception.h>
+#include <sgl/memory/allocator.h>
+#include <sgl/detail/common.h>
+
+#ifndef SGL_POOL_SLAB_SIZE
+
+    /**
+     * @def SGL_POOL_SLAB_SIZE
+     *
+     * Default number of objects in the slabs of the sgl_pool types,
+     * used when no capacity is given to the constructor. It can be
+     * set with the compiler option -DSGL_POOL_SLAB_SIZE=size.
+     */
+    #define SGL_POOL_SLAB_SIZE 64
+
+#endif
+
+#ifdef SGL_POOL_THREAD_CACHE
+
+    /**
+     * @def SGL_POOL_THREAD_CACHE
+     *
+     * When defined with the compiler option -DSGL_POOL_THREAD_CACHE=n,
+     * the sgl_pool types can be shared between threads: the slabs are
+     * protected by a mutex and every thread keeps a cache of at most
+     * n free objects per pool type so that most allocations do not
+     * need to take the lock. The cache of a thread is bound to the
+     * last pool it used and is given back to it when the thread uses
+     * another pool of the same type, calls sgl_pool_flush or exits.
+     * A thread which outlives a pool should flush its cache before
+     * the pool is destroyed.
+     */
+
+    #include <threads.h>
+
+    #define SGL_DETAIL_POOL_CACHE_SIZE (SGL_POOL_THREAD_CACHE)
+    #define SGL_DETAIL_POOL_MUTEX mtx_t _mutex;
+    #define sgl_detail_pool_mutex_init(pool) mtx_init(&(pool)->_mutex, mtx_plain)
+    #define sgl_detail_pool_mutex_destroy(pool) mtx_destroy(&(pool)->_mutex)
+    #define sgl_detail_pool_lock(pool) mtx_lock(&(pool)->_mutex)
+    #define sgl_detail_pool_unlock(pool) mtx_unlock(&(pool)->_mutex)
+
+    // The cache of an exiting thread is flushed by the destructor
+    // of a thread-specific storage holding its bound pool
+    #define SGL_DETAIL_POOL_EXIT_KEY(T)                                             \
+                                                                                    \
+    static tss_t sgl_detail_pool_key_##T;                                           \
+    static once_flag sgl_detail_pool_once_##T = ONCE_FLAG_INIT;                     \
+                                                                                    \
+    static void sgl_detail_pool_exit_##T(void* pool)                                \
+    {                                                                               \
+        sgl_pool_flush_##T(pool);                                                   \
+    }                                                                               \
+                                                                                    \
+    static void sgl_detail_pool_key_init_##T(void)                                  \
+    {                                                                               \
+        tss_create(&sgl_detail_pool_key_##T, &sgl_detail_pool_exit_##T);            \
+    }
+
+    #define sgl_detail_pool_set_exit(T, pool)                                       \
+        (call_once(&sgl_detail_pool_once_##T, &sgl_detail_pool_key_init_##T),       \
+         tss_set(sgl_detail_pool_key_##T, pool))
+
+#else
+
+    #define SGL_DETAIL_POOL_CACHE_SIZE 0
+    #define SGL_DETAIL_POOL_MUTEX
+    #define sgl_detail_pool_mutex_init(pool) ((void) (pool))
+    #define sgl_detail_pool_mutex_destroy(pool) ((void) (pool))
+    #define sgl_detail_pool_lock(pool) ((void) (pool))
+    #define sgl_detail_pool_unlock(pool) ((void) (pool))
+    #define SGL_DETAIL_POOL_EXIT_KEY(T)
+    #define sgl_detail_pool_set_exit(T, pool) ((void) (pool))
+
+#endif
+
+/**
+ * @brief Statistics about a pool.
+ *
+ * The used objects are the ones which have been allocated and not
+ * given back to the pool yet, including the free objects kept in
+ * the thread caches. The utilization is used / capacity, or 0 for
+ * a pool without slabs.
+ */
+typedef struct
+{
+    size_t slab_count;
+    size_t capacity;
+    size_t used;
+    double utilization;
+} sgl_pool_stats;
+
+/**
+ * @def sgl_pool_allocate(pool)
+ *
+ * Returns a pointer to uninitialized storage for one object of the
+ * pool. Throws sgl_bad_alloc if a new slab can not be allocated.
+ */
+#define sgl_pool_allocate(pool) \
+    (pool)->_functions->allocate(pool)
+
+/**
+ * @def sgl_pool_deallocate(pool, ptr)
+ *
+ * Gives back to the pool an object obtained from sgl_pool_allocate.
+ */
+#define sgl_pool_deallocate(pool, ptr) \
+    (pool)->_functions->deallocate(pool, ptr)
+
+/**
+ * @def sgl_pool_flush(pool)
+ *
+ * Gives back to the pool the free objects kept in the cache of the
+ * calling thread. Does nothing when SGL_POOL_THREAD_CACHE is not
+ * defined.
+ */
+#define sgl_pool_flush(pool) \
+    (pool)->_functions->flush(pool)
+
+/**
+ * @def sgl_pool_get_stats(pool)
+ *
+ * Returns the sgl_pool_stats of the pool.
+ */
+#define sgl_pool_get_stats(pool) \
+    (pool)->_functions->stats(pool)
+
+/**
+ * @def sgl_pool(T)
+ *
+ * Alias for the sgl_pool_T type.
+ */
+#define sgl_pool(T) \
+    sgl_pool_##T
+
+/**
+ * @def sgl_define_sgl_pool(T)
+ * Creates all the methods for a sgl_pool of given type.
+ */
+#define sgl_define_sgl_pool(T)                                                      \
+    sgl_declare_sgl_pool(T)                                                         \
+    sgl_instantiate_sgl_pool(T)
+
+/**
+ * @def sgl_declare_sgl_pool(T)
+ * Declares the type and the methods of a sgl_pool of given type.
+ * A pool allocates objects of type T one by one from slabs of
+ * several objects and keeps the freed objects in an intrusive free
+ * list, so that allocation and deallocation are O(1). The slabs are
+ * only freed when the pool is destroyed.
+ */
+#define sgl_declare_sgl_pool(T)                                                     \
+                                                                                    \
+    typedef struct sgl_detail_pool_##T sgl_pool(T);                                 \
+                                                                                    \
+    typedef union sgl_detail_pool_node_##T                                          \
+    {                                                                               \
+        union sgl_detail_pool_node_##T* _next;                                      \
+        T _value;                                                                   \
+    } sgl_detail_pool_node_##T;                                                     \
+                                                                                    \
+    typedef struct sgl_detail_pool_slab_##T                                         \
+    {                                                                               \
+        struct sgl_detail_pool_slab_##T* _next;                                     \
+        sgl_detail_pool_node_##T _nodes[];                                          \
+    } sgl_detail_pool_slab_##T;                                                     \
+                                                                                    \
+    typedef struct                                                                  \
+    {                                                                               \
+        void (*delete)(sgl_pool(T)*);                                               \
+        void (*destroy)(sgl_pool(T)*);                                              \
+        T* (*allocate)(sgl_pool(T)*);                                               \
+        void (*deallocate)(sgl_pool(T)*, T*);                                       \
+        void (*flush)(sgl_pool(T)*);                                                \
+        sgl_pool_stats (*stats)(const sgl_pool(T)*);                                \
+    } sgl_detail_pool_functions_##T;                                                \
+                                                                                    \
+    struct sgl_detail_pool_##T                                                      \
+    {                                                                               \
+        sgl_detail_pool_node_##T* _free;                                            \
+        sgl_detail_pool_node_##T* _bump;                                            \
+        sgl_detail_pool_node_##T* _bump_end;                                        \
+        sgl_detail_pool_slab_##T* _slabs;                                           \
+        size_t _slab_size;                                                          \
+        size_t _slab_count;                                                         \
+        size_t _used;                                                               \
+        const sgl_allocator* _allocator;                                            \
+        SGL_DETAIL_POOL_MUTEX                                                       \
+        const sgl_detail_pool_functions_##T* _functions;                            \
+    };                                                                              \
+                                                                                    \
+sgl_pool(T)* sgl_new_sgl_pool_##T();                                                \
+sgl_pool(T)* sgl_new_with_capacity_sgl_pool_##T(size_t);                            \
+sgl_pool(T)* sgl_new_with_allocator_sgl_pool_##T(const sgl_allocator*);             \
+void sgl_init_sgl_pool_##T(sgl_pool(T)*);                                           \
+void sgl_init_with_allocator_sgl_pool_##T(sgl_pool(T)*, const sgl_allocator*);      \
+void sgl_pool_delete_##T(sgl_pool(T)*);                                             \
+void sgl_pool_destroy_##T(sgl_pool(T)*);                                            \
+T* sgl_pool_allocate_##T(sgl_pool(T)*);                                             \
+void sgl_pool_deallocate_##T(sgl_pool(T)*, T*);                                     \
+void sgl_pool_flush_##T(sgl_pool(T)*);                                              \
+sgl_pool_stats sgl_pool_stats_##T(const sgl_pool(T)*);                              \
+                                                                                    \
+extern const sgl_detail_pool_functions_##T sgl_detail_pool_funcs_##T;
+
+/**
+ * @def sgl_instantiate_sgl_pool(T)
+ * Defines the methods of a sgl_pool of given type, which must have
+ * been declared beforehand. It shall appear in exactly one
+ * translation unit.
+ */
+#define sgl_instantiate_sgl_pool(T)                                                 \
+                                                                                    \
+/* Free objects kept by the current thread */                                       \
+static _Thread_local struct                                                         \
+{                                                                                   \
+    sgl_pool(T)* _owner;                                                            \
+    sgl_detail_pool_node_##T* _head;                                                \
+    size_t _count;                                                                  \
+} sgl_detail_pool_cache_##T;                                                        \
+                                                                                    \
+SGL_DETAIL_POOL_EXIT_KEY(T)                                                         \
+                                                                                    \
+/* Takes a node from the slabs, the pool must be locked */                          \
+static inline sgl_detail_pool_node_##T*                                             \
+sgl_detail_pool_pop_##T(sgl_pool(T)* pool)                                          \
+{                                                                                   \
+    sgl_detail_pool_node_##T* node = pool->_free;                                   \
+    if (node)                                                                       \
+    {                                                                               \
+        pool->_free = node->_next;                                                  \
+    }                                                                               \
+    else                                                                            \
+    {                                                                               \
+        if (pool->_bump == pool->_bump_end)                                         \
+        {                                                                           \
+            size_t count = pool->_slab_size;                                        \
+            if (count > (SIZE_MAX - sizeof(sgl_detail_pool_slab_##T))               \
+                        / sizeof(sgl_detail_pool_node_##T))                         \
+            {                                                                       \
+                return NULL;                                                        \
+            }                                                                       \
+            sgl_detail_pool_slab_##T* slab = sgl_detail_allocate(                   \
+                pool->_allocator,                                                   \
+                sizeof(sgl_detail_pool_slab_##T)                                    \
+                + count * sizeof(sgl_detail_pool_node_##T),                         \
+                alignof(sgl_detail_pool_slab_##T));                                 \
+            if (not slab)                                                           \
+            {                                                                       \
+                return NULL;                                                        \
+            }                                                                       \
+            slab->_next = pool->_slabs;                                             \
+            pool->_slabs = slab;                                                    \
+            ++pool->_slab_count;                                                    \
+            /* Nodes are carved from the new slab on demand */                      \
+            pool->_bump = slab->_nodes;                                             \
+            pool->_bump_end = slab->_nodes + count;                                 \
+        }                                                                           \
+        node = pool->_bump++;                                                       \
+    }                                                                               \
+    ++pool->_used;                                                                  \
+    return node;                                                                    \
+}                                                                                   \
+                                                                                    \
+/* Gives a node back to the slabs, the pool must be locked */                       \
+static inline void sgl_detail_pool_push_##T(sgl_pool(T)* pool,                      \
+                                            sgl_detail_pool_node_##T* node)         \
+{                                                                                   \
+    node->_next = pool->_free;                                                      \
+    pool->_free = node;                                                             \
+    --pool->_used;                                                                  \
+}                                                                                   \
+                                                                                    \
+void sgl_pool_flush_##T(sgl_pool(T)* pool)                                          \
+{                                                                                   \
+    if (SGL_DETAIL_POOL_CACHE_SIZE == 0                                             \
+        || sgl_detail_pool_cache_##T._owner != pool)                                \
+    {                                                                               \
+        return;                                                                     \
+    }                                                                               \
+    sgl_detail_pool_lock(pool);                                                     \
+    while (sgl_detail_pool_cache_##T._head)                                         \
+    {                                                                               \
+        sgl_detail_pool_node_##T* node = sgl_detail_pool_cache_##T._head;           \
+        sgl_detail_pool_cache_##T._head = node->_next;                              \
+        sgl_detail_pool_push_##T(pool, node);                                       \
+    }                                                                               \
+    sgl_detail_pool_unlock(pool);                                                   \
+    sgl_detail_pool_cache_##T._count = 0;                                           \
+    sgl_detail_pool_cache_##T._owner = NULL;                                        \
+    sgl_detail_pool_set_exit(T, NULL);                                              \
+}                                                                                   \
+                                                                                    \
+/* Binds the cache of the current thread to the given pool */                       \
+static inline void sgl_detail_pool_bind_##T(sgl_pool(T)* pool)                      \
+{                                                                                   \
+    if (sgl_detail_pool_cache_##T._owner != pool)                                   \
+    {                                                                               \
+        if (sgl_detail_pool_cache_##T._owner)                                       \
+        {                                                                           \
+            sgl_pool_flush_##T(sgl_detail_pool_cache_##T._owner);                   \
+        }                                                                           \
+        sgl_detail_pool_cache_##T._owner = pool;                                    \
+        sgl_detail_pool_set_exit(T, pool);                                          \
+    }                                                                               \
+}                                                                                   \
+                                                                                    \
+void sgl_pool_delete_##T(sgl_pool(T)* pool)                                         \
+{                                                                                   \
+    sgl_pool_destroy_##T(pool);                                                     \
+    sgl_detail_deallocate(pool->_allocator, pool, sizeof(sgl_pool(T)));             \
+}                                                                                   \
+                                                                                    \
+void sgl_pool_destroy_##T(sgl_pool(T)* pool)                                        \
+{                                                                                   \
+    if (sgl_detail_pool_cache_##T._owner == pool)                                   \
+    {                                                                               \
+        /* The cached nodes belong to the slabs freed below */                      \
+        sgl_detail_pool_cache_##T._owner = NULL;                                    \
+        sgl_detail_pool_cache_##T._head = NULL;                                     \
+        sgl_detail_pool_cache_##T._count = 0;                                       \
+        sgl_detail_pool_set_exit(T, NULL);                                          \
+    }                                                                               \
+    size_t size = sizeof(sgl_detail_pool_slab_##T)                                  \
+                + pool->_slab_size * sizeof(sgl_detail_pool_node_##T);              \
+    while (pool->_slabs)                                                            \
+    {                                                                               \
+        sgl_detail_pool_slab_##T* next = pool->_slabs->_next;                       \
+        sgl_detail_deallocate(pool->_allocator, pool->_slabs, size);                \
+        pool->_slabs = next;                                                        \
+    }                                                                               \
+    pool->_free = NULL;                                                             \
+    pool->_bump = NULL;                                                             \
+    pool->_bump_end = NULL;                                                         \
+    pool->_slab_count = 0;                                                          \
+    pool->_used = 0;                                                                \
+    sgl_detail_pool_mutex_destroy(pool);                                            \
+}                                                                                   \
+                                                                                    \
+T* sgl_pool_allocate_##T(sgl_pool(T)* pool)                                         \
+{                                                                                   \
+    if (SGL_DETAIL_POOL_CACHE_SIZE == 0)                                            \
+    {                                                                               \
+        sgl_detail_pool_node_##T* node = sgl_detail_pool_pop_##T(pool);             \
+        if (not node)                                                               \
+        {                                                                           \
+            sgl_throw(sgl_bad_alloc);                                               \
+        }                                                                           \
+        return &node->_value;                                                       \
+    }                                                                               \
+                                                                                    \
+    sgl_detail_pool_bind_##T(pool);                                                 \
+    if (sgl_detail_pool_cache_##T._head == NULL)                                    \
+    {                                                                               \
+        /* Refill half of the cache at once */                                      \
+        size_t count = SGL_DETAIL_POOL_CACHE_SIZE / 2 + 1;                          \
+        sgl_detail_pool_lock(pool);                                                 \
+        for (size_t i = 0 ; i < count ; ++i)                                        \
+        {                                                                           \
+            sgl_detail_pool_node_##T* node = sgl_detail_pool_pop_##T(pool);         \
+            if (not node)                                                           \
+            {                                                                       \
+                break;                                                              \
+            }                                                                       \
+            node->_next = sgl_detail_pool_cache_##T._head;                          \
+            sgl_detail_pool_cache_##T._head = node;                                 \
+            ++sgl_detail_pool_cache_##T._count;                                     \
+        }                                                                           \
+        sgl_detail_pool_unlock(pool);                                               \
+        if (sgl_detail_pool_cache_##T._head == NULL)                                \
+        {                                                                           \
+            sgl_throw(sgl_bad_alloc);                                               \
+        }                                                                           \
+    }                                                                               \
+    sgl_detail_pool_node_##T* node = sgl_detail_pool_cache_##T._head;               \
+    sgl_detail_pool_cache_##T._head = node->_next;                                  \
+    --sgl_detail_pool_cache_##T._count;                                             \
+    return &node->_value;                                                           \
+}                                                                                   \
+                                                                                    \
+void sgl_pool_deallocate_##T(sgl_pool(T)* pool, T* ptr)                             \
+{                                                                                   \
+    sgl_detail_pool_node_##T* node = (sgl_detail_pool_node_##T*) ptr;               \
+    if (SGL_DETAIL_POOL_CACHE_SIZE == 0)                                            \
+    {                                                                               \
+        sgl_detail_pool_push_##T(pool, node);                                       \
+        return;                                                                     \
+    }                                                                               \
+                                                                                    \
+    sgl_detail_pool_bind_##T(pool);                                                 \
+    node->_next = sgl_detail_pool_cache_##T._head;                                  \
+    sgl_detail_pool_cache_##T._head = node;                                         \
+    if (++sgl_detail_pool_cache_##T._count > SGL_DETAIL_POOL_CACHE_SIZE)            \
+    {                                                                               \
+        /* Give half of the cache back to the pool */                               \
+        sgl_detail_pool_lock(pool);                                                 \
+        while (sgl_detail_pool_cache_##T._count > SGL_DETAIL_POOL_CACHE_SIZE / 2)   \
+        {                                                                           \
+            node = sgl_detail_pool_cache_##T._head;                                 \
+            sgl_detail_pool_cache_##T._head = node->_next;                          \
+            --sgl_detail_pool_cache_##T._count;                                     \
+            sgl_detail_pool_push_##T(pool, node);                                   \
+        }                                                                           \
+        sgl_detail_pool_unlock(pool);                                               \
+    }                                                                               \
+}                                                                                   \
+                                                                                    \
+sgl_pool_stats sgl_pool_stats_##T(const sgl_pool(T)* pool)                          \
+{                                                                                   \
+    sgl_pool(T)* mut = (sgl_pool(T)*) pool;                                         \
+    sgl_detail_pool_lock(mut);                                                      \
+    sgl_pool_stats stats = {                                                        \
+        pool->_slab_count,                                                          \
+        pool->_slab_count * pool->_slab_size,                                       \
+        pool->_used,                                                                \
+        0.0                                                                         \
+    };                                                                              \
+    sgl_detail_pool_unlock(mut);                                                    \
+    if (stats.capacity)                                                             \
+    {                                                                               \
+        stats.utilization = (double) stats.used / (double) stats.capacity;          \
+    }                                                                               \
+    return stats;                                                                   \
+}                                                                                   \
+                                                                                    \
+const sgl_detail_pool_functions_##T sgl_detail_pool_funcs_##T = {                   \
+    &sgl_pool_delete_##T,                                                           \
+    &sgl_pool_destroy_##T,                                                          \
+    &sgl_pool_allocate_##T,                                                         \
+    &sgl_pool_deallocate_##T,                                                       \
+    &sgl_pool_flush_##T,                                                            \
+    &sgl_pool_stats_##T                                                             \
+};                                                                                  \
+                                                                                    \
+static inline void sgl_detail_init_pool_##T(sgl_pool(T)* pool,                      \
+                                            size_t slab_size,                       \
+                                            const sgl_allocator* allocator)         \
+{                                                                                   \
+    pool->_functions = &sgl_detail_pool_funcs_##T;                                  \
+    pool->_allocator = allocator;                                                   \
+    pool->_free = NULL;                                                             \
+    pool->_bump = NULL;                                                             \
+    pool->_bump_end = NULL;                                                         \
+    pool->_slabs = NULL;                                                            \
+    pool->_slab_size = slab_size ? slab_size : 1;                                   \
+    pool->_slab_count = 0;                                                          \
+    pool->_used = 0;                                                                \
+    sgl_detail_pool_mutex_init(pool);                                               \
+}                                                                                   \
+                                                                                    \
+void sgl_init_with_allocator_sgl_pool_##T(sgl_pool(T)* pool,                        \
+                                          const sgl_allocator* allocator)           \
+{                                                                                   \
+    sgl_detail_init_pool_##T(pool, SGL_POOL_SLAB_SIZE, allocator);                  \
+}                                                                                   \
+                                                                                    \
+void sgl_init_sgl_pool_##T(sgl_pool(T)* pool)                                       \
+{                                                                                   \
+    sgl_detail_init_pool_##T(pool, SGL_POOL_SLAB_SIZE, NULL);                       \
+}                                                                                   \
+                                                                                    \
+static inline sgl_pool(T)*                                                          \
+sgl_detail_new_pool_##T(size_t slab_size, const sgl_allocator* allocator)           \
+{                                                                                   \
+    sgl_pool(T)* res = sgl_detail_allocate(allocator, sizeof(sgl_pool(T)),          \
+                                           alignof(sgl_pool(T)));                   \
+    if (not res)                                                                    \
+    {                                                                               \
+        sgl_throw(sgl_bad_alloc);                                                   \
+    }                                                                               \
+    sgl_detail_init_pool_##T(res, slab_size, allocator);                            \
+    return res;                                                                     \
+}                                                                                   \
+                                                                                    \
+sgl_pool(T)* sgl_new_with_capacity_sgl_pool_##T(size_t slab_size)                   \
+{                                                                                   \
+    return sgl_detail_new_pool_##T(slab_size, NULL);                                \
+}                                                                                   \
+                                                                                    \
+sgl_pool(T)* sgl_new_with_allocator_sgl_pool_##T(const sgl_allocator* allocator)    \
+{                                                                                   \
+    return sgl_detail_new_pool_##T(SGL_POOL_SLAB_SIZE, allocator);                  \
+}                                                                                   \
+                                                                                    \
+sgl_pool(T)* sgl_new_sgl_pool_##T()                                                 \
+{                                                                                   \
+    return sgl_detail_new_pool_##T(SGL_POOL_SLAB_SIZE, NULL);                       \
+}
+
+#endif // SGL_POOL_H_
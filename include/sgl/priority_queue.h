@@ -0,0 +1,931 @@
+/*
+ * Copyright (C) 2015 Morwenn
+ *
+ * The SGL is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * The SGL is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program. If not,
+ * see <http://www.gnu.org/licenses/>.
+ */
+#ifndef SGL_PRIORITY_QUEUE_H_
+#define SGL_PRIORITY_QUEUE_H_
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <stdint.h>
+#include <string.h>
+#include <sgl/collection.h>
+#include <sgl/exception.h>
+#include <sgl/memory/allocator.h>
+#include <sgl/utility/compare.h>
+#include <sgl/detail/common.h>
+
+#ifndef SGL_PRIORITY_QUEUE_ARITY
+
+    /**
+     * @def SGL_PRIORITY_QUEUE_ARITY
+     *
+     * Number of children of the nodes of the heaps used by the
+     * priority queues. Wider heaps are shallower and the children
+     * of a node share a few cache lines, so pushing is cheaper and
+     * popping touches less memory than with a binary heap, at the
+     * cost of more comparisons per level. It is read when a
+     * priority queue type is defined and can be set with the
+     * compiler option -DSGL_PRIORITY_QUEUE_ARITY=n.
+     */
+    #define SGL_PRIORITY_QUEUE_ARITY 4
+
+#endif
+
+/**
+ * Handle to an element of a sgl_mutable_priority_queue, which
+ * remains valid until the element is popped or erased. The handles
+ * of removed elements are reused by the next insertions.
+ */
+typedef size_t sgl_priority_queue_handle;
+
+/**
+ * @def sgl_make_heap(queue, values, count)
+ *
+ * Replaces the elements of a sgl_priority_queue by a copy of the
+ * count elements pointed to by values, in O(n). The values must
+ * not be stored in the queue itself.
+ */
+#define sgl_make_heap(queue, values, count) \
+    (queue)->_functions->make_heap(queue, values, count)
+
+/**
+ * @def sgl_make_heap_vector(queue, other)
+ *
+ * Replaces the elements of a sgl_priority_queue by a copy of the
+ * elements of a contiguous collection, in O(n).
+ */
+#define sgl_make_heap_vector(queue, other) \
+    sgl_make_heap(queue, sgl_data(other), sgl_size(other))
+
+/**
+ * @def sgl_priority_queue_update(queue, handle, value)
+ *
+ * Changes the value of the element of a sgl_mutable_priority_queue
+ * referenced by the given handle, and moves it to its new place in
+ * O(log n). It can both increase and decrease the priority.
+ */
+#define sgl_priority_queue_update(queue, handle, value) \
+    (queue)->_functions->update(queue, handle, value)
+
+/**
+ * @def sgl_priority_queue_top_handle(queue)
+ *
+ * Returns the handle of the element with the highest priority of
+ * a sgl_mutable_priority_queue.
+ */
+#define sgl_priority_queue_top_handle(queue) \
+    (queue)->_functions->top_handle(queue)
+
+////////////////////////////////////////////////////////////
+// Priority queue
+
+/**
+ * @def sgl_priority_queue(T, cmp)
+ *
+ * Alias for the sgl_priority_queue_T_cmp type.
+ */
+#define sgl_priority_queue(T, cmp) \
+    sgl_priority_queue_##T##_##cmp
+
+/**
+ * @def sgl_define_sgl_priority_queue(T, cmp)
+ * Creates all the methods for a sgl_priority_queue of given type
+ * and comparison.
+ */
+#define sgl_define_sgl_priority_queue(T, cmp)                                       \
+    sgl_declare_sgl_priority_queue(T, cmp)                                          \
+    sgl_instantiate_sgl_priority_queue(T, cmp)
+
+/**
+ * @def sgl_declare_sgl_priority_queue(T, cmp)
+ * Declares the type and the methods of a sgl_priority_queue of
+ * given type. cmp is the name of a function or function-like macro
+ * such that cmp(a, b) is true when a has a lower priority than b:
+ * like in C++, sgl_top returns the greatest element with sgl_less.
+ * The comparison is called directly, so a macro or an inline
+ * function is inlined in the heap operations.
+ *
+ * The elements are stored as a d-ary heap in an array owned by the
+ * queue and are moved with plain assignments, so T can be any
+ * complete type. sgl_push and sgl_pop are O(log n), sgl_top is O(1)
+ * and sgl_make_heap is O(n). Popping from an empty queue does
+ * nothing and leaves out unchanged.
+ */
+#define sgl_declare_sgl_priority_queue(T, cmp) \
+    sgl_detail_declare_priority_queue(T, cmp, T##_##cmp)
+
+/**
+ * @def sgl_instantiate_sgl_priority_queue(T, cmp)
+ * Defines the methods of a sgl_priority_queue of given type, which
+ * must have been declared beforehand. It shall appear in exactly
+ * one translation unit.
+ */
+#define sgl_instantiate_sgl_priority_queue(T, cmp) \
+    sgl_detail_instantiate_priority_queue(T, cmp, T##_##cmp)
+
+#define sgl_detail_declare_priority_queue(T, cmp, N)                                \
+                                                                                    \
+    static_assert(SGL_PRIORITY_QUEUE_ARITY >= 2,                                    \
+                  "invalid arity for sgl_priority_queue_" #N);                      \
+                                                                                    \
+    typedef struct sgl_detail_priority_queue_##N sgl_priority_queue_##N;            \
+                                                                                    \
+    typedef T sgl_priority_queue_##N##_value_type;                                  \
+    typedef size_t sgl_priority_queue_##N##_size_type;                              \
+                                                                                    \
+    enum { sgl_priority_queue_##N##_arity = SGL_PRIORITY_QUEUE_ARITY };             \
+                                                                                    \
+    typedef struct                                                                  \
+    {                                                                               \
+        void (*delete)(sgl_priority_queue_##N*);                                    \
+        void (*destroy)(sgl_priority_queue_##N*);                                   \
+        T* (*top)(const sgl_priority_queue_##N*);                                   \
+        bool (*is_empty)(const sgl_priority_queue_##N*);                            \
+        size_t (*size)(const sgl_priority_queue_##N*);                              \
+        void (*reserve)(sgl_priority_queue_##N*, size_t);                           \
+        size_t (*capacity)(const sgl_priority_queue_##N*);                          \
+        void (*clear)(sgl_priority_queue_##N*);                                     \
+        void (*push)(sgl_priority_queue_##N*, T);                                   \
+        void (*pop)(sgl_priority_queue_##N*, T*);                                   \
+        void (*make_heap)(sgl_priority_queue_##N*, const T*, size_t);               \
+        sgl_detail_opaque_layout _layout;                                           \
+    } sgl_detail_priority_queue_functions_##N;                                      \
+                                                                                    \
+    struct sgl_detail_priority_queue_##N                                            \
+    {                                                                               \
+        T* _data;                                                                   \
+        size_t _size;                                                               \
+        size_t _capacity;                                                           \
+        const sgl_allocator* _allocator;                                            \
+        const sgl_detail_priority_queue_functions_##N* _functions;                  \
+    };                                                                              \
+                                                                                    \
+sgl_priority_queue_##N* sgl_new_sgl_priority_queue_##N();                           \
+sgl_priority_queue_##N* sgl_new_with_capacity_sgl_priority_queue_##N(size_t);       \
+sgl_priority_queue_##N*                                                             \
+sgl_new_with_allocator_sgl_priority_queue_##N(const sgl_allocator*);                \
+void sgl_init_sgl_priority_queue_##N(sgl_priority_queue_##N*);                      \
+void sgl_init_with_allocator_sgl_priority_queue_##N(sgl_priority_queue_##N*,        \
+                                                    const sgl_allocator*);          \
+void sgl_priority_queue_delete_##N(sgl_priority_queue_##N*);                        \
+void sgl_priority_queue_destroy_##N(sgl_priority_queue_##N*);                       \
+T* sgl_priority_queue_top_##N(const sgl_priority_queue_##N*);                       \
+bool sgl_priority_queue_is_empty_##N(const sgl_priority_queue_##N*);                \
+size_t sgl_priority_queue_size_##N(const sgl_priority_queue_##N*);                  \
+void sgl_priority_queue_reserve_##N(sgl_priority_queue_##N*, size_t);               \
+size_t sgl_priority_queue_capacity_##N(const sgl_priority_queue_##N*);              \
+void sgl_priority_queue_clear_##N(sgl_priority_queue_##N*);                         \
+void sgl_priority_queue_push_##N(sgl_priority_queue_##N*, T);                       \
+void sgl_priority_queue_pop_##N(sgl_priority_queue_##N*, T*);                       \
+void sgl_priority_queue_make_heap_##N(sgl_priority_queue_##N*, const T*, size_t);   \
+                                                                                    \
+extern const sgl_detail_priority_queue_functions_##N                                \
+    sgl_detail_priority_queue_funcs_##N;
+
+#define sgl_detail_instantiate_priority_queue(T, cmp, N)                            \
+                                                                                    \
+/* Moves value up from the hole at index until its parent has a */                  \
+/* higher priority, moving the parents down on the way */                           \
+static inline void sgl_detail_priority_queue_sift_up_##N(T* data, size_t index,     \
+                                                         T value)                   \
+{                                                                                   \
+    while (index > 0)                                                               \
+    {                                                                               \
+        size_t parent = (index - 1) / sgl_priority_queue_##N##_arity;               \
+        if (not cmp(data[parent], value))                                           \
+        {                                                                           \
+            break;                                                                  \
+        }                                                                           \
+        data[index] = data[parent];                                                 \
+        index = parent;                                                             \
+    }                                                                               \
+    data[index] = value;                                                            \
+}                                                                                   \
+                                                                                    \
+/* Moves value down from the hole at index to its place in the */                   \
+/* subheap rooted at index. The hole is first moved down to a leaf */               \
+/* along the path of the best children, then value is sifted up */                  \
+/* from there: popped values come from the bottom of the heap and */                \
+/* usually go back near the bottom, so this saves a comparison */                   \
+/* with value per level, and most of its mispredictions */                          \
+static inline void sgl_detail_priority_queue_sift_down_##N(T* data, size_t size,    \
+                                                           size_t index, T value)   \
+{                                                                                   \
+    size_t start = index;                                                           \
+    for (;;)                                                                        \
+    {                                                                               \
+        size_t first = index * sgl_priority_queue_##N##_arity + 1;                  \
+        if (first >= size)                                                          \
+        {                                                                           \
+            break;                                                                  \
+        }                                                                           \
+        size_t last = size - first > sgl_priority_queue_##N##_arity                 \
+                    ? first + sgl_priority_queue_##N##_arity                        \
+                    : size;                                                         \
+        size_t best = first;                                                        \
+        for (size_t child = first + 1 ; child < last ; ++child)                     \
+        {                                                                           \
+            if (cmp(data[best], data[child]))                                       \
+            {                                                                       \
+                best = child;                                                       \
+            }                                                                       \
+        }                                                                           \
+        data[index] = data[best];                                                   \
+        index = best;                                                               \
+    }                                                                               \
+    while (index > start)                                                           \
+    {                                                                               \
+        size_t parent = (index - 1) / sgl_priority_queue_##N##_arity;               \
+        if (not cmp(data[parent], value))                                           \
+        {                                                                           \
+            break;                                                                  \
+        }                                                                           \
+        data[index] = data[parent];                                                 \
+        index = parent;                                                             \
+    }                                                                               \
+    data[index] = value;                                                            \
+}                                                                                   \
+                                                                                    \
+void sgl_priority_queue_delete_##N(sgl_priority_queue_##N* queue)                   \
+{                                                                                   \
+    sgl_priority_queue_destroy_##N(queue);                                          \
+    sgl_detail_deallocate(queue->_allocator, queue,                                 \
+                          sizeof(sgl_priority_queue_##N));                          \
+}                                                                                   \
+                                                                                    \
+void sgl_priority_queue_destroy_##N(sgl_priority_queue_##N* queue)                  \
+{                                                                                   \
+    sgl_detail_deallocate(queue->_allocator, queue->_data,                          \
+                          queue->_capacity * sizeof(T));                            \
+    queue->_data = NULL;                                                            \
+    queue->_size = 0;                                                               \
+    queue->_capacity = 0;                                                           \
+}                                                                                   \
+                                                                                    \
+T* sgl_priority_queue_top_##N(const sgl_priority_queue_##N* queue)                  \
+{                                                                                   \
+    return queue->_data;                                                            \
+}                                                                                   \
+                                                                                    \
+bool sgl_priority_queue_is_empty_##N(const sgl_priority_queue_##N* queue)           \
+{                                                                                   \
+    return queue->_size == 0;                                                       \
+}                                                                                   \
+                                                                                    \
+size_t sgl_priority_queue_size_##N(const sgl_priority_queue_##N* queue)             \
+{                                                                                   \
+    return queue->_size;                                                            \
+}                                                                                   \
+                                                                                    \
+void sgl_priority_queue_reserve_##N(sgl_priority_queue_##N* queue,                  \
+                                    size_t capacity)                                \
+{                                                                                   \
+    if (capacity <= queue->_capacity)                                               \
+    {                                                                               \
+        return;                                                                     \
+    }                                                                               \
+    if (capacity > SIZE_MAX / sizeof(T))                                            \
+    {                                                                               \
+        sgl_throw(sgl_length_error);                                                \
+    }                                                                               \
+    T* data = sgl_detail_allocate(queue->_allocator, capacity * sizeof(T),          \
+                                  alignof(T));                                      \
+    if (not data)                                                                   \
+    {                                                                               \
+        sgl_throw(sgl_bad_alloc);                                                   \
+    }                                                                               \
+    if (queue->_capacity)                                                           \
+    {                                                                               \
+        memcpy(data, queue->_data, queue->_size * sizeof(T));                       \
+        sgl_detail_deallocate(queue->_allocator, queue->_data,                      \
+                              queue->_capacity * sizeof(T));                        \
+    }                                                                               \
+    queue->_data = data;                                                            \
+    queue->_capacity = capacity;                                                    \
+}                                                                                   \
+                                                                                    \
+size_t sgl_priority_queue_capacity_##N(const sgl_priority_queue_##N* queue)         \
+{                                                                                   \
+    return queue->_capacity;                                                        \
+}                                                                                   \
+                                                                                    \
+void sgl_priority_queue_clear_##N(sgl_priority_queue_##N* queue)                    \
+{                                                                                   \
+    queue->_size = 0;                                                               \
+}                                                                                   \
+                                                                                    \
+void sgl_priority_queue_push_##N(sgl_priority_queue_##N* queue, T value)            \
+{                                                                                   \
+    if (queue->_size == queue->_capacity)                                           \
+    {                                                                               \
+        size_t capacity = queue->_capacity ? queue->_capacity : 8;                  \
+        if (capacity > SIZE_MAX / 2)                                                \
+        {                                                                           \
+            sgl_throw(sgl_length_error);                                            \
+        }                                                                           \
+        sgl_priority_queue_reserve_##N(queue, 2 * capacity);                        \
+    }                                                                               \
+    sgl_detail_priority_queue_sift_up_##N(queue->_data, queue->_size++, value);     \
+}                                                                                   \
+                                                                                    \
+void sgl_priority_queue_pop_##N(sgl_priority_queue_##N* queue, T* out)              \
+{                                                                                   \
+    if (queue->_size == 0)                                                          \
+    {                                                                               \
+        return;                                                                     \
+    }                                                                               \
+    T* data = queue->_data;                                                         \
+    if (out)                                                                        \
+    {                                                                               \
+        *out = data[0];                                                             \
+    }                                                                               \
+    size_t size = --queue->_size;                                                   \
+    if (size > 0)                                                                   \
+    {                                                                               \
+        sgl_detail_priority_queue_sift_down_##N(data, size, 0, data[size]);         \
+    }                                                                               \
+}                                                                                   \
+                                                                                    \
+void sgl_priority_queue_make_heap_##N(sgl_priority_queue_##N* queue,                \
+                                      const T* values, size_t count)                \
+{                                                                                   \
+    /* The old elements are dropped before reserving so that they */                \
+    /* are not copied if the storage grows */                                       \
+    queue->_size = 0;                                                               \
+    sgl_priority_queue_reserve_##N(queue, count);                                   \
+    if (count)                                                                      \
+    {                                                                               \
+        memcpy(queue->_data, values, count * sizeof(T));                            \
+    }                                                                               \
+    queue->_size = count;                                                           \
+                                                                                    \
+    T* data = queue->_data;                                                         \
+    if (count > 1)                                                                  \
+    {                                                                               \
+        /* Sift down every parent, starting from the last one */                    \
+        size_t index = (count - 2) / sgl_priority_queue_##N##_arity + 1;            \
+        while (index-- > 0)                                                         \
+        {                                                                           \
+            sgl_detail_priority_queue_sift_down_##N(data, count, index,             \
+                                                    data[index]);                   \
+        }                                                                           \
+    }                                                                               \
+}                                                                                   \
+                                                                                    \
+const sgl_detail_priority_queue_functions_##N                                       \
+sgl_detail_priority_queue_funcs_##N = {                                             \
+    &sgl_priority_queue_delete_##N,                                                 \
+    &sgl_priority_queue_destroy_##N,                                                \
+    &sgl_priority_queue_top_##N,                                                    \
+    &sgl_priority_queue_is_empty_##N,                                               \
+    &sgl_priority_queue_size_##N,                                                   \
+    &sgl_priority_queue_reserve_##N,                                                \
+    &sgl_priority_queue_capacity_##N,                                               \
+    &sgl_priority_queue_clear_##N,                                                  \
+    &sgl_priority_queue_push_##N,                                                   \
+    &sgl_priority_queue_pop_##N,                                                    \
+    &sgl_priority_queue_make_heap_##N,                                              \
+    { 0 }                                                                           \
+};                                                                                  \
+                                                                                    \
+void sgl_init_with_allocator_sgl_priority_queue_##N(sgl_priority_queue_##N* queue,  \
+                                                    const sgl_allocator* allocator) \
+{                                                                                   \
+    queue->_functions = &sgl_detail_priority_queue_funcs_##N;                       \
+    queue->_allocator = allocator;                                                  \
+    queue->_data = NULL;                                                            \
+    queue->_size = 0;                                                               \
+    queue->_capacity = 0;                                                           \
+}                                                                                   \
+                                                                                    \
+void sgl_init_sgl_priority_queue_##N(sgl_priority_queue_##N* queue)                 \
+{                                                                                   \
+    sgl_init_with_allocator_sgl_priority_queue_##N(queue, NULL);                    \
+}                                                                                   \
+                                                                                    \
+static inline sgl_priority_queue_##N*                                               \
+sgl_detail_new_priority_queue_##N(size_t capacity, const sgl_allocator* allocator)  \
+{                                                                                   \
+    /* Reserve before allocating the queue so that nothing leaks */                 \
+    sgl_priority_queue_##N tmp;                                                     \
+    sgl_init_with_allocator_sgl_priority_queue_##N(&tmp, allocator);                \
+    sgl_priority_queue_reserve_##N(&tmp, capacity);                                 \
+    sgl_priority_queue_##N* res =                                                   \
+        sgl_detail_allocate(allocator, sizeof(sgl_priority_queue_##N),              \
+                            alignof(sgl_priority_queue_##N));                       \
+    if (not res)                                                                    \
+    {                                                                               \
+        sgl_priority_queue_destroy_##N(&tmp);                                       \
+        sgl_throw(sgl_bad_alloc);                                                   \
+    }                                                                               \
+    *res = tmp;                                                                     \
+    return res;                                                                     \
+}                                                                                   \
+                                                                                    \
+sgl_priority_queue_##N*                                                             \
+sgl_new_with_capacity_sgl_priority_queue_##N(size_t capacity)                       \
+{                                                                                   \
+    return sgl_detail_new_priority_queue_##N(capacity, NULL);                       \
+}                                                                                   \
+                                                                                    \
+sgl_priority_queue_##N*                                                             \
+sgl_new_with_allocator_sgl_priority_queue_##N(const sgl_allocator* allocator)       \
+{                                                                                   \
+    return sgl_detail_new_priority_queue_##N(0, allocator);                         \
+}                                                                                   \
+                                                                                    \
+sgl_priority_queue_##N* sgl_new_sgl_priority_queue_##N()                            \
+{                                                                                   \
+    return sgl_detail_new_priority_queue_##N(0, NULL);                              \
+}
+
+////////////////////////////////////////////////////////////
+// Mutable priority queue
+
+/**
+ * @def sgl_mutable_priority_queue(T, cmp)
+ *
+ * Alias for the sgl_mutable_priority_queue_T_cmp type.
+ */
+#define sgl_mutable_priority_queue(T, cmp) \
+    sgl_mutable_priority_queue_##T##_##cmp
+
+/**
+ * @def sgl_define_sgl_mutable_priority_queue(T, cmp)
+ * Creates all the methods for a sgl_mutable_priority_queue of given
+ * type and comparison.
+ */
+#define sgl_define_sgl_mutable_priority_queue(T, cmp)                               \
+    sgl_declare_sgl_mutable_priority_queue(T, cmp)                                  \
+    sgl_instantiate_sgl_mutable_priority_queue(T, cmp)
+
+/**
+ * @def sgl_declare_sgl_mutable_priority_queue(T, cmp)
+ * Declares the type and the methods of a sgl_mutable_priority_queue
+ * of given type, a d-ary heap which can change the priority of its
+ * elements. sgl_push returns a
+ * sgl_priority_queue_handle to the new element, which can be read
+ * with sgl_at, changed with sgl_priority_queue_update (for example
+ * to decrease the key of a node in Dijkstra's algorithm) and
+ * removed with sgl_erase, all in O(log n) at most. Like with
+ * sgl_priority_queue, popping from an empty queue does nothing.
+ */
+#define sgl_declare_sgl_mutable_priority_queue(T, cmp) \
+    sgl_detail_declare_mutable_priority_queue(T, cmp, T##_##cmp)
+
+/**
+ * @def sgl_instantiate_sgl_mutable_priority_queue(T, cmp)
+ * Defines the methods of a sgl_mutable_priority_queue of given type,
+ * which must have been declared beforehand. It shall appear in
+ * exactly one translation unit.
+ */
+#define sgl_instantiate_sgl_mutable_priority_queue(T, cmp) \
+    sgl_detail_instantiate_mutable_priority_queue(T, cmp, T##_##cmp)
+
+#define sgl_detail_declare_mutable_priority_queue(T, cmp, N)                        \
+                                                                                    \
+    static_assert(SGL_PRIORITY_QUEUE_ARITY >= 2,                                    \
+                  "invalid arity for sgl_mutable_priority_queue_" #N);              \
+                                                                                    \
+    typedef struct sgl_detail_mutable_priority_queue_##N                            \
+        sgl_mutable_priority_queue_##N;                                             \
+                                                                                    \
+    typedef T sgl_mutable_priority_queue_##N##_value_type;                          \
+    typedef size_t sgl_mutable_priority_queue_##N##_size_type;                      \
+                                                                                    \
+    enum { sgl_mutable_priority_queue_##N##_arity = SGL_PRIORITY_QUEUE_ARITY };     \
+                                                                                    \
+    typedef struct                                                                  \
+    {                                                                               \
+        T _value;                                                                   \
+        sgl_priority_queue_handle _handle;                                          \
+    } sgl_detail_mutable_priority_queue_entry_##N;                                  \
+                                                                                    \
+    typedef struct                                                                  \
+    {                                                                               \
+        void (*delete)(sgl_mutable_priority_queue_##N*);                            \
+        void (*destroy)(sgl_mutable_priority_queue_##N*);                           \
+        T* (*top)(const sgl_mutable_priority_queue_##N*);                           \
+        sgl_priority_queue_handle (*top_handle)(                                    \
+            const sgl_mutable_priority_queue_##N*);                                 \
+        T* (*at)(const sgl_mutable_priority_queue_##N*, sgl_priority_queue_handle); \
+        bool (*is_empty)(const sgl_mutable_priority_queue_##N*);                    \
+        size_t (*size)(const sgl_mutable_priority_queue_##N*);                      \
+        void (*reserve)(sgl_mutable_priority_queue_##N*, size_t);                   \
+        size_t (*capacity)(const sgl_mutable_priority_queue_##N*);                  \
+        void (*clear)(sgl_mutable_priority_queue_##N*);                             \
+        sgl_priority_queue_handle (*push)(sgl_mutable_priority_queue_##N*, T);      \
+        void (*pop)(sgl_mutable_priority_queue_##N*, T*);                           \
+        void (*update)(sgl_mutable_priority_queue_##N*,                             \
+                       sgl_priority_queue_handle, T);                               \
+        void (*erase1)(sgl_mutable_priority_queue_##N*, sgl_priority_queue_handle); \
+        sgl_detail_opaque_layout _layout;                                           \
+    } sgl_detail_mutable_priority_queue_functions_##N;                              \
+                                                                                    \
+    struct sgl_detail_mutable_priority_queue_##N                                    \
+    {                                                                               \
+        sgl_detail_mutable_priority_queue_entry_##N* _heap;                         \
+        /* Index in the heap of every handle in use, or next free */                \
+        /* handle for the handles which are not */                                  \
+        size_t* _positions;                                                         \
+        size_t _size;                                                               \
+        size_t _capacity;                                                           \
+        size_t _handle_count;                                                       \
+        sgl_priority_queue_handle _free;                                            \
+        const sgl_allocator* _allocator;                                            \
+        const sgl_detail_mutable_priority_queue_functions_##N* _functions;          \
+    };                                                                              \
+                                                                                    \
+sgl_mutable_priority_queue_##N* sgl_new_sgl_mutable_priority_queue_##N();           \
+sgl_mutable_priority_queue_##N*                                                     \
+sgl_new_with_capacity_sgl_mutable_priority_queue_##N(size_t);                       \
+sgl_mutable_priority_queue_##N*                                                     \
+sgl_new_with_allocator_sgl_mutable_priority_queue_##N(const sgl_allocator*);        \
+void sgl_init_sgl_mutable_priority_queue_##N(sgl_mutable_priority_queue_##N*);      \
+void sgl_init_with_allocator_sgl_mutable_priority_queue_##N(                        \
+    sgl_mutable_priority_queue_##N*, const sgl_allocator*);                         \
+void sgl_mutable_priority_queue_delete_##N(sgl_mutable_priority_queue_##N*);        \
+void sgl_mutable_priority_queue_destroy_##N(sgl_mutable_priority_queue_##N*);       \
+T* sgl_mutable_priority_queue_top_##N(const sgl_mutable_priority_queue_##N*);       \
+sgl_priority_queue_handle                                                           \
+sgl_mutable_priority_queue_top_handle_##N(const sgl_mutable_priority_queue_##N*);   \
+T* sgl_mutable_priority_queue_at_##N(const sgl_mutable_priority_queue_##N*,         \
+                                     sgl_priority_queue_handle);                    \
+bool                                                                                \
+sgl_mutable_priority_queue_is_empty_##N(const sgl_mutable_priority_queue_##N*);     \
+size_t sgl_mutable_priority_queue_size_##N(const sgl_mutable_priority_queue_##N*);  \
+void sgl_mutable_priority_queue_reserve_##N(sgl_mutable_priority_queue_##N*,        \
+                                            size_t);                                \
+size_t                                                                              \
+sgl_mutable_priority_queue_capacity_##N(const sgl_mutable_priority_queue_##N*);     \
+void sgl_mutable_priority_queue_clear_##N(sgl_mutable_priority_queue_##N*);         \
+sgl_priority_queue_handle                                                           \
+sgl_mutable_priority_queue_push_##N(sgl_mutable_priority_queue_##N*, T);            \
+void sgl_mutable_priority_queue_pop_##N(sgl_mutable_priority_queue_##N*, T*);       \
+void sgl_mutable_priority_queue_update_##N(sgl_mutable_priority_queue_##N*,         \
+                                           sgl_priority_queue_handle, T);           \
+void sgl_mutable_priority_queue_erase1_##N(sgl_mutable_priority_queue_##N*,         \
+                                           sgl_priority_queue_handle);              \
+                                                                                    \
+extern const sgl_detail_mutable_priority_queue_functions_##N                        \
+    sgl_detail_mutable_priority_queue_funcs_##N;
+
+#define sgl_detail_instantiate_mutable_priority_queue(T, cmp, N)                    \
+                                                                                    \
+/* Same as the sift functions of sgl_priority_queue, except that */                 \
+/* the position of every moved handle is updated */                                 \
+static inline void sgl_detail_mutable_priority_queue_sift_up_##N(                   \
+    sgl_mutable_priority_queue_##N* queue, size_t index,                            \
+    sgl_detail_mutable_priority_queue_entry_##N entry)                              \
+{                                                                                   \
+    sgl_detail_mutable_priority_queue_entry_##N* heap = queue->_heap;               \
+    while (index > 0)                                                               \
+    {                                                                               \
+        size_t parent = (index - 1) / sgl_mutable_priority_queue_##N##_arity;       \
+        if (not cmp(heap[parent]._value, entry._value))                             \
+        {                                                                           \
+            break;                                                                  \
+        }                                                                           \
+        heap[index] = heap[parent];                                                 \
+        queue->_positions[heap[index]._handle] = index;                             \
+        index = parent;                                                             \
+    }                                                                               \
+    heap[index] = entry;                                                            \
+    queue->_positions[entry._handle] = index;                                       \
+}                                                                                   \
+                                                                                    \
+static inline void sgl_detail_mutable_priority_queue_sift_down_##N(                 \
+    sgl_mutable_priority_queue_##N* queue, size_t index,                            \
+    sgl_detail_mutable_priority_queue_entry_##N entry)                              \
+{                                                                                   \
+    sgl_detail_mutable_priority_queue_entry_##N* heap = queue->_heap;               \
+    size_t size = queue->_size;                                                     \
+    for (;;)                                                                        \
+    {                                                                               \
+        size_t first = index * sgl_mutable_priority_queue_##N##_arity + 1;          \
+        if (first >= size)                                                          \
+        {                                                                           \
+            break;                                                                  \
+        }                                                                           \
+        size_t last = size - first > sgl_mutable_priority_queue_##N##_arity         \
+                    ? first + sgl_mutable_priority_queue_##N##_arity                \
+                    : size;                                                         \
+        size_t best = first;                                                        \
+        for (size_t child = first + 1 ; child < last ; ++child)                     \
+        {                                                                           \
+            if (cmp(heap[best]._value, heap[child]._value))                         \
+            {                                                                       \
+                best = child;                                                       \
+            }                                                                       \
+        }                                                                           \
+        if (not cmp(entry._value, heap[best]._value))                               \
+        {                                                                           \
+            break;                                                                  \
+        }                                                                           \
+        heap[index] = heap[best];                                                   \
+        queue->_positions[heap[index]._handle] = index;                             \
+        index = best;                                                               \
+    }                                                                               \
+    heap[index] = entry;                                                            \
+    queue->_positions[entry._handle] = index;                                       \
+}                                                                                   \
+                                                                                    \
+/* Puts entry at the given index, which is a hole in the heap */                    \
+static inline void sgl_detail_mutable_priority_queue_place_##N(                     \
+    sgl_mutable_priority_queue_##N* queue, size_t index,                            \
+    sgl_detail_mutable_priority_queue_entry_##N entry)                              \
+{                                                                                   \
+    if (index > 0)                                                                  \
+    {                                                                               \
+        size_t parent = (index - 1) / sgl_mutable_priority_queue_##N##_arity;       \
+        if (cmp(queue->_heap[parent]._value, entry._value))                         \
+        {                                                                           \
+            sgl_detail_mutable_priority_queue_sift_up_##N(queue, index, entry);     \
+            return;                                                                 \
+        }                                                                           \
+    }                                                                               \
+    sgl_detail_mutable_priority_queue_sift_down_##N(queue, index, entry);           \
+}                                                                                   \
+                                                                                    \
+/* Removes the element at the given index of the heap */                            \
+static inline void                                                                  \
+sgl_detail_mutable_priority_queue_remove_##N(sgl_mutable_priority_queue_##N* queue, \
+                                             size_t index)                          \
+{                                                                                   \
+    sgl_priority_queue_handle handle = queue->_heap[index]._handle;                 \
+    queue->_positions[handle] = queue->_free;                                       \
+    queue->_free = handle;                                                          \
+    size_t size = --queue->_size;                                                   \
+    if (index < size)                                                               \
+    {                                                                               \
+        sgl_detail_mutable_priority_queue_place_##N(queue, index,                   \
+                                                    queue->_heap[size]);            \
+    }                                                                               \
+}                                                                                   \
+                                                                                    \
+void sgl_mutable_priority_queue_delete_##N(sgl_mutable_priority_queue_##N* queue)   \
+{                                                                                   \
+    sgl_mutable_priority_queue_destroy_##N(queue);                                  \
+    sgl_detail_deallocate(queue->_allocator, queue,                                 \
+                          sizeof(sgl_mutable_priority_queue_##N));                  \
+}                                                                                   \
+                                                                                    \
+void sgl_mutable_priority_queue_destroy_##N(sgl_mutable_priority_queue_##N* queue)  \
+{                                                                                   \
+    sgl_detail_deallocate(queue->_allocator, queue->_heap,                          \
+                          queue->_capacity                                          \
+                          * sizeof(sgl_detail_mutable_priority_queue_entry_##N));   \
+    sgl_detail_deallocate(queue->_allocator, queue->_positions,                     \
+                          queue->_capacity * sizeof(size_t));                       \
+    queue->_heap = NULL;                                                            \
+    queue->_positions = NULL;                                                       \
+    queue->_size = 0;                                                               \
+    queue->_capacity = 0;                                                           \
+    queue->_handle_count = 0;                                                       \
+    queue->_free = SIZE_MAX;                                                        \
+}                                                                                   \
+                                                                                    \
+T* sgl_mutable_priority_queue_top_##N(const sgl_mutable_priority_queue_##N* queue)  \
+{                                                                                   \
+    return &queue->_heap[0]._value;                                                 \
+}                                                                                   \
+                                                                                    \
+sgl_priority_queue_handle                                                           \
+sgl_mutable_priority_queue_top_handle_##N(                                          \
+    const sgl_mutable_priority_queue_##N* queue)                                    \
+{                                                                                   \
+    return queue->_heap[0]._handle;                                                 \
+}                                                                                   \
+                                                                                    \
+T* sgl_mutable_priority_queue_at_##N(const sgl_mutable_priority_queue_##N* queue,   \
+                                     sgl_priority_queue_handle handle)              \
+{                                                                                   \
+    return &queue->_heap[queue->_positions[handle]]._value;                         \
+}                                                                                   \
+                                                                                    \
+bool sgl_mutable_priority_queue_is_empty_##N(                                       \
+    const sgl_mutable_priority_queue_##N* queue)                                    \
+{                                                                                   \
+    return queue->_size == 0;                                                       \
+}                                                                                   \
+                                                                                    \
+size_t sgl_mutable_priority_queue_size_##N(                                         \
+    const sgl_mutable_priority_queue_##N* queue)                                    \
+{                                                                                   \
+    return queue->_size;                                                            \
+}                                                                                   \
+                                                                                    \
+void sgl_mutable_priority_queue_reserve_##N(sgl_mutable_priority_queue_##N* queue,  \
+                                            size_t capacity)                        \
+{                                                                                   \
+    if (capacity <= queue->_capacity)                                               \
+    {                                                                               \
+        return;                                                                     \
+    }                                                                               \
+    size_t entry_size = sizeof(sgl_detail_mutable_priority_queue_entry_##N);        \
+    if (capacity > SIZE_MAX / entry_size)                                           \
+    {                                                                               \
+        sgl_throw(sgl_length_error);                                                \
+    }                                                                               \
+    /* Both arrays are reallocated before the queue is modified */                  \
+    sgl_detail_mutable_priority_queue_entry_##N* heap = sgl_detail_allocate(        \
+        queue->_allocator, capacity * entry_size,                                   \
+        alignof(sgl_detail_mutable_priority_queue_entry_##N));                      \
+    size_t* positions = sgl_detail_allocate(queue->_allocator,                      \
+                                            capacity * sizeof(size_t),              \
+                                            alignof(size_t));                       \
+    if (not heap || not positions)                                                  \
+    {                                                                               \
+        if (heap)                                                                   \
+        {                                                                           \
+            sgl_detail_deallocate(queue->_allocator, heap, capacity * entry_size);  \
+        }                                                                           \
+        if (positions)                                                              \
+        {                                                                           \
+            sgl_detail_deallocate(queue->_allocator, positions,                     \
+                                  capacity * sizeof(size_t));                       \
+        }                                                                           \
+        sgl_throw(sgl_bad_alloc);                                                   \
+    }                                                                               \
+    if (queue->_capacity)                                                           \
+    {                                                                               \
+        memcpy(heap, queue->_heap, queue->_size * entry_size);                      \
+        memcpy(positions, queue->_positions,                                        \
+               queue->_handle_count * sizeof(size_t));                              \
+        sgl_detail_deallocate(queue->_allocator, queue->_heap,                      \
+                              queue->_capacity * entry_size);                       \
+        sgl_detail_deallocate(queue->_allocator, queue->_positions,                 \
+                              queue->_capacity * sizeof(size_t));                   \
+    }                                                                               \
+    queue->_heap = heap;                                                            \
+    queue->_positions = positions;                                                  \
+    queue->_capacity = capacity;                                                    \
+}                                                                                   \
+                                                                                    \
+size_t                                                                              \
+sgl_mutable_priority_queue_capacity_##N(                                            \
+    const sgl_mutable_priority_queue_##N* queue)                                    \
+{                                                                                   \
+    return queue->_capacity;                                                        \
+}                                                                                   \
+                                                                                    \
+void sgl_mutable_priority_queue_clear_##N(sgl_mutable_priority_queue_##N* queue)    \
+{                                                                                   \
+    queue->_size = 0;                                                               \
+    queue->_handle_count = 0;                                                       \
+    queue->_free = SIZE_MAX;                                                        \
+}                                                                                   \
+                                                                                    \
+sgl_priority_queue_handle                                                           \
+sgl_mutable_priority_queue_push_##N(sgl_mutable_priority_queue_##N* queue, T value) \
+{                                                                                   \
+    if (queue->_size == queue->_capacity)                                           \
+    {                                                                               \
+        size_t capacity = queue->_capacity ? queue->_capacity : 8;                  \
+        if (capacity > SIZE_MAX / 2)                                                \
+        {                                                                           \
+            sgl_throw(sgl_length_error);                                            \
+        }                                                                           \
+        sgl_mutable_priority_queue_reserve_##N(queue, 2 * capacity);                \
+    }                                                                               \
+    /* Reuse the last removed handle if there is one */                             \
+    sgl_priority_queue_handle handle = queue->_free;                                \
+    if (handle != SIZE_MAX)                                                         \
+    {                                                                               \
+        queue->_free = queue->_positions[handle];                                   \
+    }                                                                               \
+    else                                                                            \
+    {                                                                               \
+        handle = queue->_handle_count++;                                            \
+    }                                                                               \
+    sgl_detail_mutable_priority_queue_entry_##N entry = { value, handle };          \
+    sgl_detail_mutable_priority_queue_sift_up_##N(queue, queue->_size++, entry);    \
+    return handle;                                                                  \
+}                                                                                   \
+                                                                                    \
+void sgl_mutable_priority_queue_pop_##N(sgl_mutable_priority_queue_##N* queue,      \
+                                        T* out)                                     \
+{                                                                                   \
+    if (queue->_size == 0)                                                          \
+    {                                                                               \
+        return;                                                                     \
+    }                                                                               \
+    if (out)                                                                        \
+    {                                                                               \
+        *out = queue->_heap[0]._value;                                              \
+    }                                                                               \
+    sgl_detail_mutable_priority_queue_remove_##N(queue, 0);                         \
+}                                                                                   \
+                                                                                    \
+void sgl_mutable_priority_queue_update_##N(sgl_mutable_priority_queue_##N* queue,   \
+                                           sgl_priority_queue_handle handle,        \
+                                           T value)                                 \
+{                                                                                   \
+    size_t index = queue->_positions[handle];                                       \
+    sgl_detail_mutable_priority_queue_entry_##N entry = { value, handle };          \
+    if (cmp(queue->_heap[index]._value, value))                                     \
+    {                                                                               \
+        sgl_detail_mutable_priority_queue_sift_up_##N(queue, index, entry);         \
+    }                                                                               \
+    else                                                                            \
+    {                                                                               \
+        sgl_detail_mutable_priority_queue_sift_down_##N(queue, index, entry);       \
+    }                                                                               \
+}                                                                                   \
+                                                                                    \
+void sgl_mutable_priority_queue_erase1_##N(sgl_mutable_priority_queue_##N* queue,   \
+                                           sgl_priority_queue_handle handle)        \
+{                                                                                   \
+    sgl_detail_mutable_priority_queue_remove_##N(queue, queue->_positions[handle]); \
+}                                                                                   \
+                                                                                    \
+const sgl_detail_mutable_priority_queue_functions_##N                               \
+sgl_detail_mutable_priority_queue_funcs_##N = {                                     \
+    &sgl_mutable_priority_queue_delete_##N,                                         \
+    &sgl_mutable_priority_queue_destroy_##N,                                        \
+    &sgl_mutable_priority_queue_top_##N,                                            \
+    &sgl_mutable_priority_queue_top_handle_##N,                                     \
+    &sgl_mutable_priority_queue_at_##N,                                             \
+    &sgl_mutable_priority_queue_is_empty_##N,                                       \
+    &sgl_mutable_priority_queue_size_##N,                                           \
+    &sgl_mutable_priority_queue_reserve_##N,                                        \
+    &sgl_mutable_priority_queue_capacity_##N,                                       \
+    &sgl_mutable_priority_queue_clear_##N,                                          \
+    &sgl_mutable_priority_queue_push_##N,                                           \
+    &sgl_mutable_priority_queue_pop_##N,                                            \
+    &sgl_mutable_priority_queue_update_##N,                                         \
+    &sgl_mutable_priority_queue_erase1_##N,                                         \
+    { 0 }                                                                           \
+};                                                                                  \
+                                                                                    \
+void sgl_init_with_allocator_sgl_mutable_priority_queue_##N(                        \
+    sgl_mutable_priority_queue_##N* queue, const sgl_allocator* allocator)          \
+{                                                                                   \
+    queue->_functions = &sgl_detail_mutable_priority_queue_funcs_##N;               \
+    queue->_allocator = allocator;                                                  \
+    queue->_heap = NULL;                                                            \
+    queue->_positions = NULL;                                                       \
+    queue->_size = 0;                                                               \
+    queue->_capacity = 0;                                                           \
+    queue->_handle_count = 0;                                                       \
+    queue->_free = SIZE_MAX;                                                        \
+}                                                                                   \
+                                                                                    \
+void sgl_init_sgl_mutable_priority_queue_##N(sgl_mutable_priority_queue_##N* queue) \
+{                                                                                   \
+    sgl_init_with_allocator_sgl_mutable_priority_queue_##N(queue, NULL);            \
+}                                                                                   \
+                                                                                    \
+static inline sgl_mutable_priority_queue_##N*                                       \
+sgl_detail_new_mutable_priority_queue_##N(size_t capacity,                          \
+                                          const sgl_allocator* allocator)           \
+{                                                                                   \
+    sgl_mutable_priority_queue_##N tmp;                                             \
+    sgl_init_with_allocator_sgl_mutable_priority_queue_##N(&tmp, allocator);        \
+    sgl_mutable_priority_queue_reserve_##N(&tmp, capacity);                         \
+    sgl_mutable_priority_queue_##N* res =                                           \
+        sgl_detail_allocate(allocator, sizeof(sgl_mutable_priority_queue_##N),      \
+                            alignof(sgl_mutable_priority_queue_##N));               \
+    if (not res)                                                                    \
+    {                                                                               \
+        sgl_mutable_priority_queue_destroy_##N(&tmp);                               \
+        sgl_throw(sgl_bad_alloc);                                                   \
+    }                                                                               \
+    *res = tmp;                                                                     \
+    return res;                                                                     \
+}                                                                                   \
+                                                                                    \
+sgl_mutable_priority_queue_##N*                                                     \
+sgl_new_with_capacity_sgl_mutable_priority_queue_##N(size_t capacity)               \
+{                                                                                   \
+    return sgl_detail_new_mutable_priority_queue_##N(capacity, NULL);               \
+}                                                                                   \
+                                                                                    \
+sgl_mutable_priority_queue_##N*                                                     \
+sgl_new_with_allocator_sgl_mutable_priority_queue_##N(                              \
+    const sgl_allocator* allocator)                                                 \
+{                                                                                   \
+    return sgl_detail_new_mutable_priority_queue_##N(0, allocator);                 \
+}                                                                                   \
+                                                                                    \
+sgl_mutable_priority_queue_##N* sgl_new_sgl_mutable_priority_queue_##N()            \
+{                                                                                   \
+    return sgl_detail_new_mutable_priority_queue_##N(0, NULL);                      \
+}
+
+#endif // SGL_PRIORITY_QUEUE_H_
@@ -0,0 +1,360 @@
+/*
+ * Copyright (C) 2015 Morwenn
+ *
+ * The SGL is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * The SGL is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program. If not,
+ * see <http://www.gnu.org/licenses/>.
+ */
+#ifndef SGL_SPSC_QUEUE_H_
+#define SGL_SPSC_QUEUE_H_
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <stdatomic.h>
+#include <stdint.h>
+#include <string.h>
+#include <sgl/collection.h>
+#include <sgl/exception.h>
+#include <sgl/memory/alignment.h>
+#include <sgl/memory/allocator.h>
+#include <sgl/detail/common.h>
+
+#ifndef SGL_SPSC_QUEUE_CAPACITY
+
+    /**
+     * @def SGL_SPSC_QUEUE_CAPACITY
+     *
+     * Capacity of the sgl_spsc_queue types when none is given to
+     * the constructor. It can be set with the compiler option
+     * -DSGL_SPSC_QUEUE_CAPACITY=size.
+     */
+    #define SGL_SPSC_QUEUE_CAPACITY 1024
+
+#endif
+
+/**
+ * @def sgl_spsc_queue(T)
+ *
+ * Alias for the sgl_spsc_queue_T type.
+ */
+#define sgl_spsc_queue(T) \
+    sgl_spsc_queue_##T
+
+/**
+ * @def sgl_define_sgl_spsc_queue(T)
+ * Creates all the methods for a sgl_spsc_queue of given type.
+ */
+#define sgl_define_sgl_spsc_queue(T)                                                \
+    sgl_declare_sgl_spsc_queue(T)                                                   \
+    sgl_instantiate_sgl_spsc_queue(T)
+
+/**
+ * @def sgl_declare_sgl_spsc_queue(T)
+ * Declares the type and the methods of a sgl_spsc_queue of given
+ * type. It is a bounded lock-free ring buffer meant to pass values
+ * from exactly one producer thread, which calls sgl_try_push and
+ * sgl_push_n, to exactly one consumer thread, which calls
+ * sgl_try_pop and sgl_pop_n. The capacity is rounded up to a power
+ * of 2 and never changes.
+ *
+ * Both threads only write their own index and keep a cached copy
+ * of the other one, which is only read again when the queue looks
+ * full or empty; the indexes live on different cache lines.
+ * sgl_size and sgl_is_empty can be called from any thread but the
+ * result may be outdated as soon as it is returned. They always go
+ * through the function table, even with SGL_STATIC_DISPATCH, since
+ * the size is computed from both indexes.
+ */
+#define sgl_declare_sgl_spsc_queue(T)                                               \
+                                                                                    \
+    typedef struct sgl_detail_spsc_queue_##T sgl_spsc_queue(T);                     \
+                                                                                    \
+    typedef T sgl_spsc_queue_##T##_value_type;                                      \
+    typedef size_t sgl_spsc_queue_##T##_size_type;                                  \
+                                                                                    \
+    typedef struct                                                                  \
+    {                                                                               \
+        void (*delete)(sgl_spsc_queue(T)*);                                         \
+        void (*destroy)(sgl_spsc_queue(T)*);                                        \
+        bool (*is_empty)(const sgl_spsc_queue(T)*);                                 \
+        size_t (*size)(const sgl_spsc_queue(T)*);                                   \
+        size_t (*capacity)(const sgl_spsc_queue(T)*);                               \
+        bool (*try_push)(sgl_spsc_queue(T)*, T);                                    \
+        bool (*try_pop)(sgl_spsc_queue(T)*, T*);                                    \
+        size_t (*push_n)(sgl_spsc_queue(T)*, const T*, size_t);                     \
+        size_t (*pop_n)(sgl_spsc_queue(T)*, T*, size_t);                            \
+        sgl_detail_opaque_layout _layout;                                           \
+    } sgl_detail_spsc_queue_functions_##T;                                          \
+                                                                                    \
+    struct sgl_detail_spsc_queue_##T                                                \
+    {                                                                               \
+        /* Written by the producer */                                               \
+        alignas(SGL_CACHE_LINE_SIZE) atomic_size_t _tail;                           \
+        size_t _head_cache;                                                         \
+        /* Written by the consumer */                                               \
+        alignas(SGL_CACHE_LINE_SIZE) atomic_size_t _head;                           \
+        size_t _tail_cache;                                                         \
+        /* Never written after the initialization */                                \
+        alignas(SGL_CACHE_LINE_SIZE) T* _data;                                      \
+        size_t _mask;                                                               \
+        const sgl_allocator* _allocator;                                            \
+        const sgl_detail_spsc_queue_functions_##T* _functions;                      \
+    };                                                                              \
+                                                                                    \
+sgl_spsc_queue(T)* sgl_new_sgl_spsc_queue_##T();                                    \
+sgl_spsc_queue(T)* sgl_new_with_capacity_sgl_spsc_queue_##T(size_t);                \
+sgl_spsc_queue(T)* sgl_new_with_allocator_sgl_spsc_queue_##T(const sgl_allocator*); \
+void sgl_init_sgl_spsc_queue_##T(sgl_spsc_queue(T)*);                               \
+void sgl_init_with_allocator_sgl_spsc_queue_##T(sgl_spsc_queue(T)*,                 \
+                                                const sgl_allocator*);              \
+void sgl_spsc_queue_delete_##T(sgl_spsc_queue(T)*);                                 \
+void sgl_spsc_queue_destroy_##T(sgl_spsc_queue(T)*);                                \
+bool sgl_spsc_queue_is_empty_##T(const sgl_spsc_queue(T)*);                         \
+size_t sgl_spsc_queue_size_##T(const sgl_spsc_queue(T)*);                           \
+size_t sgl_spsc_queue_capacity_##T(const sgl_spsc_queue(T)*);                       \
+bool sgl_spsc_queue_try_push_##T(sgl_spsc_queue(T)*, T);                            \
+bool sgl_spsc_queue_try_pop_##T(sgl_spsc_queue(T)*, T*);                            \
+size_t sgl_spsc_queue_push_n_##T(sgl_spsc_queue(T)*, const T*, size_t);             \
+size_t sgl_spsc_queue_pop_n_##T(sgl_spsc_queue(T)*, T*, size_t);                    \
+                                                                                    \
+extern const sgl_detail_spsc_queue_functions_##T sgl_detail_spsc_queue_funcs_##T;
+
+/**
+ * @def sgl_instantiate_sgl_spsc_queue(T)
+ * Defines the methods of a sgl_spsc_queue of given type, which
+ * must have been declared beforehand. It shall appear in exactly
+ * one translation unit.
+ */
+#define sgl_instantiate_sgl_spsc_queue(T)                                           \
+                                                                                    \
+void sgl_spsc_queue_delete_##T(sgl_spsc_queue(T)* queue)                            \
+{                                                                                   \
+    sgl_spsc_queue_destroy_##T(queue);                                              \
+    sgl_detail_deallocate(queue->_allocator, queue, sizeof(sgl_spsc_queue(T)));     \
+}                                                                                   \
+                                                                                    \
+void sgl_spsc_queue_destroy_##T(sgl_spsc_queue(T)* queue)                           \
+{                                                                                   \
+    sgl_detail_deallocate(queue->_allocator, queue->_data,                          \
+                          (queue->_mask + 1) * sizeof(T));                          \
+    queue->_data = NULL;                                                            \
+}                                                                                   \
+                                                                                    \
+bool sgl_spsc_queue_is_empty_##T(const sgl_spsc_queue(T)* queue)                    \
+{                                                                                   \
+    return sgl_spsc_queue_size_##T(queue) == 0;                                     \
+}                                                                                   \
+                                                                                    \
+size_t sgl_spsc_queue_size_##T(const sgl_spsc_queue(T)* queue)                      \
+{                                                                                   \
+    /* Reading the head first guarantees that tail >= head */                       \
+    size_t head = atomic_load_explicit(&((sgl_spsc_queue(T)*) queue)->_head,        \
+                                       memory_order_acquire);                       \
+    size_t tail = atomic_load_explicit(&((sgl_spsc_queue(T)*) queue)->_tail,        \
+                                       memory_order_acquire);                       \
+    return tail - head;                                                             \
+}                                                                                   \
+                                                                                    \
+size_t sgl_spsc_queue_capacity_##T(const sgl_spsc_queue(T)* queue)                  \
+{                                                                                   \
+    return queue->_mask + 1;                                                        \
+}                                                                                   \
+                                                                                    \
+size_t sgl_spsc_queue_push_n_##T(sgl_spsc_queue(T)* queue,                          \
+                                  const T* values, size_t count)                    \
+{                                                                                   \
+    size_t capacity = queue->_mask + 1;                                             \
+    size_t tail = atomic_load_explicit(&queue->_tail, memory_order_relaxed);        \
+    size_t available = capacity - (tail - queue->_head_cache);                      \
+    if (available < count)                                                          \
+    {                                                                               \
+        queue->_head_cache = atomic_load_explicit(&queue->_head,                    \
+                                                  memory_order_acquire);            \
+        available = capacity - (tail - queue->_head_cache);                         \
+        if (count > available)                                                      \
+        {                                                                           \
+            count = available;                                                      \
+        }                                                                           \
+    }                                                                               \
+    if (count == 0)                                                                 \
+    {                                                                               \
+        return 0;                                                                   \
+    }                                                                               \
+    /* The slots may wrap around the end of the buffer */                           \
+    size_t index = tail & queue->_mask;                                             \
+    size_t first = capacity - index < count ? capacity - index : count;             \
+    memcpy(queue->_data + index, values, first * sizeof(T));                        \
+    memcpy(queue->_data, values + first, (count - first) * sizeof(T));              \
+    atomic_store_explicit(&queue->_tail, tail + count, memory_order_release);       \
+    return count;                                                                   \
+}                                                                                   \
+                                                                                    \
+size_t sgl_spsc_queue_pop_n_##T(sgl_spsc_queue(T)* queue,                           \
+                                 T* out, size_t count)                              \
+{                                                                                   \
+    size_t capacity = queue->_mask + 1;                                             \
+    size_t head = atomic_load_explicit(&queue->_head, memory_order_relaxed);        \
+    size_t available = queue->_tail_cache - head;                                   \
+    if (available < count)                                                          \
+    {                                                                               \
+        queue->_tail_cache = atomic_load_explicit(&queue->_tail,                    \
+                                                  memory_order_acquire);            \
+        available = queue->_tail_cache - head;                                      \
+        if (count > available)                                                      \
+        {                                                                           \
+            count = available;                                                      \
+        }                                                                           \
+    }                                                                               \
+    if (count == 0)                                                                 \
+    {                                                                               \
+        return 0;                                                                   \
+    }                                                                               \
+    size_t index = head & queue->_mask;                                             \
+    size_t first = capacity - index < count ? capacity - index : count;             \
+    memcpy(out, queue->_data + index, first * sizeof(T));                           \
+    memcpy(out + first, queue->_data, (count - first) * sizeof(T));                 \
+    atomic_store_explicit(&queue->_head, head + count, memory_order_release);       \
+    return count;                                                                   \
+}                                                                                   \
+                                                                                    \
+bool sgl_spsc_queue_try_push_##T(sgl_spsc_queue(T)* queue, T value)                 \
+{                                                                                   \
+    size_t tail = atomic_load_explicit(&queue->_tail, memory_order_relaxed);        \
+    if (tail - queue->_head_cache > queue->_mask)                                   \
+    {                                                                               \
+        queue->_head_cache = atomic_load_explicit(&queue->_head,                    \
+                                                  memory_order_acquire);            \
+        if (tail - queue->_head_cache > queue->_mask)                               \
+        {                                                                           \
+            return false;                                                           \
+        }                                                                           \
+    }                                                                               \
+    queue->_data[tail & queue->_mask] = value;                                      \
+    atomic_store_explicit(&queue->_tail, tail + 1, memory_order_release);           \
+    return true;                                                                    \
+}                                                                                   \
+                                                                                    \
+bool sgl_spsc_queue_try_pop_##T(sgl_spsc_queue(T)* queue, T* out)                   \
+{                                                                                   \
+    size_t head = atomic_load_explicit(&queue->_head, memory_order_relaxed);        \
+    if (head == queue->_tail_cache)                                                 \
+    {                                                                               \
+        queue->_tail_cache = atomic_load_explicit(&queue->_tail,                    \
+                                                  memory_order_acquire);            \
+        if (head == queue->_tail_cache)                                             \
+        {                                                                           \
+            return false;                                                           \
+        }                                                                           \
+    }                                                                               \
+    *out = queue->_data[head & queue->_mask];                                       \
+    atomic_store_explicit(&queue->_head, head + 1, memory_order_release);           \
+    return true;                                                                    \
+}                                                                                   \
+                                                                                    \
+const sgl_detail_spsc_queue_functions_##T sgl_detail_spsc_queue_funcs_##T = {       \
+    &sgl_spsc_queue_delete_##T,                                                     \
+    &sgl_spsc_queue_destroy_##T,                                                    \
+    &sgl_spsc_queue_is_empty_##T,                                                   \
+    &sgl_spsc_queue_size_##T,                                                       \
+    &sgl_spsc_queue_capacity_##T,                                                   \
+    &sgl_spsc_queue_try_push_##T,                                                   \
+    &sgl_spsc_queue_try_pop_##T,                                                    \
+    &sgl_spsc_queue_push_n_##T,                                                     \
+    &sgl_spsc_queue_pop_n_##T,                                                      \
+    { 0 }                                                                           \
+};                                                                                  \
+                                                                                    \
+/* Allocates a buffer of at least the given capacity, which is rounded */           \
+/* up to a power of 2 and stored back into capacity */                              \
+static inline T* sgl_detail_spsc_queue_buffer_##T(size_t* capacity,                 \
+                                                  const sgl_allocator* allocator)   \
+{                                                                                   \
+    size_t size = 2;                                                                \
+    while (size < *capacity)                                                        \
+    {                                                                               \
+        if (size > SIZE_MAX / (2 * sizeof(T)))                                      \
+        {                                                                           \
+            sgl_throw(sgl_length_error);                                            \
+        }                                                                           \
+        size *= 2;                                                                  \
+    }                                                                               \
+    T* data = sgl_detail_allocate(allocator, size * sizeof(T), alignof(T));         \
+    if (not data)                                                                   \
+    {                                                                               \
+        sgl_throw(sgl_bad_alloc);                                                   \
+    }                                                                               \
+    *capacity = size;                                                               \
+    return data;                                                                    \
+}                                                                                   \
+                                                                                    \
+static inline void sgl_detail_init_spsc_queue_##T(sgl_spsc_queue(T)* queue,         \
+                                                  T* data, size_t capacity,         \
+                                                  const sgl_allocator* allocator)   \
+{                                                                                   \
+    queue->_functions = &sgl_detail_spsc_queue_funcs_##T;                           \
+    queue->_allocator = allocator;                                                  \
+    queue->_data = data;                                                            \
+    queue->_mask = capacity - 1;                                                    \
+    atomic_init(&queue->_head, 0);                                                  \
+    atomic_init(&queue->_tail, 0);                                                  \
+    queue->_head_cache = 0;                                                         \
+    queue->_tail_cache = 0;                                                         \
+}                                                                                   \
+                                                                                    \
+static inline sgl_spsc_queue(T)*                                                    \
+sgl_detail_new_spsc_queue_##T(size_t capacity, const sgl_allocator* allocator)      \
+{                                                                                   \
+    T* data = sgl_detail_spsc_queue_buffer_##T(&capacity, allocator);               \
+    sgl_spsc_queue(T)* res = sgl_detail_allocate(allocator,                         \
+                                                 sizeof(sgl_spsc_queue(T)),         \
+                                                 alignof(sgl_spsc_queue(T)));       \
+    if (not res)                                                                    \
+    {                                                                               \
+        sgl_detail_deallocate(allocator, data, capacity * sizeof(T));               \
+        sgl_throw(sgl_bad_alloc);                                                   \
+    }                                                                               \
+    sgl_detail_init_spsc_queue_##T(res, data, capacity, allocator);                 \
+    return res;                                                                     \
+}                                                                                   \
+                                                                                    \
+void sgl_init_with_allocator_sgl_spsc_queue_##T(sgl_spsc_queue(T)* queue,           \
+                                                const sgl_allocator* allocator)     \
+{                                                                                   \
+    size_t capacity = SGL_SPSC_QUEUE_CAPACITY;                                      \
+    T* data = sgl_detail_spsc_queue_buffer_##T(&capacity, allocator);               \
+    sgl_detail_init_spsc_queue_##T(queue, data, capacity, allocator);               \
+}                                                                                   \
+                                                                                    \
+void sgl_init_sgl_spsc_queue_##T(sgl_spsc_queue(T)* queue)                          \
+{                                                                                   \
+    sgl_init_with_allocator_sgl_spsc_queue_##T(queue, NULL);                        \
+}                                                                                   \
+                                                                                    \
+sgl_spsc_queue(T)* sgl_new_with_capacity_sgl_spsc_queue_##T(size_t capacity)        \
+{                                                                                   \
+    return sgl_detail_new_spsc_queue_##T(capacity, NULL);                           \
+}                                                                                   \
+                                                                                    \
+sgl_spsc_queue(T)*                                                                  \
+sgl_new_with_allocator_sgl_spsc_queue_##T(const sgl_allocator* allocator)           \
+{                                                                                   \
+    return sgl_detail_new_spsc_queue_##T(SGL_SPSC_QUEUE_CAPACITY, allocator);       \
+}                                                                                   \
+                                                                                    \
+sgl_spsc_queue(T)* sgl_new_sgl_spsc_queue_##T()                                     \
+{                                                                                   \
+    return sgl_detail_new_spsc_queue_##T(SGL_SPSC_QUEUE_CAPACITY, NULL);            \
+}
+
+#endif // SGL_SPSC_QUEUE_H_
@@ -0,0 +1,42 @@
+/*
+ * Copyright (C) 2015 Morwenn
+ *
+ * The SGL is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * The SGL is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program. If not,
+ * see <http://www.gnu.org/licenses/>.
+ */
+#ifndef SGL_THREAD_CONCURRENCY_H_
+#define SGL_THREAD_CONCURRENCY_H_
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <stddef.h>
+#include <sgl/detail/common.h>
+
+/**
+ * Returns the number of processors available to the program, or
+ * 1 when it can not be known.
+ */
+size_t sgl_hardware_concurrency(void);
+
+/**
+ * Calls func(args + i * arg_size) for every i in [0, count) and
+ * returns once all the calls have returned. The first call runs in
+ * the calling thread and the other ones in new threads; the calls
+ * for which no thread could be created run in the calling thread.
+ */
+void sgl_detail_parallel_invoke(size_t count, int (*func)(void*),
+                                void* args, size_t arg_size);
+
+#endif // SGL_THREAD_CONCURRENCY_H_
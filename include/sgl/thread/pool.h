@@ -0,0 +1,120 @@
+/*
+ * Copyright (C) 2015 Morwenn
+ *
+ * The SGL is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * The SGL is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program. If not,
+ * see <http://www.gnu.org/licenses/>.
+ */
+#ifndef SGL_THREAD_POOL_H_
+#define SGL_THREAD_POOL_H_
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <stdatomic.h>
+#include <stddef.h>
+#include <sgl/exception.h>
+#include <sgl/detail/common.h>
+
+////////////////////////////////////////////////////////////
+// Types
+
+/**
+ * @brief Work-stealing thread pool.
+ *
+ * Every worker thread owns a Chase-Lev deque: it pushes and pops
+ * the tasks it spawns at the bottom, in last-in first-out order,
+ * while idle workers steal the oldest tasks from the top of the
+ * deque of a random victim. Tasks spawned by threads which are not
+ * workers of the pool go to a shared queue. Workers which find no
+ * task for a while park on a condition variable until new tasks
+ * are spawned or the pool is deleted.
+ *
+ * The pool is defined in thread_pool.c and only used through
+ * pointers.
+ */
+typedef struct sgl_thread_pool sgl_thread_pool;
+
+/**
+ * @brief Group of tasks which can be waited for together.
+ *
+ * Tasks are spawned in a group with sgl_spawn and sgl_wait returns
+ * once every task of the group, including the ones spawned after
+ * the call started, has completed. Waiting workers run pending
+ * tasks of the pool instead of blocking, which lets a task spawn
+ * subtasks and wait for them without exhausting the workers.
+ */
+typedef struct
+{
+    sgl_thread_pool* _pool;
+    atomic_size_t _pending;
+} sgl_task_group;
+
+////////////////////////////////////////////////////////////
+// Thread pool
+
+/**
+ * Creates a thread pool with the given number of worker threads,
+ * or one worker per processor when it is 0. Throws sgl_bad_alloc
+ * when the pool can not be allocated and sgl_runtime_error when no
+ * thread can be created.
+ */
+sgl_thread_pool* sgl_thread_pool_new(size_t threads);
+
+/**
+ * Stops the worker threads and frees the pool. Every task group
+ * of the pool must have been waited for.
+ */
+void sgl_thread_pool_delete(sgl_thread_pool* pool);
+
+/**
+ * Returns a pool with one worker per processor, shared by the
+ * parallel algorithms of the library. It is created by the first
+ * call and never deleted. Returns NULL when it can not be created.
+ */
+sgl_thread_pool* sgl_default_thread_pool(void);
+
+/**
+ * Returns the number of worker threads of the pool.
+ */
+size_t sgl_thread_pool_size(const sgl_thread_pool* pool);
+
+////////////////////////////////////////////////////////////
+// Task groups
+
+/**
+ * Initializes an empty task group whose tasks run on the given
+ * pool. A task group needs no destruction.
+ */
+static inline void sgl_task_group_init(sgl_task_group* group,
+                                       sgl_thread_pool* pool)
+{
+    group->_pool = pool;
+    atomic_init(&group->_pending, 0);
+}
+
+/**
+ * Schedules func(arg) to run on the pool of the group. When the
+ * deque of the calling worker is full, the task is run right away
+ * by the calling thread instead. Exceptions must not escape func.
+ */
+void sgl_spawn(sgl_task_group* group, void (*func)(void*), void* arg);
+
+/**
+ * Returns once every task spawned in the group has completed. A
+ * worker of the pool runs pending tasks meanwhile, any other thread
+ * blocks.
+ */
+void sgl_wait(sgl_task_group* group);
+
+#endif // SGL_THREAD_POOL_H_
@@ -0,0 +1,290 @@
+/*
+ * Copyright (C) 2015 Morwenn
+ *
+ * The SGL is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * The SGL is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program. If not,
+ * see <http://www.gnu.org/licenses/>.
+ */
+#ifndef SGL_UNORDERED_MAP_H_
+#define SGL_UNORDERED_MAP_H_
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sgl/collection.h>
+#include <sgl/exception.h>
+#include <sgl/memory/allocator.h>
+#include <sgl/detail/common.h>
+#include <sgl/detail/hash_table.h>
+
+/**
+ * @def sgl_unordered_map(K, V)
+ *
+ * Alias for the sgl_unordered_map_K_V type.
+ */
+#define sgl_unordered_map(K, V) \
+    sgl_unordered_map_##K##_##V
+
+/**
+ * @def sgl_define_sgl_unordered_map(K, V)
+ * Creates all the methods for a sgl_unordered_map of given key
+ * and value types.
+ */
+#define sgl_define_sgl_unordered_map(K, V)                                          \
+    sgl_declare_sgl_unordered_map(K, V)                                             \
+    sgl_instantiate_sgl_unordered_map(K, V)
+
+/**
+ * @def sgl_declare_sgl_unordered_map(K, V)
+ * Declares the type and the methods of a sgl_unordered_map of
+ * given key and value types. It can appear in a header included by
+ * several translation units, provided exactly one of them
+ * instantiates the type.
+ *
+ * The map is an open-addressing hash table: sgl_insert(map, key,
+ * value) and sgl_find(map, key) return a pointer to the value
+ * associated to key, or NULL for sgl_find if the key is not in the
+ * map, and sgl_erase(map, key) returns whether a key was erased.
+ * The pointers are invalidated by insertions and erasures.
+ */
+#define sgl_declare_sgl_unordered_map(K, V)                                         \
+                                                                                    \
+    typedef struct sgl_detail_unordered_map_##K##_##V sgl_unordered_map(K, V);      \
+                                                                                    \
+    typedef K sgl_unordered_map_##K##_##V##_key_type;                               \
+    typedef V sgl_unordered_map_##K##_##V##_mapped_type;                            \
+    typedef size_t sgl_unordered_map_##K##_##V##_size_type;                         \
+                                                                                    \
+    typedef struct                                                                  \
+    {                                                                               \
+        K key;                                                                      \
+        V value;                                                                    \
+    } sgl_unordered_map_##K##_##V##_value_type;                                     \
+                                                                                    \
+    typedef struct                                                                  \
+    {                                                                               \
+        void (*delete)(sgl_unordered_map(K, V)*);                                   \
+        void (*destroy)(sgl_unordered_map(K, V)*);                                  \
+        bool (*is_empty)(const sgl_unordered_map(K, V)*);                           \
+        size_t (*size)(const sgl_unordered_map(K, V)*);                             \
+        size_t (*max_size)(void);                                                   \
+        void (*reserve)(sgl_unordered_map(K, V)*, size_t);                          \
+        void (*rehash)(sgl_unordered_map(K, V)*, size_t);                           \
+        size_t (*capacity)(const sgl_unordered_map(K, V)*);                         \
+        void (*clear)(sgl_unordered_map(K, V)*);                                    \
+        V* (*find)(const sgl_unordered_map(K, V)*, K);                              \
+        V* (*insert2)(sgl_unordered_map(K, V)*, K, V);                              \
+        bool (*erase1)(sgl_unordered_map(K, V)*, K);                                \
+        sgl_detail_opaque_layout _layout;                                           \
+    } sgl_detail_unordered_map_functions_##K##_##V;                                 \
+                                                                                    \
+    struct sgl_detail_unordered_map_##K##_##V                                       \
+    {                                                                               \
+        int8_t* _ctrl;                                                              \
+        sgl_unordered_map_##K##_##V##_value_type* _slots;                           \
+        size_t _size;                                                               \
+        size_t _capacity;                                                           \
+        const sgl_allocator* _allocator;                                            \
+        const sgl_detail_unordered_map_functions_##K##_##V* _functions;             \
+    };                                                                              \
+                                                                                    \
+sgl_unordered_map(K, V)* sgl_new_sgl_unordered_map_##K##_##V();                     \
+sgl_unordered_map(K, V)* sgl_new_with_capacity_sgl_unordered_map_##K##_##V(size_t); \
+sgl_unordered_map(K, V)*                                                            \
+sgl_new_with_allocator_sgl_unordered_map_##K##_##V(const sgl_allocator*);           \
+void sgl_init_sgl_unordered_map_##K##_##V(sgl_unordered_map(K, V)*);                \
+void sgl_init_with_allocator_sgl_unordered_map_##K##_##V(sgl_unordered_map(K, V)*,  \
+                                                         const sgl_allocator*);     \
+void sgl_unordered_map_delete_##K##_##V(sgl_unordered_map(K, V)*);                  \
+void sgl_unordered_map_destroy_##K##_##V(sgl_unordered_map(K, V)*);                 \
+bool sgl_unordered_map_is_empty_##K##_##V(const sgl_unordered_map(K, V)*);          \
+size_t sgl_unordered_map_size_##K##_##V(const sgl_unordered_map(K, V)*);            \
+size_t sgl_unordered_map_max_size_##K##_##V(void);                                  \
+void sgl_unordered_map_reserve_##K##_##V(sgl_unordered_map(K, V)*, size_t);         \
+void sgl_unordered_map_rehash_##K##_##V(sgl_unordered_map(K, V)*, size_t);          \
+size_t sgl_unordered_map_capacity_##K##_##V(const sgl_unordered_map(K, V)*);        \
+void sgl_unordered_map_clear_##K##_##V(sgl_unordered_map(K, V)*);                   \
+V* sgl_unordered_map_find_##K##_##V(const sgl_unordered_map(K, V)*, K);             \
+V* sgl_unordered_map_insert2_##K##_##V(sgl_unordered_map(K, V)*, K, V);             \
+bool sgl_unordered_map_erase1_##K##_##V(sgl_unordered_map(K, V)*, K);               \
+                                                                                    \
+extern const sgl_detail_unordered_map_functions_##K##_##V                           \
+    sgl_detail_unordered_map_funcs_##K##_##V;
+
+/**
+ * @def sgl_instantiate_sgl_unordered_map(K, V)
+ * Defines the methods of a sgl_unordered_map of given key and
+ * value types, which must have been declared beforehand. It shall
+ * appear in exactly one translation unit.
+ */
+#define sgl_instantiate_sgl_unordered_map(K, V)                                     \
+                                                                                    \
+sgl_detail_instantiate_hash_table(unordered_map_##K##_##V,                          \
+                                  sgl_unordered_map_##K##_##V##_value_type,         \
+                                  K, SGL_UNORDERED_HASH, SGL_UNORDERED_EQUAL)       \
+                                                                                    \
+void sgl_unordered_map_delete_##K##_##V(sgl_unordered_map(K, V)* map)               \
+{                                                                                   \
+    sgl_unordered_map_destroy_##K##_##V(map);                                       \
+    sgl_detail_deallocate(map->_allocator, map, sizeof(sgl_unordered_map(K, V)));   \
+}                                                                                   \
+                                                                                    \
+void sgl_unordered_map_destroy_##K##_##V(sgl_unordered_map(K, V)* map)              \
+{                                                                                   \
+    sgl_detail_unordered_map_##K##_##V##_destroy_slots(map);                        \
+}                                                                                   \
+                                                                                    \
+bool sgl_unordered_map_is_empty_##K##_##V(const sgl_unordered_map(K, V)* map)       \
+{                                                                                   \
+    return map->_size == 0;                                                         \
+}                                                                                   \
+                                                                                    \
+size_t sgl_unordered_map_size_##K##_##V(const sgl_unordered_map(K, V)* map)         \
+{                                                                                   \
+    return map->_size;                                                              \
+}                                                                                   \
+                                                                                    \
+size_t sgl_unordered_map_max_size_##K##_##V(void)                                   \
+{                                                                                   \
+    size_t slot_size = sizeof(sgl_unordered_map_##K##_##V##_value_type) + 1;        \
+    return sgl_detail_hash_table_max_load(SIZE_MAX / slot_size);                    \
+}                                                                                   \
+                                                                                    \
+void sgl_unordered_map_reserve_##K##_##V(sgl_unordered_map(K, V)* map,              \
+                                         size_t count)                              \
+{                                                                                   \
+    sgl_detail_unordered_map_##K##_##V##_reserve(map, count);                       \
+}                                                                                   \
+                                                                                    \
+void sgl_unordered_map_rehash_##K##_##V(sgl_unordered_map(K, V)* map,               \
+                                        size_t count)                               \
+{                                                                                   \
+    sgl_detail_unordered_map_##K##_##V##_rehash(map, count);                        \
+}                                                                                   \
+                                                                                    \
+size_t sgl_unordered_map_capacity_##K##_##V(const sgl_unordered_map(K, V)* map)     \
+{                                                                                   \
+    return map->_capacity;                                                          \
+}                                                                                   \
+                                                                                    \
+void sgl_unordered_map_clear_##K##_##V(sgl_unordered_map(K, V)* map)                \
+{                                                                                   \
+    sgl_detail_unordered_map_##K##_##V##_clear(map);                                \
+}                                                                                   \
+                                                                                    \
+V* sgl_unordered_map_find_##K##_##V(const sgl_unordered_map(K, V)* map, K key)      \
+{                                                                                   \
+    size_t index = sgl_detail_unordered_map_##K##_##V##_find(                       \
+        map, &key, SGL_UNORDERED_HASH(&key));                                       \
+    return index == SIZE_MAX ? NULL : &map->_slots[index].value;                    \
+}                                                                                   \
+                                                                                    \
+V* sgl_unordered_map_insert2_##K##_##V(sgl_unordered_map(K, V)* map,                \
+                                       K key, V value)                              \
+{                                                                                   \
+    bool inserted;                                                                  \
+    size_t index = sgl_detail_unordered_map_##K##_##V##_prepare_insert(             \
+        map, &key, &inserted);                                                      \
+    if (inserted)                                                                   \
+    {                                                                               \
+        map->_slots[index].key = key;                                               \
+        map->_slots[index].value = value;                                           \
+    }                                                                               \
+    return &map->_slots[index].value;                                               \
+}                                                                                   \
+                                                                                    \
+bool sgl_unordered_map_erase1_##K##_##V(sgl_unordered_map(K, V)* map, K key)        \
+{                                                                                   \
+    size_t index = sgl_detail_unordered_map_##K##_##V##_find(                       \
+        map, &key, SGL_UNORDERED_HASH(&key));                                       \
+    if (index == SIZE_MAX)                                                          \
+    {                                                                               \
+        return false;                                                               \
+    }                                                                               \
+    sgl_detail_unordered_map_##K##_##V##_erase_at(map, index);                      \
+    return true;                                                                    \
+}                                                                                   \
+                                                                                    \
+const sgl_detail_unordered_map_functions_##K##_##V                                  \
+    sgl_detail_unordered_map_funcs_##K##_##V = {                                    \
+    &sgl_unordered_map_delete_##K##_##V,                                            \
+    &sgl_unordered_map_destroy_##K##_##V,                                           \
+    &sgl_unordered_map_is_empty_##K##_##V,                                          \
+    &sgl_unordered_map_size_##K##_##V,                                              \
+    &sgl_unordered_map_max_size_##K##_##V,                                          \
+    &sgl_unordered_map_reserve_##K##_##V,                                           \
+    &sgl_unordered_map_rehash_##K##_##V,                                            \
+    &sgl_unordered_map_capacity_##K##_##V,                                          \
+    &sgl_unordered_map_clear_##K##_##V,                                             \
+    &sgl_unordered_map_find_##K##_##V,                                              \
+    &sgl_unordered_map_insert2_##K##_##V,                                           \
+    &sgl_unordered_map_erase1_##K##_##V,                                            \
+    { 0 }                                                                           \
+};                                                                                  \
+                                                                                    \
+void sgl_init_with_allocator_sgl_unordered_map_##K##_##V(                           \
+    sgl_unordered_map(K, V)* map, const sgl_allocator* allocator)                   \
+{                                                                                   \
+    map->_functions = &sgl_detail_unordered_map_funcs_##K##_##V;                    \
+    map->_allocator = allocator;                                                    \
+    map->_ctrl = NULL;                                                              \
+    map->_slots = NULL;                                                             \
+    map->_size = 0;                                                                 \
+    map->_capacity = 0;                                                             \
+}                                                                                   \
+                                                                                    \
+void sgl_init_sgl_unordered_map_##K##_##V(sgl_unordered_map(K, V)* map)             \
+{                                                                                   \
+    sgl_init_with_allocator_sgl_unordered_map_##K##_##V(map, NULL);                 \
+}                                                                                   \
+                                                                                    \
+static inline sgl_unordered_map(K, V)*                                              \
+sgl_detail_new_unordered_map_##K##_##V(size_t count,                                \
+                                        const sgl_allocator* allocator)             \
+{                                                                                   \
+    sgl_unordered_map(K, V) map;                                                    \
+    sgl_init_with_allocator_sgl_unordered_map_##K##_##V(&map, allocator);           \
+    sgl_unordered_map_reserve_##K##_##V(&map, count);                               \
+    sgl_unordered_map(K, V)* res = sgl_detail_allocate(                             \
+        allocator, sizeof(sgl_unordered_map(K, V)),                                 \
+        alignof(sgl_unordered_map(K, V)));                                          \
+    if (not res)                                                                    \
+    {                                                                               \
+        sgl_unordered_map_destroy_##K##_##V(&map);                                  \
+        sgl_throw(sgl_bad_alloc);                                                   \
+    }                                                                               \
+    *res = map;                                                                     \
+    return res;                                                                     \
+}                                                                                   \
+                                                                                    \
+sgl_unordered_map(K, V)*                                                            \
+sgl_new_with_capacity_sgl_unordered_map_##K##_##V(size_t count)                     \
+{                                                                                   \
+    return sgl_detail_new_unordered_map_##K##_##V(count, NULL);                     \
+}                                                                                   \
+                                                                                    \
+sgl_unordered_map(K, V)*                                                            \
+sgl_new_with_allocator_sgl_unordered_map_##K##_##V(const sgl_allocator* allocator)  \
+{                                                                                   \
+    return sgl_detail_new_unordered_map_##K##_##V(0, allocator);                    \
+}                                                                                   \
+                                                                                    \
+sgl_unordered_map(K, V)* sgl_new_sgl_unordered_map_##K##_##V()                      \
+{                                                                                   \
+    return sgl_detail_new_unordered_map_##K##_##V(0, NULL);                         \
+}
+
+#endif // SGL_UNORDERED_MAP_H_
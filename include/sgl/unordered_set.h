@@ -0,0 +1,286 @@
+/*
+ * Copyright (C) 2015 Morwenn
+ *
+ * The SGL is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * The SGL is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program. If not,
+ * see <http://www.gnu.org/licenses/>.
+ */
+#ifndef SGL_UNORDERED_SET_H_
+#define SGL_UNORDERED_SET_H_
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sgl/collection.h>
+#include <sgl/exception.h>
+#include <sgl/memory/allocator.h>
+#include <sgl/detail/common.h>
+#include <sgl/detail/hash_table.h>
+
+/**
+ * @def sgl_unordered_set(K)
+ *
+ * Alias for the sgl_unordered_set_K type.
+ */
+#define sgl_unordered_set(K) \
+    sgl_unordered_set_##K
+
+/**
+ * @def sgl_define_sgl_unordered_set(K)
+ * Creates all the methods for a sgl_unordered_set of given key
+ * type.
+ */
+#define sgl_define_sgl_unordered_set(K)                                             \
+    sgl_declare_sgl_unordered_set(K)                                                \
+    sgl_instantiate_sgl_unordered_set(K)
+
+/**
+ * @def sgl_declare_sgl_unordered_set(K)
+ * Declares the type and the methods of a sgl_unordered_set of
+ * given key type. It can appear in a header included by several
+ * translation units, provided exactly one of them instantiates
+ * the type.
+ *
+ * The set is an open-addressing hash table: sgl_insert(set, key)
+ * returns whether key was inserted, sgl_find(set, key) returns a
+ * pointer to the key in the set or NULL, and sgl_erase(set, key)
+ * returns whether a key was erased. The pointers are invalidated
+ * by insertions and erasures.
+ */
+#define sgl_declare_sgl_unordered_set(K)                                            \
+                                                                                    \
+    typedef struct sgl_detail_unordered_set_##K sgl_unordered_set(K);               \
+                                                                                    \
+    typedef K sgl_unordered_set_##K##_key_type;                                     \
+    typedef size_t sgl_unordered_set_##K##_size_type;                               \
+                                                                                    \
+    typedef struct                                                                  \
+    {                                                                               \
+        K key;                                                                      \
+    } sgl_unordered_set_##K##_value_type;                                           \
+                                                                                    \
+    typedef struct                                                                  \
+    {                                                                               \
+        void (*delete)(sgl_unordered_set(K)*);                                      \
+        void (*destroy)(sgl_unordered_set(K)*);                                     \
+        bool (*is_empty)(const sgl_unordered_set(K)*);                              \
+        size_t (*size)(const sgl_unordered_set(K)*);                                \
+        size_t (*max_size)(void);                                                   \
+        void (*reserve)(sgl_unordered_set(K)*, size_t);                             \
+        void (*rehash)(sgl_unordered_set(K)*, size_t);                              \
+        size_t (*capacity)(const sgl_unordered_set(K)*);                            \
+        void (*clear)(sgl_unordered_set(K)*);                                       \
+        const K* (*find)(const sgl_unordered_set(K)*, K);                           \
+        bool (*insert1)(sgl_unordered_set(K)*, K);                                  \
+        bool (*erase1)(sgl_unordered_set(K)*, K);                                   \
+        sgl_detail_opaque_layout _layout;                                           \
+    } sgl_detail_unordered_set_functions_##K;                                       \
+                                                                                    \
+    struct sgl_detail_unordered_set_##K                                             \
+    {                                                                               \
+        int8_t* _ctrl;                                                              \
+        sgl_unordered_set_##K##_value_type* _slots;                                 \
+        size_t _size;                                                               \
+        size_t _capacity;                                                           \
+        const sgl_allocator* _allocator;                                            \
+        const sgl_detail_unordered_set_functions_##K* _functions;                   \
+    };                                                                              \
+                                                                                    \
+sgl_unordered_set(K)* sgl_new_sgl_unordered_set_##K();                              \
+sgl_unordered_set(K)* sgl_new_with_capacity_sgl_unordered_set_##K(size_t);          \
+sgl_unordered_set(K)*                                                               \
+sgl_new_with_allocator_sgl_unordered_set_##K(const sgl_allocator*);                 \
+void sgl_init_sgl_unordered_set_##K(sgl_unordered_set(K)*);                         \
+void sgl_init_with_allocator_sgl_unordered_set_##K(sgl_unordered_set(K)*,           \
+                                                         const sgl_allocator*);     \
+void sgl_unordered_set_delete_##K(sgl_unordered_set(K)*);                           \
+void sgl_unordered_set_destroy_##K(sgl_unordered_set(K)*);                          \
+bool sgl_unordered_set_is_empty_##K(const sgl_unordered_set(K)*);                   \
+size_t sgl_unordered_set_size_##K(const sgl_unordered_set(K)*);                     \
+size_t sgl_unordered_set_max_size_##K(void);                                        \
+void sgl_unordered_set_reserve_##K(sgl_unordered_set(K)*, size_t);                  \
+void sgl_unordered_set_rehash_##K(sgl_unordered_set(K)*, size_t);                   \
+size_t sgl_unordered_set_capacity_##K(const sgl_unordered_set(K)*);                 \
+void sgl_unordered_set_clear_##K(sgl_unordered_set(K)*);                            \
+const K* sgl_unordered_set_find_##K(const sgl_unordered_set(K)*, K);                \
+bool sgl_unordered_set_insert1_##K(sgl_unordered_set(K)*, K);                       \
+bool sgl_unordered_set_erase1_##K(sgl_unordered_set(K)*, K);                        \
+                                                                                    \
+extern const sgl_detail_unordered_set_functions_##K                                 \
+    sgl_detail_unordered_set_funcs_##K;
+
+/**
+ * @def sgl_instantiate_sgl_unordered_set(K)
+ * Defines the methods of a sgl_unordered_set of given key type,
+ * which must have been declared beforehand. It shall appear in
+ * exactly one translation unit.
+ */
+#define sgl_instantiate_sgl_unordered_set(K)                                        \
+                                                                                    \
+sgl_detail_instantiate_hash_table(unordered_set_##K,                                \
+                                  sgl_unordered_set_##K##_value_type,               \
+                                  K, SGL_UNORDERED_HASH, SGL_UNORDERED_EQUAL)       \
+                                                                                    \
+void sgl_unordered_set_delete_##K(sgl_unordered_set(K)* set)                        \
+{                                                                                   \
+    sgl_unordered_set_destroy_##K(set);                                             \
+    sgl_detail_deallocate(set->_allocator, set, sizeof(sgl_unordered_set(K)));      \
+}                                                                                   \
+                                                                                    \
+void sgl_unordered_set_destroy_##K(sgl_unordered_set(K)* set)                       \
+{                                                                                   \
+    sgl_detail_unordered_set_##K##_destroy_slots(set);                              \
+}                                                                                   \
+                                                                                    \
+bool sgl_unordered_set_is_empty_##K(const sgl_unordered_set(K)* set)                \
+{                                                                                   \
+    return set->_size == 0;                                                         \
+}                                                                                   \
+                                                                                    \
+size_t sgl_unordered_set_size_##K(const sgl_unordered_set(K)* set)                  \
+{                                                                                   \
+    return set->_size;                                                              \
+}                                                                                   \
+                                                                                    \
+size_t sgl_unordered_set_max_size_##K(void)                                         \
+{                                                                                   \
+    size_t slot_size = sizeof(sgl_unordered_set_##K##_value_type) + 1;              \
+    return sgl_detail_hash_table_max_load(SIZE_MAX / slot_size);                    \
+}                                                                                   \
+                                                                                    \
+void sgl_unordered_set_reserve_##K(sgl_unordered_set(K)* set,                       \
+                                         size_t count)                              \
+{                                                                                   \
+    sgl_detail_unordered_set_##K##_reserve(set, count);                             \
+}                                                                                   \
+                                                                                    \
+void sgl_unordered_set_rehash_##K(sgl_unordered_set(K)* set,                        \
+                                        size_t count)                               \
+{                                                                                   \
+    sgl_detail_unordered_set_##K##_rehash(set, count);                              \
+}                                                                                   \
+                                                                                    \
+size_t sgl_unordered_set_capacity_##K(const sgl_unordered_set(K)* set)              \
+{                                                                                   \
+    return set->_capacity;                                                          \
+}                                                                                   \
+                                                                                    \
+void sgl_unordered_set_clear_##K(sgl_unordered_set(K)* set)                         \
+{                                                                                   \
+    sgl_detail_unordered_set_##K##_clear(set);                                      \
+}                                                                                   \
+                                                                                    \
+const K* sgl_unordered_set_find_##K(const sgl_unordered_set(K)* set, K key)         \
+{                                                                                   \
+    size_t index = sgl_detail_unordered_set_##K##_find(                             \
+        set, &key, SGL_UNORDERED_HASH(&key));                                       \
+    return index == SIZE_MAX ? NULL : &set->_slots[index].key;                      \
+}                                                                                   \
+                                                                                    \
+bool sgl_unordered_set_insert1_##K(sgl_unordered_set(K)* set, K key)                \
+{                                                                                   \
+    bool inserted;                                                                  \
+    size_t index = sgl_detail_unordered_set_##K##_prepare_insert(                   \
+        set, &key, &inserted);                                                      \
+    if (inserted)                                                                   \
+    {                                                                               \
+        set->_slots[index].key = key;                                               \
+    }                                                                               \
+    return inserted;                                                                \
+}                                                                                   \
+                                                                                    \
+bool sgl_unordered_set_erase1_##K(sgl_unordered_set(K)* set, K key)                 \
+{                                                                                   \
+    size_t index = sgl_detail_unordered_set_##K##_find(                             \
+        set, &key, SGL_UNORDERED_HASH(&key));                                       \
+    if (index == SIZE_MAX)                                                          \
+    {                                                                               \
+        return false;                                                               \
+    }                                                                               \
+    sgl_detail_unordered_set_##K##_erase_at(set, index);                            \
+    return true;                                                                    \
+}                                                                                   \
+                                                                                    \
+const sgl_detail_unordered_set_functions_##K                                        \
+    sgl_detail_unordered_set_funcs_##K = {                                          \
+    &sgl_unordered_set_delete_##K,                                                  \
+    &sgl_unordered_set_destroy_##K,                                                 \
+    &sgl_unordered_set_is_empty_##K,                                                \
+    &sgl_unordered_set_size_##K,                                                    \
+    &sgl_unordered_set_max_size_##K,                                                \
+    &sgl_unordered_set_reserve_##K,                                                 \
+    &sgl_unordered_set_rehash_##K,                                                  \
+    &sgl_unordered_set_capacity_##K,                                                \
+    &sgl_unordered_set_clear_##K,                                                   \
+    &sgl_unordered_set_find_##K,                                                    \
+    &sgl_unordered_set_insert1_##K,                                                 \
+    &sgl_unordered_set_erase1_##K,                                                  \
+    { 0 }                                                                           \
+};                                                                                  \
+                                                                                    \
+void sgl_init_with_allocator_sgl_unordered_set_##K(                                 \
+    sgl_unordered_set(K)* set, const sgl_allocator* allocator)                      \
+{                                                                                   \
+    set->_functions = &sgl_detail_unordered_set_funcs_##K;                          \
+    set->_allocator = allocator;                                                    \
+    set->_ctrl = NULL;                                                              \
+    set->_slots = NULL;                                                             \
+    set->_size = 0;                                                                 \
+    set->_capacity = 0;                                                             \
+}                                                                                   \
+                                                                                    \
+void sgl_init_sgl_unordered_set_##K(sgl_unordered_set(K)* set)                      \
+{                                                                                   \
+    sgl_init_with_allocator_sgl_unordered_set_##K(set, NULL);                       \
+}                                                                                   \
+                                                                                    \
+static inline sgl_unordered_set(K)*                                                 \
+sgl_detail_new_unordered_set_##K(size_t count,                                      \
+                                        const sgl_allocator* allocator)             \
+{                                                                                   \
+    sgl_unordered_set(K) set;                                                       \
+    sgl_init_with_allocator_sgl_unordered_set_##K(&set, allocator);                 \
+    sgl_unordered_set_reserve_##K(&set, count);                                     \
+    sgl_unordered_set(K)* res = sgl_detail_allocate(                                \
+        allocator, sizeof(sgl_unordered_set(K)),                                    \
+        alignof(sgl_unordered_set(K)));                                             \
+    if (not res)                                                                    \
+    {                                                                               \
+        sgl_unordered_set_destroy_##K(&set);                                        \
+        sgl_throw(sgl_bad_alloc);                                                   \
+    }                                                                               \
+    *res = set;                                                                     \
+    return res;                                                                     \
+}                                                                                   \
+                                                                                    \
+sgl_unordered_set(K)*                                                               \
+sgl_new_with_capacity_sgl_unordered_set_##K(size_t count)                           \
+{                                                                                   \
+    return sgl_detail_new_unordered_set_##K(count, NULL);                           \
+}                                                                                   \
+                                                                                    \
+sgl_unordered_set(K)*                                                               \
+sgl_new_with_allocator_sgl_unordered_set_##K(const sgl_allocator* allocator)        \
+{                                                                                   \
+    return sgl_detail_new_unordered_set_##K(0, allocator);                          \
+}                                                                                   \
+                                                                                    \
+sgl_unordered_set(K)* sgl_new_sgl_unordered_set_##K()                               \
+{                                                                                   \
+    return sgl_detail_new_unordered_set_##K(0, NULL);                               \
+}
+
+#endif // SGL_UNORDERED_SET_H_
@@ -21,9 +21,14 @@
 ////////////////////////////////////////////////////////////
 // Headers
 ////////////////////////////////////////////////////////////
+#include <sgl/utility/compare.h>
+#include <sgl/utility/declare.h>
 #include <sgl/utility/define.h>
 #include <sgl/utility/delete.h>
+#include <sgl/utility/destroy.h>
 #include <sgl/utility/dispatch.h>
+#include <sgl/utility/init.h>
+#include <sgl/utility/instantiate.h>
 #include <sgl/utility/new.h>
 #include <sgl/utility/paste.h>
 #include <sgl/utility/va_nargs.h>
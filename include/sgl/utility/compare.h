@@ -0,0 +1,49 @@
+/*
+ * Copyright (C) 2015 Morwenn
+ *
+ * The SGL is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * The SGL is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program. If not,
+ * see <http://www.gnu.org/licenses/>.
+ */
+#ifndef SGL_UTILITY_COMPARE_H_
+#define SGL_UTILITY_COMPARE_H_
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <sgl/detail/common.h>
+
+// Comparison macros which can be given by name to the collections
+// and algorithms taking a comparison, for example
+// sgl_priority_queue(int, sgl_greater). Any function or
+// function-like macro taking two elements and returning whether
+// the first one is ordered before the second one can be used
+// instead, as long as its name is a single identifier.
+
+/**
+ * @def sgl_less(lhs, rhs)
+ *
+ * Returns whether lhs < rhs.
+ */
+#define sgl_less(lhs, rhs) \
+    ((lhs) < (rhs))
+
+/**
+ * @def sgl_greater(lhs, rhs)
+ *
+ * Returns whether lhs > rhs.
+ */
+#define sgl_greater(lhs, rhs) \
+    ((lhs) > (rhs))
+
+#endif // SGL_UTILITY_COMPARE_H_
@@ -0,0 +1,37 @@
+/*
+ * Copyright (C) 2015 Morwenn
+ *
+ * The SGL is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * The SGL is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program. If not,
+ * see <http://www.gnu.org/licenses/>.
+ */
+#ifndef SGL_UTILITY_DECLARE_H_
+#define SGL_UTILITY_DECLARE_H_
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <sgl/detail/common.h>
+
+/**
+ * @def sgl_declare(type)
+ *
+ * Declares the given type and its functions without defining
+ * them, provided the type has a conforming declaration macro.
+ * The declaration can be shared by several translation units;
+ * tests/multi_tu shows a header using it with sgl_instantiate.
+ */
+#define sgl_declare(type) \
+    sgl_declare_##type
+
+#endif // SGL_UTILITY_DECLARE_H_
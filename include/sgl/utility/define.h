@@ -27,7 +27,8 @@
  * @def sgl_define(type)
  *
  * Defines all the functions for the given type, provided the
- * type has a confirming definition macro.
+ * type has a confirming definition macro. It is equivalent to
+ * sgl_declare followed by sgl_instantiate.
  */
 #define sgl_define(type) \
     sgl_define_##type
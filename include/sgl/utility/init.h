@@ -0,0 +1,47 @@
+/*
+ * Copyright (C) 2015 Morwenn
+ *
+ * The SGL is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * The SGL is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program. If not,
+ * see <http://www.gnu.org/licenses/>.
+ */
+#ifndef SGL_UTILITY_INIT_H_
+#define SGL_UTILITY_INIT_H_
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <sgl/detail/common.h>
+#include <sgl/utility/paste.h>
+
+/**
+ * @def sgl_init(type, object)
+ *
+ * Initializes an instance of the given type which has already
+ * been allocated, for example on the stack or as a member of
+ * another structure. The instance has to be destroyed with
+ * sgl_destroy instead of sgl_delete.
+ */
+#define sgl_init(type, object) \
+    sgl_paste(sgl_init_, type)(object)
+
+/**
+ * @def sgl_init_with_allocator(type, object, allocator)
+ *
+ * Same as sgl_init, except that the instance gets its memory
+ * from the given sgl_allocator, which must outlive it.
+ */
+#define sgl_init_with_allocator(type, object, allocator) \
+    sgl_paste(sgl_init_with_allocator_, type)(object, allocator)
+
+#endif // SGL_UTILITY_INIT_H_
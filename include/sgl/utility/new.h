@@ -33,4 +33,24 @@
 #define sgl_new(type) \
     sgl_paste(sgl_new_, type)()
 
+/**
+ * @def sgl_new_with_capacity(type, capacity)
+ *
+ * Allocates a new instance of the given type able to hold at
+ * least capacity elements without reallocating, and returns a
+ * pointer to it.
+ */
+#define sgl_new_with_capacity(type, capacity) \
+    sgl_paste(sgl_new_with_capacity_, type)(capacity)
+
+/**
+ * @def sgl_new_with_allocator(type, allocator)
+ *
+ * Allocates a new instance of the given type which gets all of
+ * its memory from the given sgl_allocator, and returns a pointer
+ * to it. The allocator must outlive the instance.
+ */
+#define sgl_new_with_allocator(type, allocator) \
+    sgl_paste(sgl_new_with_allocator_, type)(allocator)
+
 #endif // SGL_UTILITY_NEW_H_
@@ -22,11 +22,32 @@
 // Headers
 ////////////////////////////////////////////////////////////
 #include <limits.h>
+#include <stdint.h>
 #include <stdlib.h>
 #include <string.h>
 #include <sgl/collection.h>
 #include <sgl/exception.h>
+#include <sgl/memory/alignment.h>
+#include <sgl/memory/allocator.h>
+#include <sgl/memory/growth.h>
 #include <sgl/detail/common.h>
+#include <sgl/detail/select_integer.h>
+
+#ifndef SGL_VECTOR_GROWTH_POLICY
+
+    /**
+     * @def SGL_VECTOR_GROWTH_POLICY
+     *
+     * Default growth policy of the sgl_vector types, read when
+     * sgl_define is called. It can be set with the compiler option
+     * -DSGL_VECTOR_GROWTH_POLICY=policy or redefined between two
+     * sgl_define calls to give different policies to different
+     * element types. The policy of a type can also be changed at
+     * runtime with sgl_set_growth_policy.
+     */
+    #define SGL_VECTOR_GROWTH_POLICY sgl_growth_factor_1_5
+
+#endif
 
 /**
  * @def sgl_vector(T)
@@ -36,328 +57,703 @@
 #define sgl_vector(T) \
     sgl_vector_##T
 
+/**
+ * @def sgl_aligned_vector(T, A)
+ *
+ * Alias for the sgl_vector_T_alignedA type, a sgl_vector whose
+ * storage is aligned on A bytes across growth, shrink_to_fit and
+ * assignments, which allows SIMD code to use aligned loads on it.
+ * A must be a power of 2 written as an integer literal and be at
+ * least alignof(T). The alignment is available at compile time
+ * through sgl_alignment.
+ */
+#define sgl_aligned_vector(T, A) \
+    sgl_vector_##T##_aligned##A
+
 /**
  * @def sgl_define_sgl_vector(T)
  * Creates all the methods for a sgl_vector of given type.
  */
 #define sgl_define_sgl_vector(T)                                                    \
+    sgl_declare_sgl_vector(T)                                                       \
+    sgl_instantiate_sgl_vector(T)
+
+/**
+ * @def sgl_declare_sgl_vector(T)
+ * Declares the type and the methods of a sgl_vector of given
+ * type. It can appear in a header included by several translation
+ * units, provided exactly one of them instantiates the type.
+ */
+#define sgl_declare_sgl_vector(T) \
+    sgl_detail_declare_vector(T, T, alignof(T))
+
+/**
+ * @def sgl_instantiate_sgl_vector(T)
+ * Defines the methods of a sgl_vector of given type, which must
+ * have been declared beforehand. It shall appear in exactly one
+ * translation unit.
+ */
+#define sgl_instantiate_sgl_vector(T) \
+    sgl_detail_instantiate_vector(T, T, alignof(T))
+
+/**
+ * @def sgl_define_sgl_aligned_vector(T, A)
+ * Creates all the methods for a sgl_aligned_vector of given type
+ * and alignment.
+ */
+#define sgl_define_sgl_aligned_vector(T, A)                                         \
+    sgl_declare_sgl_aligned_vector(T, A)                                            \
+    sgl_instantiate_sgl_aligned_vector(T, A)
+
+/**
+ * @def sgl_declare_sgl_aligned_vector(T, A)
+ * Same as sgl_declare_sgl_vector for a sgl_aligned_vector.
+ */
+#define sgl_declare_sgl_aligned_vector(T, A) \
+    sgl_detail_declare_vector(T, T##_aligned##A, A)
+
+/**
+ * @def sgl_instantiate_sgl_aligned_vector(T, A)
+ * Same as sgl_instantiate_sgl_vector for a sgl_aligned_vector.
+ */
+#define sgl_instantiate_sgl_aligned_vector(T, A) \
+    sgl_detail_instantiate_vector(T, T##_aligned##A, A)
+
+/**
+ * @def sgl_detail_declare_vector(T, N, A)
+ * Declares the sgl_vector_N type, whose elements of type T are
+ * stored in memory aligned on A bytes.
+ */
+#define sgl_detail_declare_vector(T, N, A)                                          \
                                                                                     \
-    typedef struct sgl_detail_vector_##T sgl_vector(T);                             \
+    static_assert((A) >= alignof(T) && ((A) & ((A) - 1)) == 0,                      \
+                  "invalid alignment for sgl_vector_" #N);                          \
                                                                                     \
-    typedef T sgl_vector_##T##_value_type;                                          \
-    typedef size_t sgl_vector_##T##_size_type;                                      \
-    typedef ptrdiff_t sgl_vector_##T##_difference_type;                             \
-    typedef T* sgl_vector_##T##_iterator;                                           \
-    typedef const T* sgl_vector_##T##_const_iterator;                               \
+    typedef struct sgl_detail_vector_##N sgl_vector(N);                             \
+                                                                                    \
+    typedef T sgl_vector_##N##_value_type;                                          \
+    typedef size_t sgl_vector_##N##_size_type;                                      \
+    typedef ptrdiff_t sgl_vector_##N##_difference_type;                             \
+    typedef T* sgl_vector_##N##_iterator;                                           \
+    typedef const T* sgl_vector_##N##_const_iterator;                               \
+                                                                                    \
+    enum { sgl_vector_##N##_alignment = A };                                        \
                                                                                     \
     typedef struct                                                                  \
     {                                                                               \
-        void (*delete)(sgl_vector(T)*);                                             \
-        T* (*at)(const sgl_vector(T)*, size_t);                                     \
-        T* (*front)(const sgl_vector(T)*);                                          \
-        T* (*back)(const sgl_vector(T)*);                                           \
-        T* (*data)(const sgl_vector(T)*);                                           \
-        T* (*begin)(sgl_vector(T)*);                                                \
-        const T* (*cbegin)(const sgl_vector(T)*);                                   \
-        T* (*end)(sgl_vector(T)*);                                                  \
-        const T* (*cend)(const sgl_vector(T)*);                                     \
-        bool (*is_empty)(const sgl_vector(T)*);                                     \
-        size_t (*size)(const sgl_vector(T)*);                                       \
+        void (*delete)(sgl_vector(N)*);                                             \
+        void (*destroy)(sgl_vector(N)*);                                            \
+        T* (*at)(const sgl_vector(N)*, size_t);                                     \
+        T* (*front)(const sgl_vector(N)*);                                          \
+        T* (*back)(const sgl_vector(N)*);                                           \
+        T* (*data)(const sgl_vector(N)*);                                           \
+        T* (*begin)(sgl_vector(N)*);                                                \
+        const T* (*cbegin)(const sgl_vector(N)*);                                   \
+        T* (*end)(sgl_vector(N)*);                                                  \
+        const T* (*cend)(const sgl_vector(N)*);                                     \
+        bool (*is_empty)(const sgl_vector(N)*);                                     \
+        size_t (*size)(const sgl_vector(N)*);                                       \
         size_t (*max_size)(void);                                                   \
-        void (*reserve)(sgl_vector(T)*, size_t);                                    \
-        size_t (*capacity)(const sgl_vector(T)*);                                   \
-        void (*shrink_to_fit)(sgl_vector(T*));                                      \
-        void (*clear)(sgl_vector(T)*);                                              \
-        void (*erase1)(sgl_vector(T)*, const T*);                                   \
-        void (*erase2)(sgl_vector(T)*, const T*, const T*);                         \
-        void (*push_back)(sgl_vector(T)*, T);                                       \
-        void (*pop_back)(sgl_vector(T)*);                                           \
-        void (*resize1)(sgl_vector(T)*, size_t);                                    \
-        void (*resize2)(sgl_vector(T)*, size_t, T);                                 \
-        bool (*check)(const sgl_vector(T)*,                                         \
-                      const char*,                                                  \
-                      const sgl_vector(T)*);                                        \
-    } sgl_detail_vector_functions_##T;                                              \
-                                                                                    \
-    struct sgl_detail_vector_##T                                                    \
+        void (*reserve)(sgl_vector(N)*, size_t);                                    \
+        sgl_exception_t (*try_reserve)(sgl_vector(N)*, size_t);                     \
+        size_t (*capacity)(const sgl_vector(N)*);                                   \
+        void (*shrink_to_fit)(sgl_vector(N)*);                                      \
+        sgl_exception_t (*try_shrink_to_fit)(sgl_vector(N)*);                       \
+        void (*clear)(sgl_vector(N)*);                                              \
+        void (*erase1)(sgl_vector(N)*, const T*);                                   \
+        void (*erase2)(sgl_vector(N)*, const T*, const T*);                         \
+        T* (*insert2)(sgl_vector(N)*, const T*, T);                                 \
+        T* (*insert3)(sgl_vector(N)*, const T*, size_t, T);                         \
+        T* (*insert_range)(sgl_vector(N)*, const T*, const T*, const T*);           \
+        void (*push_back)(sgl_vector(N)*, T);                                       \
+        sgl_exception_t (*try_push_back)(sgl_vector(N)*, T);                        \
+        void (*pop_back)(sgl_vector(N)*);                                           \
+        void (*resize1)(sgl_vector(N)*, size_t);                                    \
+        void (*resize2)(sgl_vector(N)*, size_t, T);                                 \
+        void (*append)(sgl_vector(N)*, const T*, size_t);                           \
+        void (*assign)(sgl_vector(N)*, size_t, T);                                  \
+        void (*assign_range)(sgl_vector(N)*, const T*, const T*);                   \
+        bool (*equal)(const sgl_vector(N)*, const sgl_vector(N)*);                  \
+        bool (*lexicographical_compare)(const sgl_vector(N)*,                       \
+                                        const sgl_vector(N)*);                      \
+        sgl_detail_contiguous_layout _layout;                                       \
+    } sgl_detail_vector_functions_##N;                                              \
+                                                                                    \
+    struct sgl_detail_vector_##N                                                    \
     {                                                                               \
         T* _data;                                                                   \
         size_t _size;                                                               \
         size_t _capacity;                                                           \
-        const sgl_detail_vector_functions_##T* _functions;                          \
+        const sgl_allocator* _allocator;                                            \
+        const sgl_detail_vector_functions_##N* _functions;                          \
     };                                                                              \
                                                                                     \
-sgl_vector(T)* sgl_new_sgl_vector_##T();                                            \
-void sgl_vector_delete_##T(sgl_vector(T)*);                                         \
-T* sgl_vector_at_##T(const sgl_vector(T)*, size_t);                                 \
-T* sgl_vector_front_##T(const sgl_vector(T)*);                                      \
-T* sgl_vector_back_##T(const sgl_vector(T)*);                                       \
-T* sgl_vector_data_##T(const sgl_vector(T)*);                                       \
-T* sgl_vector_begin_##T(sgl_vector(T)*);                                            \
-const T* sgl_vector_cbegin_##T(const sgl_vector(T)*);                               \
-T* sgl_vector_end_##T(sgl_vector(T)*);                                              \
-const T* sgl_vector_cend_##T(const sgl_vector(T)*);                                 \
-bool sgl_vector_is_empty_##T(const sgl_vector(T)*);                                 \
-size_t sgl_vector_size_##T(const sgl_vector(T)*);                                   \
-size_t sgl_vector_max_size_##T(void);                                               \
-void sgl_vector_reserve_##T(sgl_vector(T)*, size_t);                                \
-size_t sgl_vector_capacity_##T(const sgl_vector(T)*);                               \
-void sgl_vector_shrink_to_fit_##T(sgl_vector(T)*);                                  \
-void sgl_vector_clear_##T(sgl_vector(T)*);                                          \
-void sgl_vector_erase1_##T(sgl_vector(T)*, const T*);                               \
-void sgl_vector_erase2_##T(sgl_vector(T)*, const T*, const T*);                     \
-void sgl_vector_push_back_##T(sgl_vector(T)*, T);                                   \
-void sgl_vector_pop_back_##T(sgl_vector(T)*);                                       \
-void sgl_vector_resize1_##T(sgl_vector(T)*, size_t);                                \
-void sgl_vector_resize2_##T(sgl_vector(T)*, size_t, T);                             \
-bool sgl_vector_check_##T(const sgl_vector(T)*, const char*, const sgl_vector(T)*); \
+sgl_vector(N)* sgl_new_sgl_vector_##N();                                            \
+sgl_vector(N)* sgl_new_with_capacity_sgl_vector_##N(size_t);                        \
+sgl_vector(N)* sgl_new_with_allocator_sgl_vector_##N(const sgl_allocator*);         \
+void sgl_init_sgl_vector_##N(sgl_vector(N)*);                                       \
+void sgl_init_with_allocator_sgl_vector_##N(sgl_vector(N)*, const sgl_allocator*);  \
+void sgl_vector_delete_##N(sgl_vector(N)*);                                         \
+void sgl_vector_destroy_##N(sgl_vector(N)*);                                        \
+T* sgl_vector_at_##N(const sgl_vector(N)*, size_t);                                 \
+T* sgl_vector_front_##N(const sgl_vector(N)*);                                      \
+T* sgl_vector_back_##N(const sgl_vector(N)*);                                       \
+T* sgl_vector_data_##N(const sgl_vector(N)*);                                       \
+T* sgl_vector_begin_##N(sgl_vector(N)*);                                            \
+const T* sgl_vector_cbegin_##N(const sgl_vector(N)*);                               \
+T* sgl_vector_end_##N(sgl_vector(N)*);                                              \
+const T* sgl_vector_cend_##N(const sgl_vector(N)*);                                 \
+bool sgl_vector_is_empty_##N(const sgl_vector(N)*);                                 \
+size_t sgl_vector_size_##N(const sgl_vector(N)*);                                   \
+size_t sgl_vector_max_size_##N(void);                                               \
+void sgl_vector_reserve_##N(sgl_vector(N)*, size_t);                                \
+sgl_exception_t sgl_vector_try_reserve_##N(sgl_vector(N)*, size_t);                 \
+size_t sgl_vector_capacity_##N(const sgl_vector(N)*);                               \
+void sgl_vector_shrink_to_fit_##N(sgl_vector(N)*);                                  \
+sgl_exception_t sgl_vector_try_shrink_to_fit_##N(sgl_vector(N)*);                   \
+void sgl_vector_clear_##N(sgl_vector(N)*);                                          \
+void sgl_vector_erase1_##N(sgl_vector(N)*, const T*);                               \
+void sgl_vector_erase2_##N(sgl_vector(N)*, const T*, const T*);                     \
+T* sgl_vector_insert2_##N(sgl_vector(N)*, const T*, T);                             \
+T* sgl_vector_insert3_##N(sgl_vector(N)*, const T*, size_t, T);                     \
+T* sgl_vector_insert_range_##N(sgl_vector(N)*, const T*, const T*, const T*);       \
+void sgl_vector_push_back_##N(sgl_vector(N)*, T);                                   \
+sgl_exception_t sgl_vector_try_push_back_##N(sgl_vector(N)*, T);                    \
+void sgl_vector_pop_back_##N(sgl_vector(N)*);                                       \
+void sgl_vector_resize1_##N(sgl_vector(N)*, size_t);                                \
+void sgl_vector_resize2_##N(sgl_vector(N)*, size_t, T);                             \
+void sgl_vector_append_##N(sgl_vector(N)*, const T*, size_t);                       \
+void sgl_vector_assign_##N(sgl_vector(N)*, size_t, T);                              \
+void sgl_vector_assign_range_##N(sgl_vector(N)*, const T*, const T*);               \
+bool sgl_vector_equal_##N(const sgl_vector(N)*, const sgl_vector(N)*);              \
+bool sgl_vector_lexicographical_compare_##N(const sgl_vector(N)*,                   \
+                                            const sgl_vector(N)*);                  \
+sgl_growth_policy sgl_vector_##N##_get_growth_policy(void);                         \
+sgl_growth_policy sgl_vector_##N##_set_growth_policy(sgl_growth_policy);            \
+                                                                                    \
+extern sgl_growth_policy sgl_detail_vector_growth_##N;                              \
+extern const sgl_detail_vector_functions_##N sgl_detail_vector_funcs_##N;
+
+/**
+ * @def sgl_detail_instantiate_vector(T, N, A)
+ * Defines the methods of the sgl_vector_N type.
+ */
+#define sgl_detail_instantiate_vector(T, N, A)                                      \
+                                                                                    \
+sgl_growth_policy sgl_detail_vector_growth_##N = SGL_VECTOR_GROWTH_POLICY;          \
+                                                                                    \
+sgl_growth_policy sgl_vector_##N##_get_growth_policy(void)                          \
+{                                                                                   \
+    return sgl_detail_vector_growth_##N;                                            \
+}                                                                                   \
+                                                                                    \
+sgl_growth_policy sgl_vector_##N##_set_growth_policy(sgl_growth_policy policy)      \
+{                                                                                   \
+    sgl_growth_policy old_policy = sgl_detail_vector_growth_##N;                    \
+    if (policy == NULL)                                                             \
+    {                                                                               \
+        policy = SGL_VECTOR_GROWTH_POLICY;                                          \
+    }                                                                               \
+    sgl_detail_vector_growth_##N = policy;                                          \
+    return old_policy;                                                              \
+}                                                                                   \
+                                                                                    \
+void sgl_vector_delete_##N(sgl_vector(N)* vector)                                   \
+{                                                                                   \
+    sgl_vector_destroy_##N(vector);                                                 \
+    sgl_detail_deallocate(vector->_allocator, vector, sizeof(sgl_vector(N)));       \
+}                                                                                   \
                                                                                     \
-void sgl_vector_delete_##T(sgl_vector(T)* vector)                                   \
+void sgl_vector_destroy_##N(sgl_vector(N)* vector)                                  \
 {                                                                                   \
-    free(vector->_data);                                                            \
-    free(vector);                                                                   \
+    sgl_detail_deallocate(vector->_allocator, vector->_data,                        \
+                          vector->_capacity * sizeof(T));                           \
+    vector->_data = NULL;                                                           \
+    vector->_size = 0;                                                              \
+    vector->_capacity = 0;                                                          \
 }                                                                                   \
                                                                                     \
-T* sgl_vector_at_##T(const sgl_vector(T)* vector, size_t index)                     \
+T* sgl_vector_at_##N(const sgl_vector(N)* vector, size_t index)                     \
 {                                                                                   \
-    return sgl_data(vector) + index;                                                \
+    return vector->_data + index;                                                   \
 }                                                                                   \
                                                                                     \
-T* sgl_vector_front_##T(const sgl_vector(T)* vector)                                \
+T* sgl_vector_front_##N(const sgl_vector(N)* vector)                                \
 {                                                                                   \
-    return sgl_data(vector);                                                        \
+    return vector->_data;                                                           \
 }                                                                                   \
                                                                                     \
-T* sgl_vector_back_##T(const sgl_vector(T)* vector)                                 \
+T* sgl_vector_back_##N(const sgl_vector(N)* vector)                                 \
 {                                                                                   \
-    return sgl_data(vector) + sgl_size(vector) - 1;                                 \
+    return vector->_data + vector->_size - 1;                                       \
 }                                                                                   \
                                                                                     \
-T* sgl_vector_data_##T(const sgl_vector(T)* vector)                                 \
+T* sgl_vector_data_##N(const sgl_vector(N)* vector)                                 \
 {                                                                                   \
     return vector->_data;                                                           \
 }                                                                                   \
                                                                                     \
-T* sgl_vector_begin_##T(sgl_vector(T)* vector)                                      \
+T* sgl_vector_begin_##N(sgl_vector(N)* vector)                                      \
 {                                                                                   \
-    return sgl_data(vector);                                                        \
+    return vector->_data;                                                           \
 }                                                                                   \
                                                                                     \
-const T* sgl_vector_cbegin_##T(const sgl_vector(T)* vector)                         \
+const T* sgl_vector_cbegin_##N(const sgl_vector(N)* vector)                         \
 {                                                                                   \
-    return sgl_data(vector);                                                        \
+    return vector->_data;                                                           \
 }                                                                                   \
                                                                                     \
-T* sgl_vector_end_##T(sgl_vector(T)* vector)                                        \
+T* sgl_vector_end_##N(sgl_vector(N)* vector)                                        \
 {                                                                                   \
-    return sgl_data(vector) + sgl_size(vector);                                     \
+    return vector->_data + vector->_size;                                           \
 }                                                                                   \
                                                                                     \
-const T* sgl_vector_cend_##T(const sgl_vector(T)* vector)                           \
+const T* sgl_vector_cend_##N(const sgl_vector(N)* vector)                           \
 {                                                                                   \
-    return sgl_data(vector) + sgl_size(vector);                                     \
+    return vector->_data + vector->_size;                                           \
 }                                                                                   \
                                                                                     \
-bool sgl_vector_is_empty_##T(const sgl_vector(T)* vector)                           \
+bool sgl_vector_is_empty_##N(const sgl_vector(N)* vector)                           \
 {                                                                                   \
-    return sgl_size(vector) == 0;                                                   \
+    return vector->_size == 0;                                                      \
 }                                                                                   \
                                                                                     \
-size_t sgl_vector_size_##T(const sgl_vector(T)* vector)                             \
+size_t sgl_vector_size_##N(const sgl_vector(N)* vector)                             \
 {                                                                                   \
     return vector->_size;                                                           \
 }                                                                                   \
                                                                                     \
-size_t sgl_vector_max_size_##T(void)                                                \
+size_t sgl_vector_max_size_##N(void)                                                \
 {                                                                                   \
-    return SIZE_MAX;                                                                \
+    return SIZE_MAX / sizeof(T);                                                    \
 }                                                                                   \
                                                                                     \
-void sgl_vector_reserve_##T(sgl_vector(T)* vector, size_t new_cap)                  \
+sgl_exception_t sgl_vector_try_reserve_##N(sgl_vector(N)* vector, size_t new_cap)   \
 {                                                                                   \
-    if (new_cap > sgl_capacity(vector))                                             \
+    if (new_cap > vector->_capacity)                                                \
     {                                                                               \
-        vector->_capacity = new_cap;                                                \
-        vector->_data = realloc(vector->_data, new_cap * sizeof(T));                \
-        if (not vector->_data)                                                      \
+        if (new_cap > sgl_vector_max_size_##N())                                    \
         {                                                                           \
-            sgl_throw(sgl_bad_alloc);                                               \
+            return sgl_length_error;                                                \
         }                                                                           \
+        T* data = sgl_detail_reallocate(vector->_allocator, vector->_data,          \
+                                        vector->_capacity * sizeof(T),              \
+                                        new_cap * sizeof(T), A);                    \
+        if (not data)                                                               \
+        {                                                                           \
+            return sgl_bad_alloc;                                                   \
+        }                                                                           \
+        vector->_data = data;                                                       \
+        vector->_capacity = new_cap;                                                \
+    }                                                                               \
+    return sgl_no_exception;                                                        \
+}                                                                                   \
+                                                                                    \
+void sgl_vector_reserve_##N(sgl_vector(N)* vector, size_t new_cap)                  \
+{                                                                                   \
+    sgl_exception_t error = sgl_vector_try_reserve_##N(vector, new_cap);            \
+    if (error != sgl_no_exception)                                                  \
+    {                                                                               \
+        sgl_throw(error);                                                           \
     }                                                                               \
 }                                                                                   \
                                                                                     \
-size_t sgl_vector_capacity_##T(const sgl_vector(T)* vector)                         \
+size_t sgl_vector_capacity_##N(const sgl_vector(N)* vector)                         \
 {                                                                                   \
     return vector->_capacity;                                                       \
 }                                                                                   \
                                                                                     \
-void sgl_vector_shrink_to_fit_##T(sgl_vector(T)* vector)                            \
+sgl_exception_t sgl_vector_try_shrink_to_fit_##N(sgl_vector(N)* vector)             \
 {                                                                                   \
-    vector->_capacity = sgl_size(vector);                                           \
-    vector->_data = realloc(vector->_data, sgl_size(vector) * sizeof(T));           \
-    if (not vector->_data)                                                          \
+    if (vector->_size == vector->_capacity)                                         \
     {                                                                               \
-        sgl_throw(sgl_bad_alloc);                                                   \
+        return sgl_no_exception;                                                    \
+    }                                                                               \
+    if (vector->_size == 0)                                                         \
+    {                                                                               \
+        /* Go back to the unallocated state */                                      \
+        sgl_detail_deallocate(vector->_allocator, vector->_data,                    \
+                              vector->_capacity * sizeof(T));                       \
+        vector->_data = NULL;                                                       \
+        vector->_capacity = 0;                                                      \
+        return sgl_no_exception;                                                    \
+    }                                                                               \
+    T* data = sgl_detail_reallocate(vector->_allocator, vector->_data,              \
+                                    vector->_capacity * sizeof(T),                  \
+                                    vector->_size * sizeof(T), A);                  \
+    if (not data)                                                                   \
+    {                                                                               \
+        return sgl_bad_alloc;                                                       \
+    }                                                                               \
+    vector->_data = data;                                                           \
+    vector->_capacity = vector->_size;                                              \
+    return sgl_no_exception;                                                        \
+}                                                                                   \
+                                                                                    \
+void sgl_vector_shrink_to_fit_##N(sgl_vector(N)* vector)                            \
+{                                                                                   \
+    sgl_exception_t error = sgl_vector_try_shrink_to_fit_##N(vector);               \
+    if (error != sgl_no_exception)                                                  \
+    {                                                                               \
+        sgl_throw(error);                                                           \
     }                                                                               \
 }                                                                                   \
                                                                                     \
-void sgl_vector_clear_##T(sgl_vector(T)* vector)                                    \
+void sgl_vector_clear_##N(sgl_vector(N)* vector)                                    \
 {                                                                                   \
     vector->_size = 0;                                                              \
 }                                                                                   \
                                                                                     \
-void sgl_vector_erase1_##T(sgl_vector(T)* vector, const T* pos)                     \
+void sgl_vector_erase1_##N(sgl_vector(N)* vector, const T* pos)                     \
+{                                                                                   \
+    size_t index = pos - vector->_data;                                             \
+    memmove(vector->_data + index,                                                  \
+            vector->_data + index + 1,                                              \
+            (vector->_size - index - 1) * sizeof(T));                               \
+    --vector->_size;                                                                \
+}                                                                                   \
+                                                                                    \
+void sgl_vector_erase2_##N(sgl_vector(N)* vector, const T* first, const T* last)    \
+{                                                                                   \
+    size_t index = first - vector->_data;                                           \
+    size_t count = last - first;                                                    \
+    memmove(vector->_data + index,                                                  \
+            vector->_data + index + count,                                          \
+            (vector->_size - index - count) * sizeof(T));                           \
+    vector->_size -= count;                                                         \
+}                                                                                   \
+                                                                                    \
+/* Reserves memory for at least min_cap elements, according */                      \
+/* to the growth policy, when the capacity is not enough */                         \
+static inline sgl_exception_t sgl_detail_vector_try_grow_##N(sgl_vector(N)* vector, \
+                                                             size_t min_cap)        \
 {                                                                                   \
-    T* it = (T*) pos;                                                               \
-    while (it != sgl_end(vector)-1)                                                 \
+    if (min_cap > vector->_capacity)                                                \
     {                                                                               \
-        *it = it[1];                                                                \
-        ++it;                                                                       \
+        size_t max_cap = sgl_vector_max_size_##N();                                 \
+        size_t new_cap = sgl_detail_vector_growth_##N(vector->_capacity, min_cap);  \
+        if (new_cap > max_cap && min_cap <= max_cap)                                \
+        {                                                                           \
+            new_cap = max_cap;                                                      \
+        }                                                                           \
+        return sgl_vector_try_reserve_##N(vector, new_cap);                         \
     }                                                                               \
-    --vector->_size;                                                                \
+    return sgl_no_exception;                                                        \
 }                                                                                   \
                                                                                     \
-void sgl_vector_erase2_##T(sgl_vector(T)* vector, const T* first, const T* last)    \
+static inline void sgl_detail_vector_grow_##N(sgl_vector(N)* vector,                \
+                                              size_t min_cap)                       \
 {                                                                                   \
-    T* it1 = (T*) first;                                                            \
-    T* it2 = (T*) last;                                                             \
-    while (it2 != sgl_end(vector))                                                  \
+    sgl_exception_t error = sgl_detail_vector_try_grow_##N(vector, min_cap);        \
+    if (error != sgl_no_exception)                                                  \
     {                                                                               \
-        *it1 = *it2;                                                                \
-        ++it1;                                                                      \
-        ++it2;                                                                      \
+        sgl_throw(error);                                                           \
     }                                                                               \
-    vector->_size -= last-first;                                                    \
 }                                                                                   \
                                                                                     \
-void sgl_vector_push_back_##T(sgl_vector(T)* vector, T value)                       \
+/* Simple enough for the compiler to vectorize */                                   \
+static inline void sgl_detail_vector_fill_##N(T* first, size_t count, T value)      \
 {                                                                                   \
-    vector->_size += 1;                                                             \
-    if (sgl_capacity(vector) < sgl_size(vector))                                    \
+    for (size_t i = 0 ; i < count ; ++i)                                            \
     {                                                                               \
-        sgl_reserve(vector, sgl_capacity(vector)+40);                               \
+        first[i] = value;                                                           \
     }                                                                               \
-    sgl_back(vector) = value;                                                       \
 }                                                                                   \
                                                                                     \
-void sgl_vector_pop_back_##T(sgl_vector(T)* vector)                                 \
+/* Opens a gap of count elements at the given index with at */                      \
+/* most one reallocation and returns a pointer to the gap */                        \
+static inline T* sgl_detail_vector_open_gap_##N(sgl_vector(N)* vector,              \
+                                                size_t index,                       \
+                                                size_t count)                       \
 {                                                                                   \
-    if (sgl_size(vector) > 0)                                                       \
+    if (count > sgl_vector_max_size_##N() - vector->_size)                          \
+    {                                                                               \
+        sgl_throw(sgl_length_error);                                                \
+    }                                                                               \
+    sgl_detail_vector_grow_##N(vector, vector->_size + count);                      \
+    T* gap = vector->_data + index;                                                 \
+    memmove(gap + count, gap, (vector->_size - index) * sizeof(T));                 \
+    vector->_size += count;                                                         \
+    return gap;                                                                     \
+}                                                                                   \
+                                                                                    \
+T* sgl_vector_insert2_##N(sgl_vector(N)* vector, const T* pos, T value)             \
+{                                                                                   \
+    T* it = sgl_detail_vector_open_gap_##N(vector, pos - vector->_data, 1);         \
+    *it = value;                                                                    \
+    return it;                                                                      \
+}                                                                                   \
+                                                                                    \
+T* sgl_vector_insert3_##N(sgl_vector(N)* vector, const T* pos,                      \
+                          size_t count, T value)                                    \
+{                                                                                   \
+    T* it = sgl_detail_vector_open_gap_##N(vector, pos - vector->_data, count);     \
+    sgl_detail_vector_fill_##N(it, count, value);                                   \
+    return it;                                                                      \
+}                                                                                   \
+                                                                                    \
+/* The range [first, last) shall not be part of the vector */                       \
+T* sgl_vector_insert_range_##N(sgl_vector(N)* vector, const T* pos,                 \
+                               const T* first, const T* last)                       \
+{                                                                                   \
+    size_t count = last - first;                                                    \
+    T* it = sgl_detail_vector_open_gap_##N(vector, pos - vector->_data, count);     \
+    memcpy(it, first, count * sizeof(T));                                           \
+    return it;                                                                      \
+}                                                                                   \
+                                                                                    \
+void sgl_vector_push_back_##N(sgl_vector(N)* vector, T value)                       \
+{                                                                                   \
+    sgl_detail_vector_grow_##N(vector, vector->_size + 1);                          \
+    vector->_data[vector->_size++] = value;                                         \
+}                                                                                   \
+                                                                                    \
+sgl_exception_t sgl_vector_try_push_back_##N(sgl_vector(N)* vector, T value)        \
+{                                                                                   \
+    sgl_exception_t error = sgl_detail_vector_try_grow_##N(vector,                  \
+                                                           vector->_size + 1);      \
+    if (error == sgl_no_exception)                                                  \
+    {                                                                               \
+        vector->_data[vector->_size++] = value;                                     \
+    }                                                                               \
+    return error;                                                                   \
+}                                                                                   \
+                                                                                    \
+void sgl_vector_pop_back_##N(sgl_vector(N)* vector)                                 \
+{                                                                                   \
+    if (vector->_size > 0)                                                          \
     {                                                                               \
         vector->_size -= 1;                                                         \
     }                                                                               \
 }                                                                                   \
                                                                                     \
-void sgl_vector_resize1_##T(sgl_vector(T)* vector, size_t count)                    \
+void sgl_vector_resize1_##N(sgl_vector(N)* vector, size_t count)                    \
 {                                                                                   \
-    if (count < sgl_size(vector))                                                   \
+    sgl_detail_vector_grow_##N(vector, count);                                      \
+    vector->_size = count;                                                          \
+}                                                                                   \
+                                                                                    \
+void sgl_vector_resize2_##N(sgl_vector(N)* vector, size_t count, T value)           \
+{                                                                                   \
+    if (count > vector->_size)                                                      \
     {                                                                               \
-        while (sgl_size(vector) > count)                                            \
-        {                                                                           \
-            sgl_pop_back(vector);                                                   \
-        }                                                                           \
+        size_t size = vector->_size;                                                \
+        sgl_detail_vector_grow_##N(vector, count);                                  \
+        sgl_detail_vector_fill_##N(vector->_data + size, count - size, value);      \
     }                                                                               \
-    else                                                                            \
+    vector->_size = count;                                                          \
+}                                                                                   \
+                                                                                    \
+void sgl_vector_append_##N(sgl_vector(N)* vector, const T* values, size_t count)    \
+{                                                                                   \
+    /* Appending a part of the vector to itself is allowed, */                      \
+    /* but the reallocation may move the source elements */                         \
+    size_t offset = (uintptr_t) values - (uintptr_t) vector->_data;                 \
+    bool is_self = offset < vector->_size * sizeof(T);                              \
+    T* it = sgl_detail_vector_open_gap_##N(vector, vector->_size, count);           \
+    if (is_self)                                                                    \
     {                                                                               \
-        sgl_reserve(vector, count);                                                 \
-        vector->_size = count;                                                      \
+        values = (const T*) ((const char*) vector->_data + offset);                 \
     }                                                                               \
+    memcpy(it, values, count * sizeof(T));                                          \
 }                                                                                   \
                                                                                     \
-void sgl_vector_resize2_##T(sgl_vector(T)* vector, size_t count, T value)           \
+/* Makes room for count elements without preserving the */                          \
+/* current ones, which avoids copying them when reallocating */                     \
+static inline void sgl_detail_vector_discard_##N(sgl_vector(N)* vector,             \
+                                                 size_t count)                      \
 {                                                                                   \
-    if (count < sgl_size(vector))                                                   \
+    if (count > vector->_capacity)                                                  \
     {                                                                               \
-        while (sgl_size(vector) > count)                                            \
+        if (count > sgl_vector_max_size_##N())                                      \
         {                                                                           \
-            sgl_pop_back(vector);                                                   \
+            sgl_throw(sgl_length_error);                                            \
         }                                                                           \
-    }                                                                               \
-    else                                                                            \
-    {                                                                               \
-        while (sgl_size(vector) < count)                                            \
+        T* data = sgl_detail_allocate(vector->_allocator, count * sizeof(T),        \
+                                      A);                                           \
+        if (not data)                                                               \
         {                                                                           \
-            sgl_push_back(vector, value);                                           \
+            sgl_throw(sgl_bad_alloc);                                               \
         }                                                                           \
+        sgl_detail_deallocate(vector->_allocator, vector->_data,                    \
+                              vector->_capacity * sizeof(T));                       \
+        vector->_data = data;                                                       \
+        vector->_capacity = count;                                                  \
     }                                                                               \
+    vector->_size = count;                                                          \
+}                                                                                   \
+                                                                                    \
+void sgl_vector_assign_##N(sgl_vector(N)* vector, size_t count, T value)            \
+{                                                                                   \
+    sgl_detail_vector_discard_##N(vector, count);                                   \
+    sgl_detail_vector_fill_##N(vector->_data, count, value);                        \
+}                                                                                   \
+                                                                                    \
+/* If [first, last) is a part of the vector, no reallocation */                     \
+/* happens but the ranges may overlap, hence memmove */                             \
+void sgl_vector_assign_range_##N(sgl_vector(N)* vector,                             \
+                                 const T* first, const T* last)                     \
+{                                                                                   \
+    size_t count = last - first;                                                    \
+    sgl_detail_vector_discard_##N(vector, count);                                   \
+    memmove(vector->_data, first, count * sizeof(T));                               \
 }                                                                                   \
                                                                                     \
-bool sgl_vector_check_##T(const sgl_vector(T)* lhs,                                 \
-                          const char* op,                                           \
-                          const sgl_vector(T)* rhs)                                 \
+/* Returns the index of the first mismatch of two ranges */                         \
+static inline size_t sgl_detail_vector_mismatch_##N(const T* lhs,                   \
+                                                    const T* rhs,                   \
+                                                    size_t count)                   \
 {                                                                                   \
-    if (not strcmp(op, "=="))                                                       \
+    size_t i = 0;                                                                   \
+    if (sgl_detail_select_integer(*lhs, true, false))                               \
     {                                                                               \
-        for (size_t i = 0 ; i < sgl_size(lhs) ; ++i)                                \
+        /* Skip the equal blocks with the vectorized memcmp */                      \
+        size_t block = (256 + sizeof(T) - 1) / sizeof(T);                           \
+        while (count - i >= block                                                   \
+               && memcmp(lhs + i, rhs + i, block * sizeof(T)) == 0)                 \
         {                                                                           \
-            if (sgl_data(lhs)[i] != sgl_data(rhs)[i])                               \
-            {                                                                       \
-                return false;                                                       \
-            }                                                                       \
+            i += block;                                                             \
         }                                                                           \
-        return true;                                                                \
     }                                                                               \
-    else if (not strcmp(op, "!="))                                                  \
+    while (i < count && lhs[i] == rhs[i])                                           \
+    {                                                                               \
+        ++i;                                                                        \
+    }                                                                               \
+    return i;                                                                       \
+}                                                                                   \
+                                                                                    \
+bool sgl_vector_equal_##N(const sgl_vector(N)* lhs, const sgl_vector(N)* rhs)       \
+{                                                                                   \
+    if (lhs->_size != rhs->_size)                                                   \
     {                                                                               \
-        for (size_t i = 0 ; i < sgl_size(lhs) ; ++i)                                \
-        {                                                                           \
-            if (sgl_data(lhs)[i] != sgl_data(rhs)[i])                               \
-            {                                                                       \
-                return true;                                                        \
-            }                                                                       \
-        }                                                                           \
         return false;                                                               \
     }                                                                               \
-    else                                                                            \
+    if (sgl_detail_select_integer(*lhs->_data, true, false))                        \
+    {                                                                               \
+        return lhs->_size == 0                                                      \
+            || memcmp(lhs->_data, rhs->_data, lhs->_size * sizeof(T)) == 0;         \
+    }                                                                               \
+    /* Exact comparison of floating point values */                                 \
+    return sgl_detail_vector_mismatch_##N(lhs->_data, rhs->_data,                   \
+                                          lhs->_size) == lhs->_size;                \
+}                                                                                   \
+                                                                                    \
+bool sgl_vector_lexicographical_compare_##N(const sgl_vector(N)* lhs,               \
+                                            const sgl_vector(N)* rhs)               \
+{                                                                                   \
+    size_t count = lhs->_size < rhs->_size ? lhs->_size : rhs->_size;               \
+    size_t i = sgl_detail_vector_mismatch_##N(lhs->_data, rhs->_data, count);       \
+    for ( ; i < count ; ++i)                                                        \
     {                                                                               \
-        /* unknown op */                                                            \
+        /* Unordered values such as NaN are skipped */                              \
+        if (lhs->_data[i] < rhs->_data[i])                                          \
+        {                                                                           \
+            return true;                                                            \
+        }                                                                           \
+        if (rhs->_data[i] < lhs->_data[i])                                          \
+        {                                                                           \
+            return false;                                                           \
+        }                                                                           \
     }                                                                               \
-    return false; /* should never be used */                                        \
-}                                                                                   \
-                                                                                    \
-const sgl_detail_vector_functions_##T sgl_detail_vector_funcs_##T = {               \
-    &sgl_vector_delete_##T,                                                         \
-    &sgl_vector_at_##T,                                                             \
-    &sgl_vector_front_##T,                                                          \
-    &sgl_vector_back_##T,                                                           \
-    &sgl_vector_data_##T,                                                           \
-    &sgl_vector_begin_##T,                                                          \
-    &sgl_vector_cbegin_##T,                                                         \
-    &sgl_vector_end_##T,                                                            \
-    &sgl_vector_cend_##T,                                                           \
-    &sgl_vector_is_empty_##T,                                                       \
-    &sgl_vector_size_##T,                                                           \
-    &sgl_vector_max_size_##T,                                                       \
-    &sgl_vector_reserve_##T,                                                        \
-    &sgl_vector_capacity_##T,                                                       \
-    &sgl_vector_shrink_to_fit_##T,                                                  \
-    &sgl_vector_clear_##T,                                                          \
-    &sgl_vector_erase1_##T,                                                         \
-    &sgl_vector_erase2_##T,                                                         \
-    &sgl_vector_push_back_##T,                                                      \
-    &sgl_vector_pop_back_##T,                                                       \
-    &sgl_vector_resize1_##T,                                                        \
-    &sgl_vector_resize2_##T,                                                        \
-    &sgl_vector_check_##T                                                           \
+    return lhs->_size < rhs->_size;                                                 \
+}                                                                                   \
+                                                                                    \
+const sgl_detail_vector_functions_##N sgl_detail_vector_funcs_##N = {               \
+    &sgl_vector_delete_##N,                                                         \
+    &sgl_vector_destroy_##N,                                                        \
+    &sgl_vector_at_##N,                                                             \
+    &sgl_vector_front_##N,                                                          \
+    &sgl_vector_back_##N,                                                           \
+    &sgl_vector_data_##N,                                                           \
+    &sgl_vector_begin_##N,                                                          \
+    &sgl_vector_cbegin_##N,                                                         \
+    &sgl_vector_end_##N,                                                            \
+    &sgl_vector_cend_##N,                                                           \
+    &sgl_vector_is_empty_##N,                                                       \
+    &sgl_vector_size_##N,                                                           \
+    &sgl_vector_max_size_##N,                                                       \
+    &sgl_vector_reserve_##N,                                                        \
+    &sgl_vector_try_reserve_##N,                                                    \
+    &sgl_vector_capacity_##N,                                                       \
+    &sgl_vector_shrink_to_fit_##N,                                                  \
+    &sgl_vector_try_shrink_to_fit_##N,                                              \
+    &sgl_vector_clear_##N,                                                          \
+    &sgl_vector_erase1_##N,                                                         \
+    &sgl_vector_erase2_##N,                                                         \
+    &sgl_vector_insert2_##N,                                                        \
+    &sgl_vector_insert3_##N,                                                        \
+    &sgl_vector_insert_range_##N,                                                   \
+    &sgl_vector_push_back_##N,                                                      \
+    &sgl_vector_try_push_back_##N,                                                  \
+    &sgl_vector_pop_back_##N,                                                       \
+    &sgl_vector_resize1_##N,                                                        \
+    &sgl_vector_resize2_##N,                                                        \
+    &sgl_vector_append_##N,                                                         \
+    &sgl_vector_assign_##N,                                                         \
+    &sgl_vector_assign_range_##N,                                                   \
+    &sgl_vector_equal_##N,                                                          \
+    &sgl_vector_lexicographical_compare_##N,                                        \
+    { 0 }                                                                           \
 };                                                                                  \
                                                                                     \
-sgl_vector(T)* sgl_new_sgl_vector_##T()                                             \
+void sgl_init_with_allocator_sgl_vector_##N(sgl_vector(N)* vector,                  \
+                                             const sgl_allocator* allocator)        \
 {                                                                                   \
-    sgl_vector_##T* res = malloc(sizeof(sgl_vector(T)));                            \
-    if (not res)                                                                    \
+    vector->_functions = &sgl_detail_vector_funcs_##N;                              \
+    vector->_allocator = allocator;                                                 \
+    vector->_capacity = 0;                                                          \
+    vector->_size = 0;                                                              \
+    vector->_data = NULL;                                                           \
+}                                                                                   \
+                                                                                    \
+void sgl_init_sgl_vector_##N(sgl_vector(N)* vector)                                 \
+{                                                                                   \
+    sgl_init_with_allocator_sgl_vector_##N(vector, NULL);                           \
+}                                                                                   \
+                                                                                    \
+static inline sgl_vector(N)*                                                        \
+sgl_detail_new_vector_##N(size_t capacity, const sgl_allocator* allocator)          \
+{                                                                                   \
+    if (capacity > sgl_vector_max_size_##N())                                       \
     {                                                                               \
-        sgl_throw(sgl_bad_alloc);                                                   \
+        sgl_throw(sgl_length_error);                                                \
+    }                                                                               \
+    T* data = NULL;                                                                 \
+    if (capacity > 0)                                                               \
+    {                                                                               \
+        data = sgl_detail_allocate(allocator, capacity * sizeof(T), A);             \
+        if (not data)                                                               \
+        {                                                                           \
+            sgl_throw(sgl_bad_alloc);                                               \
+        }                                                                           \
     }                                                                               \
-    res->_functions = &sgl_detail_vector_funcs_##T;                                 \
-    res->_capacity = 40;                                                            \
-    res->_size = 0;                                                                 \
-    res->_data = malloc(res->_capacity * sizeof(T));                                \
-    if (not res->_data)                                                             \
+    sgl_vector(N)* res = sgl_detail_allocate(allocator, sizeof(sgl_vector(N)),      \
+                                             alignof(sgl_vector(N)));               \
+    if (not res)                                                                    \
     {                                                                               \
-        free(res);                                                                  \
+        sgl_detail_deallocate(allocator, data, capacity * sizeof(T));               \
         sgl_throw(sgl_bad_alloc);                                                   \
     }                                                                               \
+    sgl_init_with_allocator_sgl_vector_##N(res, allocator);                         \
+    res->_data = data;                                                              \
+    res->_capacity = capacity;                                                      \
     return res;                                                                     \
+}                                                                                   \
+                                                                                    \
+sgl_vector(N)* sgl_new_with_capacity_sgl_vector_##N(size_t capacity)                \
+{                                                                                   \
+    return sgl_detail_new_vector_##N(capacity, NULL);                               \
+}                                                                                   \
+                                                                                    \
+sgl_vector(N)*                                                                      \
+sgl_new_with_allocator_sgl_vector_##N(const sgl_allocator* allocator)               \
+{                                                                                   \
+    return sgl_detail_new_vector_##N(0, allocator);                                 \
+}                                                                                   \
+                                                                                    \
+sgl_vector(N)* sgl_new_sgl_vector_##N()                                             \
+{                                                                                   \
+    return sgl_detail_new_vector_##N(0, NULL);                                      \
 }
 
 #endif // SGL_VECTOR_H_
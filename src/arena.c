@@ -0,0 +1,202 @@
+/*
+ * Copyright (C) 2015 Morwenn
+ *
+ * The SGL is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * The SGL is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program. If not,
+ * see <http://www.gnu.org/licenses/>.
+ */
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sgl/memory/arena.h>
+
+////////////////////////////////////////////////////////////
+// Chunks
+
+struct sgl_detail_arena_chunk
+{
+    sgl_detail_arena_chunk* next;
+    size_t size;
+    max_align_t data[];
+};
+
+static char* chunk_begin(sgl_detail_arena_chunk* chunk)
+{
+    return (char*) chunk->data;
+}
+
+static char* chunk_end(sgl_detail_arena_chunk* chunk)
+{
+    return (char*) chunk->data + chunk->size;
+}
+
+// Makes the given chunk the current one
+static void use_chunk(sgl_arena* arena, sgl_detail_arena_chunk* chunk)
+{
+    arena->_current = chunk;
+    arena->_ptr = chunk_begin(chunk);
+    arena->_end = chunk_end(chunk);
+}
+
+////////////////////////////////////////////////////////////
+// Allocator interface
+
+static void* arena_allocate(void* context, size_t size, size_t alignment)
+{
+    sgl_arena* arena = context;
+    uintptr_t mask = alignment - 1;
+    uintptr_t ptr = ((uintptr_t) arena->_ptr + mask) & ~mask;
+    uintptr_t end = (uintptr_t) arena->_end;
+    if (ptr != 0 && ptr <= end && size <= end - ptr)
+    {
+        arena->_ptr = (char*) ptr + size;
+        return (void*) ptr;
+    }
+    return sgl_detail_arena_allocate_slow(arena, size, alignment);
+}
+
+static void* arena_reallocate(void* context, void* ptr, size_t old_size,
+                              size_t new_size, size_t alignment)
+{
+    sgl_arena* arena = context;
+
+    // The last allocated block can be resized in place
+    if (ptr != NULL && (char*) ptr + old_size == arena->_ptr
+        && new_size <= (size_t) (arena->_end - (char*) ptr))
+    {
+        arena->_ptr = (char*) ptr + new_size;
+        return ptr;
+    }
+
+    void* res = arena_allocate(context, new_size, alignment);
+    if (res != NULL && ptr != NULL)
+    {
+        memcpy(res, ptr, old_size < new_size ? old_size : new_size);
+    }
+    return res;
+}
+
+static void arena_deallocate(void* context, void* ptr, size_t size)
+{
+    sgl_arena* arena = context;
+
+    // Only the last allocated block is given back
+    if (ptr != NULL && (char*) ptr + size == arena->_ptr)
+    {
+        arena->_ptr = ptr;
+    }
+}
+
+////////////////////////////////////////////////////////////
+// Arena functions
+
+void sgl_arena_init(sgl_arena* arena, size_t chunk_size)
+{
+    arena->_ptr = NULL;
+    arena->_end = NULL;
+    arena->_current = NULL;
+    arena->_first = NULL;
+    arena->_chunk_size = chunk_size;
+    arena->_allocator.allocate = arena_allocate;
+    arena->_allocator.reallocate = arena_reallocate;
+    arena->_allocator.deallocate = arena_deallocate;
+    arena->_allocator.context = arena;
+}
+
+void sgl_arena_destroy(sgl_arena* arena)
+{
+    sgl_detail_arena_chunk* chunk = arena->_first;
+    while (chunk != NULL)
+    {
+        sgl_detail_arena_chunk* next = chunk->next;
+        free(chunk);
+        chunk = next;
+    }
+    sgl_arena_init(arena, arena->_chunk_size);
+}
+
+void sgl_arena_reset(sgl_arena* arena)
+{
+    arena->_current = NULL;
+    arena->_ptr = NULL;
+    arena->_end = NULL;
+}
+
+sgl_arena_mark sgl_arena_save(const sgl_arena* arena)
+{
+    sgl_arena_mark mark = { arena->_ptr, arena->_current };
+    return mark;
+}
+
+void sgl_arena_rewind(sgl_arena* arena, sgl_arena_mark mark)
+{
+    if (mark._chunk == NULL)
+    {
+        sgl_arena_reset(arena);
+        return;
+    }
+    arena->_current = mark._chunk;
+    arena->_ptr = mark._ptr;
+    arena->_end = chunk_end(mark._chunk);
+}
+
+const sgl_allocator* sgl_arena_allocator(sgl_arena* arena)
+{
+    return &arena->_allocator;
+}
+
+void* sgl_detail_arena_allocate_slow(sgl_arena* arena,
+                                     size_t size, size_t alignment)
+{
+    // Worst case size, chunks are only aligned on max_align_t
+    size_t needed = size + alignment;
+    if (needed < size)
+    {
+        return NULL;
+    }
+
+    // Reuse the next chunk if it has been kept by a reset
+    sgl_detail_arena_chunk* next = arena->_current ? arena->_current->next
+                                                   : arena->_first;
+    if (next == NULL || next->size < needed)
+    {
+        size_t chunk_size = needed < arena->_chunk_size ? arena->_chunk_size
+                                                        : needed;
+        if (chunk_size > SIZE_MAX - sizeof(sgl_detail_arena_chunk))
+        {
+            return NULL;
+        }
+        sgl_detail_arena_chunk* chunk = malloc(sizeof(sgl_detail_arena_chunk)
+                                               + chunk_size);
+        if (chunk == NULL)
+        {
+            return NULL;
+        }
+        chunk->size = chunk_size;
+
+        // Insert the new chunk after the current one
+        chunk->next = next;
+        if (arena->_current)
+        {
+            arena->_current->next = chunk;
+        }
+        else
+        {
+            arena->_first = chunk;
+        }
+        next = chunk;
+    }
+
+    use_chunk(arena, next);
+    return arena_allocate(arena, size, alignment);
+}
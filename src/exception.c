@@ -23,18 +23,18 @@
 ////////////////////////////////////////////////////////////
 // Global implementation variables
 
-jmp_buf sgl_detail_buf_array[SGL_MAX_EXCEPTIONS];
+_Thread_local sgl_detail_jmp_buf sgl_detail_buf_array[SGL_MAX_EXCEPTIONS];
 
-int sgl_detail_exceptions_index = -1;
+_Thread_local int sgl_detail_exceptions_index = -1;
 
-sgl_exception_t sgl_detail_current_exception;
+_Thread_local sgl_exception_t sgl_detail_current_exception;
 
 ////////////////////////////////////////////////////////////
 // Throwing functions
 
 void sgl_throw(sgl_exception_t exception)
 {
-    assert(exception != sgl_exception);
+    assert(exception != sgl_exception && exception != sgl_no_exception);
     sgl_detail_current_exception = exception;
 
     // Handle exceptions out of a try block
@@ -43,7 +43,7 @@ void sgl_throw(sgl_exception_t exception)
         sgl_terminate();
     }
 
-    longjmp(sgl_detail_buf_array[sgl_detail_exceptions_index], true);
+    sgl_detail_longjmp(sgl_detail_buf_array[sgl_detail_exceptions_index]);
 }
 
 noreturn void sgl_rethrow()
@@ -96,6 +96,10 @@ const char* sgl_what(sgl_exception_t exception)
         "bad allocation"
     };
 
+    if (exception == sgl_no_exception)
+    {
+        return "no error";
+    }
     if (exception < 0 || exception >= sgl_detail_exceptions_number)
     {
         return "unknown error";
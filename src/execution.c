@@ -0,0 +1,140 @@
+/*
+ * Copyright (C) 2015 Morwenn
+ *
+ * The SGL is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * The SGL is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program. If not,
+ * see <http://www.gnu.org/licenses/>.
+ */
+#include <stdlib.h>
+#include <string.h>
+#include <sgl/algorithm/execution.h>
+#include <sgl/thread/pool.h>
+
+////////////////////////////////////////////////////////////
+// Chunking
+
+typedef struct
+{
+    sgl_detail_chunk_func func;
+    void* context;
+    size_t index;
+    size_t first;
+    size_t last;
+} chunk;
+
+static void run_chunk(void* arg)
+{
+    chunk* self = arg;
+    self->func(self->context, self->index, self->first, self->last);
+}
+
+// Number of chunks a range is split into; every chunk has at
+// least SGL_PARALLEL_GRAIN elements and there are at most four
+// chunks per thread, counting the workers of the default pool and
+// the calling thread, to balance uneven workloads
+size_t sgl_detail_chunk_count(sgl_execution_policy policy, size_t size)
+{
+    if (policy == sgl_seq or size < 2 * SGL_PARALLEL_GRAIN)
+    {
+        return 1;
+    }
+    sgl_thread_pool* pool = sgl_default_thread_pool();
+    if (not pool)
+    {
+        return 1;
+    }
+    size_t threads = sgl_thread_pool_size(pool) + 1;
+    size_t count = size / SGL_PARALLEL_GRAIN;
+    return count < 4 * threads ? count : 4 * threads;
+}
+
+static size_t chunk_bound(size_t size, size_t count, size_t index)
+{
+    size_t extra = size % count;
+    return size / count * index + (index < extra ? index : extra);
+}
+
+void sgl_detail_run_chunks(size_t count, size_t size,
+                           sgl_detail_chunk_func func, void* context)
+{
+    sgl_thread_pool* pool = count > 1 ? sgl_default_thread_pool() : NULL;
+    chunk* chunks = pool ? malloc(count * sizeof(chunk)) : NULL;
+    if (not chunks)
+    {
+        for (size_t i = 0 ; i < count ; ++i)
+        {
+            func(context, i, chunk_bound(size, count, i),
+                 chunk_bound(size, count, i + 1));
+        }
+        return;
+    }
+
+    sgl_task_group group;
+    sgl_task_group_init(&group, pool);
+    for (size_t i = 0 ; i < count ; ++i)
+    {
+        chunks[i] = (chunk) {
+            .func = func,
+            .context = context,
+            .index = i,
+            .first = chunk_bound(size, count, i),
+            .last = chunk_bound(size, count, i + 1)
+        };
+        if (i + 1 < count)
+        {
+            sgl_spawn(&group, &run_chunk, &chunks[i]);
+        }
+    }
+    run_chunk(&chunks[count - 1]);
+    sgl_wait(&group);
+    free(chunks);
+}
+
+////////////////////////////////////////////////////////////
+// fill
+
+typedef struct
+{
+    char* data;
+    size_t width;
+} fill_context;
+
+// Copies the first element of the range to the beginning of the
+// chunk, then doubles the filled part of the chunk with memcpy
+static void fill_chunk(void* context, size_t index,
+                       size_t first, size_t last)
+{
+    (void) index;
+    fill_context* ctx = context;
+    size_t width = ctx->width;
+    char* dst = ctx->data + first * width;
+    size_t size = last - first;
+    if (first != 0)
+    {
+        memcpy(dst, ctx->data, width);
+    }
+    for (size_t done = 1 ; done < size ;)
+    {
+        size_t n = done < size - done ? done : size - done;
+        memcpy(dst + done * width, dst, n * width);
+        done += n;
+    }
+}
+
+void sgl_detail_fill_n(sgl_execution_policy policy, void* first,
+                       size_t size, size_t width)
+{
+    fill_context ctx = { first, width };
+    sgl_detail_run_chunks(sgl_detail_chunk_count(policy, size), size,
+                          &fill_chunk, &ctx);
+}
@@ -0,0 +1,122 @@
+/*
+ * Copyright (C) 2015 Morwenn
+ *
+ * The SGL is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * The SGL is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program. If not,
+ * see <http://www.gnu.org/licenses/>.
+ */
+#include <stdint.h>
+#include <string.h>
+#include <sgl/hash.h>
+
+// Note: the byte hash follows the structure of wyhash, which was
+//       released in the public domain by Wang Yi.
+
+////////////////////////////////////////////////////////////
+// Helpers
+
+static const uint64_t secret[4] = {
+    UINT64_C(0x2d358dccaa6c78a5),
+    UINT64_C(0x8bb84b93962eacc9),
+    UINT64_C(0x4b33a62ed433d4a3),
+    UINT64_C(0x4d5a2da51de1aa47)
+};
+
+static inline uint64_t read64(const uint8_t* ptr)
+{
+    uint64_t res;
+    memcpy(&res, ptr, sizeof res);
+    return res;
+}
+
+static inline uint64_t read32(const uint8_t* ptr)
+{
+    uint32_t res;
+    memcpy(&res, ptr, sizeof res);
+    return res;
+}
+
+// Reads 1 to 3 bytes
+static inline uint64_t read_small(const uint8_t* ptr, size_t size)
+{
+    return ((uint64_t) ptr[0] << 16)
+         | ((uint64_t) ptr[size >> 1] << 8)
+         | ptr[size - 1];
+}
+
+////////////////////////////////////////////////////////////
+// Byte hash
+
+size_t sgl_hash_bytes_seeded(const void* data, size_t size, uint64_t seed)
+{
+    const uint8_t* ptr = data;
+    seed ^= sgl_detail_hash_mix(seed ^ secret[0], secret[1]);
+
+    uint64_t a, b;
+    if (size <= 16)
+    {
+        if (size >= 4)
+        {
+            // Two possibly overlapping reads cover the whole key
+            size_t offset = (size >> 3) << 2;
+            a = (read32(ptr) << 32) | read32(ptr + offset);
+            b = (read32(ptr + size - 4) << 32) | read32(ptr + size - 4 - offset);
+        }
+        else if (size > 0)
+        {
+            a = read_small(ptr, size);
+            b = 0;
+        }
+        else
+        {
+            a = b = 0;
+        }
+    }
+    else
+    {
+        size_t remaining = size;
+        if (remaining > 48)
+        {
+            // Three independent lanes to hide the multiplication latency
+            uint64_t seed1 = seed;
+            uint64_t seed2 = seed;
+            do
+            {
+                seed = sgl_detail_hash_mix(read64(ptr) ^ secret[1],
+                                           read64(ptr + 8) ^ seed);
+                seed1 = sgl_detail_hash_mix(read64(ptr + 16) ^ secret[2],
+                                            read64(ptr + 24) ^ seed1);
+                seed2 = sgl_detail_hash_mix(read64(ptr + 32) ^ secret[3],
+                                            read64(ptr + 40) ^ seed2);
+                ptr += 48;
+                remaining -= 48;
+            } while (remaining > 48);
+            seed ^= seed1 ^ seed2;
+        }
+        while (remaining > 16)
+        {
+            seed = sgl_detail_hash_mix(read64(ptr) ^ secret[1],
+                                       read64(ptr + 8) ^ seed);
+            ptr += 16;
+            remaining -= 16;
+        }
+        // The last 16 bytes, possibly overlapping the previous ones
+        a = read64(ptr + remaining - 16);
+        b = read64(ptr + remaining - 8);
+    }
+
+    a ^= secret[1];
+    b ^= seed;
+    sgl_detail_hash_multiply(&a, &b);
+    return (size_t) sgl_detail_hash_mix(a ^ secret[0] ^ size, b ^ secret[1]);
+}
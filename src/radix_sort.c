@@ -0,0 +1,230 @@
+/*
+ * Copyright (C) 2015 Morwenn
+ *
+ * The SGL is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * The SGL is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program. If not,
+ * see <http://www.gnu.org/licenses/>.
+ */
+#include <stdint.h>
+#include <string.h>
+#include <sgl/algorithm/radix_sort.h>
+#include <sgl/exception.h>
+#include <sgl/memory/allocator.h>
+
+////////////////////////////////////////////////////////////
+// Constants
+
+enum
+{
+    // Number of bits of the digit sorted by each pass
+    radix_bits = 11,
+    radix_size = 1 << radix_bits,
+    radix_mask = radix_size - 1,
+    // Ranges smaller than that are insertion sorted instead
+    radix_insertion_threshold = 64
+};
+
+////////////////////////////////////////////////////////////
+// Sorting functions
+
+// The elements are only read and written with memcpy so that a
+// float array can be accessed through unsigned keys. The key of
+// an element is bits ^ ((sign & neg) | top), where sign is all
+// ones for elements whose highest bit is set, and neg and top are
+// the masks chosen for the kind of element
+#define RADIX_SORT(W)                                                               \
+                                                                                    \
+static inline uint##W##_t load##W(const unsigned char* ptr)                         \
+{                                                                                   \
+    uint##W##_t res;                                                                \
+    memcpy(&res, ptr, sizeof res);                                                  \
+    return res;                                                                     \
+}                                                                                   \
+                                                                                    \
+static inline void store##W(unsigned char* ptr, uint##W##_t value)                  \
+{                                                                                   \
+    memcpy(ptr, &value, sizeof value);                                              \
+}                                                                                   \
+                                                                                    \
+static inline uint##W##_t to_key##W(uint##W##_t bits,                               \
+                                    uint##W##_t neg, uint##W##_t top)               \
+{                                                                                   \
+    uint##W##_t sign = -(bits >> (W - 1));                                          \
+    return bits ^ ((sign & neg) | top);                                             \
+}                                                                                   \
+                                                                                    \
+static inline uint##W##_t from_key##W(uint##W##_t key,                              \
+                                      uint##W##_t neg, uint##W##_t top)             \
+{                                                                                   \
+    uint##W##_t sign = (key >> (W - 1)) - 1;                                        \
+    return key ^ ((sign & neg) | top);                                              \
+}                                                                                   \
+                                                                                    \
+static void insertion_sort##W(unsigned char* data, size_t size,                     \
+                              uint##W##_t neg, uint##W##_t top)                     \
+{                                                                                   \
+    enum { width = W / 8 };                                                         \
+    for (size_t i = 0 ; i < size ; ++i)                                             \
+    {                                                                               \
+        uint##W##_t key = to_key##W(load##W(data + i * width), neg, top);           \
+        size_t j = i;                                                               \
+        for (; j > 0 ; --j)                                                         \
+        {                                                                           \
+            uint##W##_t prev = load##W(data + (j - 1) * width);                     \
+            if (prev <= key)                                                        \
+            {                                                                       \
+                break;                                                              \
+            }                                                                       \
+            store##W(data + j * width, prev);                                       \
+        }                                                                           \
+        store##W(data + j * width, key);                                            \
+    }                                                                               \
+    for (size_t i = 0 ; i < size ; ++i)                                             \
+    {                                                                               \
+        unsigned char* ptr = data + i * width;                                      \
+        store##W(ptr, from_key##W(load##W(ptr), neg, top));                         \
+    }                                                                               \
+}                                                                                   \
+                                                                                    \
+static void radix_sort##W(unsigned char* data, size_t size,                         \
+                          sgl_detail_radix_kind kind)                               \
+{                                                                                   \
+    enum                                                                            \
+    {                                                                               \
+        width = W / 8,                                                              \
+        passes = (W + radix_bits - 1) / radix_bits                                  \
+    };                                                                              \
+    uint##W##_t top = kind == sgl_detail_radix_unsigned ? 0 :                       \
+                      (uint##W##_t) 1 << (W - 1);                                   \
+    uint##W##_t neg = kind == sgl_detail_radix_floating_point ? -1 : 0;             \
+                                                                                    \
+    if (size < radix_insertion_threshold)                                           \
+    {                                                                               \
+        insertion_sort##W(data, size, neg, top);                                    \
+        return;                                                                     \
+    }                                                                               \
+                                                                                    \
+    /* The digit counts of every pass and the scratch elements */                   \
+    /* share a single allocation */                                                 \
+    size_t counts_size = passes * radix_size * sizeof(size_t);                      \
+    if (size > (SIZE_MAX - counts_size) / width)                                    \
+    {                                                                               \
+        sgl_throw(sgl_bad_alloc);                                                   \
+    }                                                                               \
+    size_t buffer_size = counts_size + size * width;                                \
+    size_t (*counts)[radix_size] = sgl_detail_allocate(NULL, buffer_size,           \
+                                                       alignof(size_t));            \
+    if (not counts)                                                                 \
+    {                                                                               \
+        sgl_throw(sgl_bad_alloc);                                                   \
+    }                                                                               \
+    unsigned char* scratch = (unsigned char*) counts + counts_size;                 \
+    memset(counts, 0, counts_size);                                                 \
+                                                                                    \
+    /* Transform the elements into keys and count the digits of */                  \
+    /* every pass at once */                                                        \
+    for (size_t i = 0 ; i < size ; ++i)                                             \
+    {                                                                               \
+        unsigned char* ptr = data + i * width;                                      \
+        uint##W##_t key = to_key##W(load##W(ptr), neg, top);                        \
+        store##W(ptr, key);                                                         \
+        for (int pass = 0 ; pass < passes ; ++pass)                                 \
+        {                                                                           \
+            ++counts[pass][(key >> (pass * radix_bits)) & radix_mask];              \
+        }                                                                           \
+    }                                                                               \
+                                                                                    \
+    /* A pass is useless when every key has the same digit */                       \
+    uint##W##_t first_key = load##W(data);                                          \
+    int last_pass = -1;                                                             \
+    for (int pass = 0 ; pass < passes ; ++pass)                                     \
+    {                                                                               \
+        size_t digit = (first_key >> (pass * radix_bits)) & radix_mask;             \
+        if (counts[pass][digit] != size)                                            \
+        {                                                                           \
+            last_pass = pass;                                                       \
+        }                                                                           \
+    }                                                                               \
+                                                                                    \
+    unsigned char* src = data;                                                      \
+    unsigned char* dst = scratch;                                                   \
+    for (int pass = 0 ; pass <= last_pass ; ++pass)                                 \
+    {                                                                               \
+        size_t* offsets = counts[pass];                                             \
+        int shift = pass * radix_bits;                                              \
+        if (offsets[(first_key >> shift) & radix_mask] == size)                     \
+        {                                                                           \
+            continue;                                                               \
+        }                                                                           \
+        size_t sum = 0;                                                             \
+        for (size_t digit = 0 ; digit < radix_size ; ++digit)                       \
+        {                                                                           \
+            size_t count = offsets[digit];                                          \
+            offsets[digit] = sum;                                                   \
+            sum += count;                                                           \
+        }                                                                           \
+        if (pass == last_pass)                                                      \
+        {                                                                           \
+            /* The last pass also transforms the keys back */                       \
+            for (size_t i = 0 ; i < size ; ++i)                                     \
+            {                                                                       \
+                uint##W##_t key = load##W(src + i * width);                         \
+                size_t pos = offsets[(key >> shift) & radix_mask]++;                \
+                store##W(dst + pos * width, from_key##W(key, neg, top));            \
+            }                                                                       \
+        }                                                                           \
+        else                                                                        \
+        {                                                                           \
+            for (size_t i = 0 ; i < size ; ++i)                                     \
+            {                                                                       \
+                uint##W##_t key = load##W(src + i * width);                         \
+                size_t pos = offsets[(key >> shift) & radix_mask]++;                \
+                store##W(dst + pos * width, key);                                   \
+            }                                                                       \
+        }                                                                           \
+        unsigned char* tmp = src;                                                   \
+        src = dst;                                                                  \
+        dst = tmp;                                                                  \
+    }                                                                               \
+                                                                                    \
+    if (last_pass == -1)                                                            \
+    {                                                                               \
+        /* Every element is equal: only transform them back */                      \
+        for (size_t i = 0 ; i < size ; ++i)                                         \
+        {                                                                           \
+            unsigned char* ptr = data + i * width;                                  \
+            store##W(ptr, from_key##W(load##W(ptr), neg, top));                     \
+        }                                                                           \
+    }                                                                               \
+    else if (src != data)                                                           \
+    {                                                                               \
+        memcpy(data, src, size * width);                                            \
+    }                                                                               \
+    sgl_detail_deallocate(NULL, counts, buffer_size);                               \
+}
+
+RADIX_SORT(32)
+RADIX_SORT(64)
+
+void sgl_detail_radix_sort(void* data, size_t size, size_t width,
+                           sgl_detail_radix_kind kind)
+{
+    if (width == 4)
+    {
+        radix_sort32(data, size, kind);
+    }
+    else
+    {
+        radix_sort64(data, size, kind);
+    }
+}
@@ -0,0 +1,93 @@
+/*
+ * Copyright (C) 2015 Morwenn
+ *
+ * The SGL is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * The SGL is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program. If not,
+ * see <http://www.gnu.org/licenses/>.
+ */
+#if defined(__unix__) || defined(__APPLE__)
+    #include <unistd.h>
+#elif defined(_WIN32)
+    #include <windows.h>
+#endif
+#include <stdbool.h>
+#include <stdlib.h>
+#include <threads.h>
+#include <sgl/thread/concurrency.h>
+
+////////////////////////////////////////////////////////////
+// Hardware
+
+size_t sgl_hardware_concurrency(void)
+{
+#if defined(_SC_NPROCESSORS_ONLN)
+    long count = sysconf(_SC_NPROCESSORS_ONLN);
+    return count > 0 ? (size_t) count : 1;
+#elif defined(_WIN32)
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    return info.dwNumberOfProcessors > 0 ? info.dwNumberOfProcessors : 1;
+#else
+    return 1;
+#endif
+}
+
+////////////////////////////////////////////////////////////
+// Fork-join
+
+void sgl_detail_parallel_invoke(size_t count, int (*func)(void*),
+                                void* args, size_t arg_size)
+{
+    char* ptr = args;
+    if (count <= 1)
+    {
+        if (count == 1)
+        {
+            func(ptr);
+        }
+        return;
+    }
+
+    thrd_t* threads = malloc((count - 1) * sizeof(thrd_t));
+    bool* started = malloc((count - 1) * sizeof(bool));
+    if (not threads or not started)
+    {
+        free(threads);
+        free(started);
+        for (size_t i = 0 ; i < count ; ++i)
+        {
+            func(ptr + i * arg_size);
+        }
+        return;
+    }
+
+    for (size_t i = 1 ; i < count ; ++i)
+    {
+        started[i - 1] = thrd_create(&threads[i - 1], func,
+                                     ptr + i * arg_size) == thrd_success;
+    }
+    func(ptr);
+    for (size_t i = 1 ; i < count ; ++i)
+    {
+        if (started[i - 1])
+        {
+            thrd_join(threads[i - 1], NULL);
+        }
+        else
+        {
+            func(ptr + i * arg_size);
+        }
+    }
+    free(started);
+    free(threads);
+}
@@ -0,0 +1,538 @@
+/*
+ * Copyright (C) 2015 Morwenn
+ *
+ * The SGL is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * The SGL is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program. If not,
+ * see <http://www.gnu.org/licenses/>.
+ */
+#include <stdatomic.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <threads.h>
+#include <sgl/memory/alignment.h>
+#include <sgl/memory/allocator.h>
+#include <sgl/thread/concurrency.h>
+#include <sgl/thread/pool.h>
+
+////////////////////////////////////////////////////////////
+// Types
+
+enum
+{
+    // Number of tasks a worker deque can hold
+    deque_capacity = 1024,
+    // Number of times an idle worker looks for tasks before parking
+    idle_rounds = 64
+};
+
+// Bit of the pending count of a group set while a thread which is
+// not a worker blocks on it
+static const size_t blocked_flag = SIZE_MAX / 2 + 1;
+
+typedef void (*task_func)(void*);
+
+typedef struct
+{
+    task_func func;
+    void* arg;
+    sgl_task_group* group;
+} task;
+
+// Slot of a deque, read by thieves while the owner may write it
+typedef struct
+{
+    _Atomic(task_func) func;
+    _Atomic(void*) arg;
+    _Atomic(sgl_task_group*) group;
+} slot;
+
+typedef struct
+{
+    // Chase-Lev deque: thieves take from top, the owner from bottom
+    alignas(SGL_CACHE_LINE_SIZE) _Atomic(int64_t) top;
+    alignas(SGL_CACHE_LINE_SIZE) _Atomic(int64_t) bottom;
+    alignas(SGL_CACHE_LINE_SIZE) slot slots[deque_capacity];
+    sgl_thread_pool* pool;
+    uint64_t seed;
+    thrd_t thread;
+    bool started;
+} worker;
+
+struct sgl_thread_pool
+{
+    worker* workers;
+    size_t size;
+
+    // Tasks spawned by threads which are not workers
+    mtx_t queue_mutex;
+    task* queue;
+    size_t queue_head;
+    size_t queue_size;
+    size_t queue_capacity;
+    atomic_size_t queue_count;
+
+    // Parking of idle workers
+    mtx_t mutex;
+    cnd_t cond;
+    size_t epoch;
+    bool stop;
+    atomic_size_t sleeping;
+
+    // Threads which are not workers wait for their groups here
+    cnd_t done;
+};
+
+// Worker run by the current thread, if any
+static _Thread_local worker* current_worker = NULL;
+
+static uint64_t next_random(uint64_t* seed)
+{
+    // xorshift64*
+    uint64_t x = *seed;
+    x ^= x >> 12;
+    x ^= x << 25;
+    x ^= x >> 27;
+    *seed = x;
+    return x * UINT64_C(2685821657736338717);
+}
+
+////////////////////////////////////////////////////////////
+// Chase-Lev deque
+
+// Called by the owner only, returns false when the deque is full
+static bool deque_push(worker* self, task value)
+{
+    int64_t bottom = atomic_load_explicit(&self->bottom, memory_order_relaxed);
+    int64_t top = atomic_load_explicit(&self->top, memory_order_acquire);
+    if (bottom - top >= deque_capacity)
+    {
+        return false;
+    }
+    slot* s = &self->slots[bottom % deque_capacity];
+    atomic_store_explicit(&s->func, value.func, memory_order_relaxed);
+    atomic_store_explicit(&s->arg, value.arg, memory_order_relaxed);
+    atomic_store_explicit(&s->group, value.group, memory_order_relaxed);
+    atomic_thread_fence(memory_order_release);
+    atomic_store_explicit(&self->bottom, bottom + 1, memory_order_relaxed);
+    return true;
+}
+
+static task read_slot(const slot* s)
+{
+    return (task) {
+        .func = atomic_load_explicit(&s->func, memory_order_relaxed),
+        .arg = atomic_load_explicit(&s->arg, memory_order_relaxed),
+        .group = atomic_load_explicit(&s->group, memory_order_relaxed)
+    };
+}
+
+// Called by the owner only
+static bool deque_pop(worker* self, task* out)
+{
+    int64_t bottom = atomic_load_explicit(&self->bottom, memory_order_relaxed) - 1;
+    atomic_store_explicit(&self->bottom, bottom, memory_order_relaxed);
+    atomic_thread_fence(memory_order_seq_cst);
+    int64_t top = atomic_load_explicit(&self->top, memory_order_relaxed);
+    if (top > bottom)
+    {
+        atomic_store_explicit(&self->bottom, bottom + 1, memory_order_relaxed);
+        return false;
+    }
+    *out = read_slot(&self->slots[bottom % deque_capacity]);
+    if (top == bottom)
+    {
+        // Last task: race against the thieves for it
+        bool won = atomic_compare_exchange_strong_explicit(
+            &self->top, &top, top + 1,
+            memory_order_seq_cst, memory_order_relaxed
+        );
+        atomic_store_explicit(&self->bottom, bottom + 1, memory_order_relaxed);
+        return won;
+    }
+    return true;
+}
+
+// Called by any thread
+static bool deque_steal(worker* victim, task* out)
+{
+    int64_t top = atomic_load_explicit(&victim->top, memory_order_acquire);
+    atomic_thread_fence(memory_order_seq_cst);
+    int64_t bottom = atomic_load_explicit(&victim->bottom, memory_order_acquire);
+    if (top >= bottom)
+    {
+        return false;
+    }
+    *out = read_slot(&victim->slots[top % deque_capacity]);
+    return atomic_compare_exchange_strong_explicit(
+        &victim->top, &top, top + 1,
+        memory_order_seq_cst, memory_order_relaxed
+    );
+}
+
+static bool deque_is_empty(worker* victim)
+{
+    int64_t top = atomic_load_explicit(&victim->top, memory_order_acquire);
+    int64_t bottom = atomic_load_explicit(&victim->bottom, memory_order_acquire);
+    return top >= bottom;
+}
+
+////////////////////////////////////////////////////////////
+// Shared queue
+
+// Returns false when the queue can not grow
+static bool queue_push(sgl_thread_pool* pool, task value)
+{
+    mtx_lock(&pool->queue_mutex);
+    if (pool->queue_size == pool->queue_capacity)
+    {
+        size_t new_capacity = pool->queue_capacity ? 2 * pool->queue_capacity : 64;
+        task* new_queue = malloc(new_capacity * sizeof(task));
+        if (not new_queue)
+        {
+            mtx_unlock(&pool->queue_mutex);
+            return false;
+        }
+        for (size_t i = 0 ; i < pool->queue_size ; ++i)
+        {
+            size_t pos = (pool->queue_head + i) % pool->queue_capacity;
+            new_queue[i] = pool->queue[pos];
+        }
+        free(pool->queue);
+        pool->queue = new_queue;
+        pool->queue_head = 0;
+        pool->queue_capacity = new_capacity;
+    }
+    size_t pos = (pool->queue_head + pool->queue_size) % pool->queue_capacity;
+    pool->queue[pos] = value;
+    ++pool->queue_size;
+    atomic_store(&pool->queue_count, pool->queue_size);
+    mtx_unlock(&pool->queue_mutex);
+    return true;
+}
+
+static bool queue_pop(sgl_thread_pool* pool, task* out)
+{
+    if (atomic_load_explicit(&pool->queue_count, memory_order_acquire) == 0)
+    {
+        return false;
+    }
+    mtx_lock(&pool->queue_mutex);
+    bool res = pool->queue_size > 0;
+    if (res)
+    {
+        *out = pool->queue[pool->queue_head];
+        pool->queue_head = (pool->queue_head + 1) % pool->queue_capacity;
+        --pool->queue_size;
+        atomic_store(&pool->queue_count, pool->queue_size);
+    }
+    mtx_unlock(&pool->queue_mutex);
+    return res;
+}
+
+////////////////////////////////////////////////////////////
+// Scheduling
+
+static void run_task(task value)
+{
+    sgl_task_group* group = value.group;
+    sgl_thread_pool* pool = group->_pool;
+    value.func(value.arg);
+    // The group may be destroyed as soon as its count reaches 0
+    if (atomic_fetch_sub(&group->_pending, 1) == (blocked_flag | 1))
+    {
+        mtx_lock(&pool->mutex);
+        cnd_broadcast(&pool->done);
+        mtx_unlock(&pool->mutex);
+    }
+}
+
+// Finds a task for the given worker
+static bool find_task(sgl_thread_pool* pool, worker* self, task* out)
+{
+    if (deque_pop(self, out))
+    {
+        return true;
+    }
+    if (queue_pop(pool, out))
+    {
+        return true;
+    }
+    size_t start = (size_t) (next_random(&self->seed) % pool->size);
+    for (size_t i = 0 ; i < pool->size ; ++i)
+    {
+        worker* victim = &pool->workers[(start + i) % pool->size];
+        if (victim != self and deque_steal(victim, out))
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+static bool has_task(sgl_thread_pool* pool)
+{
+    if (atomic_load(&pool->queue_count) > 0)
+    {
+        return true;
+    }
+    for (size_t i = 0 ; i < pool->size ; ++i)
+    {
+        if (not deque_is_empty(&pool->workers[i]))
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+// Wakes a parked worker after a task has been made visible
+static void notify(sgl_thread_pool* pool)
+{
+    atomic_thread_fence(memory_order_seq_cst);
+    if (atomic_load_explicit(&pool->sleeping, memory_order_relaxed) > 0)
+    {
+        mtx_lock(&pool->mutex);
+        ++pool->epoch;
+        cnd_signal(&pool->cond);
+        mtx_unlock(&pool->mutex);
+    }
+}
+
+// Returns false when the pool is stopping
+static bool park(sgl_thread_pool* pool)
+{
+    mtx_lock(&pool->mutex);
+    atomic_fetch_add(&pool->sleeping, 1);
+    atomic_thread_fence(memory_order_seq_cst);
+    if (not has_task(pool))
+    {
+        size_t epoch = pool->epoch;
+        while (epoch == pool->epoch and not pool->stop)
+        {
+            cnd_wait(&pool->cond, &pool->mutex);
+        }
+    }
+    atomic_fetch_sub(&pool->sleeping, 1);
+    bool res = not pool->stop;
+    mtx_unlock(&pool->mutex);
+    return res;
+}
+
+static int worker_main(void* arg)
+{
+    worker* self = arg;
+    sgl_thread_pool* pool = self->pool;
+    current_worker = self;
+
+    for (;;)
+    {
+        task value;
+        bool found = false;
+        for (int round = 0 ; round < idle_rounds ; ++round)
+        {
+            if (find_task(pool, self, &value))
+            {
+                found = true;
+                break;
+            }
+            thrd_yield();
+        }
+        if (found)
+        {
+            run_task(value);
+        }
+        else if (not park(pool) and not has_task(pool))
+        {
+            return 0;
+        }
+    }
+}
+
+////////////////////////////////////////////////////////////
+// Thread pool
+
+// Returns NULL and sets error on failure
+static sgl_thread_pool* create_pool(size_t threads, sgl_exception_t* error)
+{
+    if (threads == 0)
+    {
+        threads = sgl_hardware_concurrency();
+    }
+
+    sgl_thread_pool* pool = malloc(sizeof(sgl_thread_pool));
+    if (not pool)
+    {
+        *error = sgl_bad_alloc;
+        return NULL;
+    }
+    pool->workers = sgl_detail_allocate(NULL, threads * sizeof(worker),
+                                        alignof(worker));
+    if (not pool->workers)
+    {
+        free(pool);
+        *error = sgl_bad_alloc;
+        return NULL;
+    }
+    pool->size = threads;
+    pool->queue = NULL;
+    pool->queue_head = 0;
+    pool->queue_size = 0;
+    pool->queue_capacity = 0;
+    atomic_init(&pool->queue_count, 0);
+    pool->epoch = 0;
+    pool->stop = false;
+    atomic_init(&pool->sleeping, 0);
+    mtx_init(&pool->queue_mutex, mtx_plain);
+    mtx_init(&pool->mutex, mtx_plain);
+    cnd_init(&pool->cond);
+    cnd_init(&pool->done);
+
+    for (size_t i = 0 ; i < threads ; ++i)
+    {
+        worker* self = &pool->workers[i];
+        atomic_init(&self->top, 0);
+        atomic_init(&self->bottom, 0);
+        self->pool = pool;
+        self->seed = UINT64_C(0x9e3779b97f4a7c15) * (i + 1);
+        self->started = false;
+    }
+    size_t started = 0;
+    for (size_t i = 0 ; i < threads ; ++i)
+    {
+        worker* self = &pool->workers[i];
+        int res = thrd_create(&self->thread, &worker_main, self);
+        self->started = res == thrd_success;
+        started += self->started;
+    }
+    if (started == 0)
+    {
+        sgl_thread_pool_delete(pool);
+        *error = sgl_runtime_error;
+        return NULL;
+    }
+    return pool;
+}
+
+sgl_thread_pool* sgl_thread_pool_new(size_t threads)
+{
+    sgl_exception_t error;
+    sgl_thread_pool* pool = create_pool(threads, &error);
+    if (not pool)
+    {
+        sgl_throw(error);
+    }
+    return pool;
+}
+
+static sgl_thread_pool* default_pool = NULL;
+static once_flag default_pool_flag = ONCE_FLAG_INIT;
+
+static void create_default_pool(void)
+{
+    sgl_exception_t error;
+    default_pool = create_pool(0, &error);
+}
+
+sgl_thread_pool* sgl_default_thread_pool(void)
+{
+    call_once(&default_pool_flag, &create_default_pool);
+    return default_pool;
+}
+
+void sgl_thread_pool_delete(sgl_thread_pool* pool)
+{
+    mtx_lock(&pool->mutex);
+    pool->stop = true;
+    cnd_broadcast(&pool->cond);
+    mtx_unlock(&pool->mutex);
+
+    for (size_t i = 0 ; i < pool->size ; ++i)
+    {
+        if (pool->workers[i].started)
+        {
+            thrd_join(pool->workers[i].thread, NULL);
+        }
+    }
+    cnd_destroy(&pool->done);
+    cnd_destroy(&pool->cond);
+    mtx_destroy(&pool->mutex);
+    mtx_destroy(&pool->queue_mutex);
+    free(pool->queue);
+    sgl_detail_deallocate(NULL, pool->workers, pool->size * sizeof(worker));
+    free(pool);
+}
+
+size_t sgl_thread_pool_size(const sgl_thread_pool* pool)
+{
+    return pool->size;
+}
+
+////////////////////////////////////////////////////////////
+// Task groups
+
+void sgl_spawn(sgl_task_group* group, void (*func)(void*), void* arg)
+{
+    sgl_thread_pool* pool = group->_pool;
+    task value = { func, arg, group };
+    atomic_fetch_add_explicit(&group->_pending, 1, memory_order_relaxed);
+
+    worker* self = current_worker;
+    bool pushed = self and self->pool == pool ? deque_push(self, value)
+                                               : queue_push(pool, value);
+    if (pushed)
+    {
+        notify(pool);
+    }
+    else
+    {
+        run_task(value);
+    }
+}
+
+void sgl_wait(sgl_task_group* group)
+{
+    sgl_thread_pool* pool = group->_pool;
+    worker* self = current_worker;
+    if (self and self->pool == pool)
+    {
+        // Workers run other tasks meanwhile, their own ones first
+        while ((atomic_load_explicit(&group->_pending, memory_order_acquire)
+                & ~blocked_flag) != 0)
+        {
+            task value;
+            if (find_task(pool, self, &value))
+            {
+                run_task(value);
+            }
+            else
+            {
+                thrd_yield();
+            }
+        }
+        return;
+    }
+
+    // Other threads block until the last task of the group is done;
+    // running tasks from the shared queue would nest them without
+    // bound on their stack
+    if ((atomic_fetch_or(&group->_pending, blocked_flag) & ~blocked_flag) != 0)
+    {
+        mtx_lock(&pool->mutex);
+        while ((atomic_load(&group->_pending) & ~blocked_flag) != 0)
+        {
+            cnd_wait(&pool->done, &pool->mutex);
+        }
+        mtx_unlock(&pool->mutex);
+    }
+    atomic_fetch_and(&group->_pending, ~blocked_flag);
+}
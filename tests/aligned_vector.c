@@ -0,0 +1,73 @@
+/*
+ * Copyright (C) 2015 Morwenn
+ *
+ * The SGL is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * The SGL is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program. If not,
+ * see <http://www.gnu.org/licenses/>.
+ */
+#include <assert.h>
+#include <stdint.h>
+#include <sgl/memory.h>
+#include <sgl/type_traits.h>
+#include <sgl/utility.h>
+#include <sgl/vector.h>
+
+sgl_define(sgl_vector(float))
+sgl_define(sgl_aligned_vector(float, 64))
+
+static_assert(sgl_alignment(sgl_vector(float)) == alignof(float),
+              "wrong alignment for sgl_vector(float)");
+static_assert(sgl_alignment(sgl_aligned_vector(float, 64)) == 64,
+              "wrong alignment for sgl_aligned_vector(float, 64)");
+
+static bool is_aligned(const void* ptr, size_t alignment)
+{
+    return (uintptr_t) ptr % alignment == 0;
+}
+
+int main()
+{
+    sgl_aligned_vector(float, 64)* vec = sgl_new(sgl_aligned_vector(float, 64));
+    for (int i = 0 ; i < 1000 ; ++i)
+    {
+        sgl_push_back(vec, (float) i);
+        assert(is_aligned(sgl_data(vec), 64));
+    }
+
+    sgl_erase(vec, sgl_begin(vec) + 3, sgl_end(vec));
+    sgl_shrink_to_fit(vec);
+    assert(is_aligned(sgl_data(vec), 64));
+    assert(sgl_at(vec, 2) == 2.0f);
+
+    // The const accessors return pointers to const in both dispatch modes
+    static_assert(sgl_is_instance(sgl_cbegin(vec), const float*), "");
+    static_assert(sgl_is_instance(sgl_cend(vec), const float*), "");
+    static_assert(sgl_is_instance(sgl_begin(vec), float*), "");
+    assert(sgl_cend(vec) - sgl_cbegin(vec) == 3);
+
+    sgl_assign(vec, 5000, 1.0f);
+    assert(is_aligned(sgl_data(vec), 64));
+    sgl_delete(vec);
+
+    // Aligned storage also works with user allocators
+    sgl_arena arena;
+    sgl_arena_init(&arena, 4096);
+    sgl_aligned_vector(float, 64) local;
+    sgl_init_with_allocator(sgl_aligned_vector(float, 64), &local,
+                            sgl_arena_allocator(&arena));
+    sgl_arena_allocate(&arena, 1, 1);
+    sgl_resize(&local, 100, 3.0f);
+    assert(is_aligned(sgl_data(&local), 64));
+    sgl_destroy(&local);
+    sgl_arena_destroy(&arena);
+}
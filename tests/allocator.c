@@ -0,0 +1,115 @@
+/*
+ * Copyright (C) 2015 Morwenn
+ *
+ * The SGL is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * The SGL is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program. If not,
+ * see <http://www.gnu.org/licenses/>.
+ */
+#include <stdlib.h>
+#include <sgl/memory.h>
+#include <sgl/utility.h>
+#include <sgl/vector.h>
+
+sgl_define(sgl_vector(int))
+
+typedef struct
+{
+    size_t allocations;
+    size_t reallocations;
+    size_t deallocations;
+    size_t bytes_in_use;
+} counters;
+
+static void* counting_allocate(void* context, size_t size, size_t alignment)
+{
+    (void) alignment;
+    counters* c = context;
+    ++c->allocations;
+    c->bytes_in_use += size;
+    return malloc(size);
+}
+
+static void* counting_reallocate(void* context, void* ptr, size_t old_size,
+                                 size_t new_size, size_t alignment)
+{
+    (void) alignment;
+    counters* c = context;
+    ++c->reallocations;
+    c->bytes_in_use += new_size - old_size;
+    return realloc(ptr, new_size);
+}
+
+static void counting_deallocate(void* context, void* ptr, size_t size)
+{
+    counters* c = context;
+    if (ptr != NULL)
+    {
+        ++c->deallocations;
+        c->bytes_in_use -= size;
+    }
+    free(ptr);
+}
+
+int main()
+{
+    counters c = { 0, 0, 0, 0 };
+    sgl_allocator allocator = {
+        counting_allocate,
+        counting_reallocate,
+        counting_deallocate,
+        &c
+    };
+
+    // Heap-allocated vector
+    sgl_vector(int)* vec = sgl_new_with_allocator(sgl_vector(int), &allocator);
+    assert(c.allocations == 1);
+    assert(c.bytes_in_use == sizeof(sgl_vector(int)));
+
+    for (int i = 0 ; i < 1000 ; ++i)
+    {
+        sgl_push_back(vec, i);
+    }
+    assert(c.reallocations > 0);
+    assert(c.bytes_in_use == sizeof(sgl_vector(int)) + sgl_capacity(vec) * sizeof(int));
+
+    sgl_shrink_to_fit(vec);
+    assert(c.bytes_in_use == sizeof(sgl_vector(int)) + 1000 * sizeof(int));
+
+    sgl_assign(vec, 5000, 42);
+    assert(c.bytes_in_use == sizeof(sgl_vector(int)) + 5000 * sizeof(int));
+
+    sgl_delete(vec);
+    assert(c.bytes_in_use == 0);
+
+    // Vector with automatic storage duration, which does not
+    // allocate before its first insertion
+    sgl_vector(int) local;
+    size_t allocations = c.allocations;
+    sgl_init_with_allocator(sgl_vector(int), &local, &allocator);
+    assert(c.allocations == allocations);
+    sgl_destroy(&local);
+    assert(c.bytes_in_use == 0);
+    sgl_init_with_allocator(sgl_vector(int), &local, &allocator);
+    sgl_resize(&local, 100, 1);
+    assert(sgl_at(&local, 99) == 1);
+    assert(c.bytes_in_use == sgl_capacity(&local) * sizeof(int));
+    sgl_destroy(&local);
+    assert(c.bytes_in_use == 0);
+
+    // The default allocator does not go through the counters
+    allocations = c.allocations;
+    sgl_vector(int)* other = sgl_new(sgl_vector(int));
+    sgl_push_back(other, 1);
+    sgl_delete(other);
+    assert(c.allocations == allocations);
+}
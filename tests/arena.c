@@ -0,0 +1,102 @@
+/*
+ * Copyright (C) 2015 Morwenn
+ *
+ * The SGL is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * The SGL is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program. If not,
+ * see <http://www.gnu.org/licenses/>.
+ */
+#include <assert.h>
+#include <stdint.h>
+#include <string.h>
+#include <sgl/memory.h>
+#include <sgl/utility.h>
+#include <sgl/vector.h>
+
+sgl_define(sgl_vector(int))
+
+static bool is_aligned(const void* ptr, size_t alignment)
+{
+    return (uintptr_t) ptr % alignment == 0;
+}
+
+int main()
+{
+    sgl_arena arena;
+    sgl_arena_init(&arena, 1024);
+
+    // Zero-size allocations return usable pointers, even before
+    // the first chunk is allocated and after a reset
+    void* empty = sgl_arena_allocate(&arena, 0, 1);
+    assert(empty != NULL);
+    sgl_arena_reset(&arena);
+    empty = sgl_arena_allocate(&arena, 0, 16);
+    assert(empty != NULL);
+    const sgl_allocator* allocator = sgl_arena_allocator(&arena);
+    sgl_arena_reset(&arena);
+    empty = allocator->allocate(allocator->context, 0, 8);
+    assert(empty != NULL);
+    (void) empty;
+
+    // Alignments from 1 to more than the alignment of the chunks
+    for (size_t alignment = 1 ; alignment <= 4096 ; alignment *= 2)
+    {
+        char* odd = sgl_arena_allocate(&arena, 1, 1);
+        void* ptr = sgl_arena_allocate(&arena, 24, alignment);
+        assert(is_aligned(ptr, alignment));
+        assert((char*) ptr > odd);
+        memset(ptr, 0xFF, 24);
+    }
+
+    // Rewinding to a mark frees what was allocated after it, in
+    // the same chunk and in the following ones
+    sgl_arena_reset(&arena);
+    char* first = sgl_arena_allocate(&arena, 100, 1);
+    sgl_arena_mark mark = sgl_arena_save(&arena);
+    char* second = sgl_arena_allocate(&arena, 100, 1);
+    assert(second == first + 100);
+    sgl_arena_rewind(&arena, mark);
+    char* ptr = sgl_arena_allocate(&arena, 100, 1);
+    assert(ptr == second);
+    sgl_arena_rewind(&arena, mark);
+    char* big = sgl_arena_allocate(&arena, 5000, 8);
+    assert(big < first || big >= first + 1024);
+    sgl_arena_rewind(&arena, mark);
+    ptr = sgl_arena_allocate(&arena, 100, 1);
+    assert(ptr == second);
+
+    // A reset keeps the chunks: the same allocations get the same
+    // addresses, including the ones which needed a new chunk
+    sgl_arena_reset(&arena);
+    ptr = sgl_arena_allocate(&arena, 100, 1);
+    assert(ptr == first);
+    ptr = sgl_arena_allocate(&arena, 100, 1);
+    assert(ptr == second);
+    ptr = sgl_arena_allocate(&arena, 5000, 8);
+    assert(ptr == big);
+    (void) ptr;
+
+    // Vector growing in place at the end of the arena, then freed
+    // at once with a rewind
+    mark = sgl_arena_save(&arena);
+    sgl_vector(int)* vec = sgl_new_with_allocator(sgl_vector(int), allocator);
+    for (int i = 0 ; i < 10000 ; ++i)
+    {
+        sgl_push_back(vec, i);
+    }
+    for (int i = 0 ; i < 10000 ; ++i)
+    {
+        assert(sgl_at(vec, i) == i);
+    }
+    sgl_arena_rewind(&arena, mark);
+    sgl_arena_destroy(&arena);
+}
@@ -0,0 +1,67 @@
+/*
+ * Copyright (C) 2015 Morwenn
+ *
+ * The SGL is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * The SGL is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program. If not,
+ * see <http://www.gnu.org/licenses/>.
+ */
+#include <assert.h>
+#include <math.h>
+#include <sgl/utility.h>
+#include <sgl/vector.h>
+
+sgl_define(sgl_vector(int))
+sgl_define(sgl_vector(double))
+
+int main()
+{
+    sgl_vector(int)* a = sgl_new(sgl_vector(int));
+    sgl_vector(int)* b = sgl_new(sgl_vector(int));
+    assert(sgl_equal(a, b));
+    assert(not sgl_lexicographical_compare(a, b));
+
+    for (int i = 0 ; i < 1000 ; ++i)
+    {
+        sgl_push_back(a, i);
+        sgl_push_back(b, i);
+    }
+    assert(sgl_equal(a, b));
+    assert(not sgl_not_equal(a, b));
+    assert(not sgl_lexicographical_compare(a, b));
+
+    // A prefix is less than the whole sequence
+    sgl_pop_back(b);
+    assert(sgl_not_equal(a, b));
+    assert(sgl_lexicographical_compare(b, a));
+    assert(not sgl_lexicographical_compare(a, b));
+
+    // Signed elements are not compared bytewise
+    sgl_push_back(b, -1);
+    assert(sgl_lexicographical_compare(b, a));
+    sgl_at(b, 999) = 1000;
+    assert(sgl_lexicographical_compare(a, b));
+    sgl_delete(a);
+    sgl_delete(b);
+
+    // Floating point elements are compared with ==
+    sgl_vector(double)* x = sgl_new(sgl_vector(double));
+    sgl_vector(double)* y = sgl_new(sgl_vector(double));
+    sgl_push_back(x, 0.0);
+    sgl_push_back(y, -0.0);
+    assert(sgl_equal(x, y));
+    sgl_push_back(x, NAN);
+    sgl_push_back(y, NAN);
+    assert(sgl_not_equal(x, y));
+    sgl_delete(x);
+    sgl_delete(y);
+}
@@ -0,0 +1,136 @@
+/*
+ * Copyright (C) 2015 Morwenn
+ *
+ * The SGL is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * The SGL is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program. If not,
+ * see <http://www.gnu.org/licenses/>.
+ */
+#include <assert.h>
+#include <stdlib.h>
+#include <sgl/deque.h>
+#include <sgl/utility.h>
+
+sgl_define(sgl_deque(int))
+
+int main()
+{
+    sgl_deque(int)* deque = sgl_new(sgl_deque(int));
+    assert(sgl_is_empty(deque));
+
+    // Addresses stay valid while elements are added at both ends
+    enum { count = 10000 };
+    sgl_push_back(deque, 0);
+    int* first = &sgl_front(deque);
+    for (int i = 1 ; i < count ; ++i)
+    {
+        sgl_push_back(deque, i);
+        sgl_push_front(deque, -i);
+    }
+    assert(sgl_size(deque) == 2 * count - 1);
+    assert(*first == 0);
+    assert(first == &sgl_at(deque, count - 1));
+    assert(sgl_front(deque) == -(count - 1));
+    assert(sgl_back(deque) == count - 1);
+    for (size_t i = 0 ; i < sgl_size(deque) ; ++i)
+    {
+        assert(sgl_at(deque, i) == (int) i - (count - 1));
+    }
+
+    // Drain from both ends
+    while (sgl_size(deque) > 1)
+    {
+        sgl_pop_front(deque);
+        sgl_pop_back(deque);
+    }
+    assert(&sgl_front(deque) == first);
+    sgl_pop_back(deque);
+    assert(sgl_is_empty(deque));
+
+    // Popping an empty deque does nothing
+    sgl_pop_back(deque);
+    sgl_pop_front(deque);
+    assert(sgl_is_empty(deque));
+    assert(sgl_size(deque) == 0);
+    sgl_push_back(deque, 1);
+    sgl_push_front(deque, 0);
+    assert(sgl_size(deque) == 2);
+    assert(sgl_front(deque) == 0);
+    assert(sgl_back(deque) == 1);
+    sgl_pop_front(deque);
+    sgl_pop_front(deque);
+    sgl_pop_front(deque);
+    assert(sgl_is_empty(deque));
+
+    // Random operations against a reference ring buffer
+    int ref[4096];
+    size_t head = 0, size = 0;
+    srand(42);
+    for (int i = 0 ; i < 200000 ; ++i)
+    {
+        switch (rand() % 5)
+        {
+            case 0:
+                if (size == 4096) break;
+                sgl_push_back(deque, i);
+                ref[(head + size++) % 4096] = i;
+                break;
+            case 1:
+                if (size == 4096) break;
+                sgl_push_front(deque, i);
+                head = (head + 4095) % 4096;
+                ref[head] = i;
+                ++size;
+                break;
+            case 2:
+                if (size == 0) break;
+                sgl_pop_back(deque);
+                --size;
+                break;
+            case 3:
+                if (size == 0) break;
+                sgl_pop_front(deque);
+                head = (head + 1) % 4096;
+                --size;
+                break;
+            default:
+                // Work queue: push at the back, pop at the front
+                if (size == 0 || size == 4096) break;
+                sgl_push_back(deque, i);
+                ref[(head + size++) % 4096] = i;
+                sgl_pop_front(deque);
+                head = (head + 1) % 4096;
+                --size;
+                break;
+        }
+        assert(sgl_size(deque) == size);
+        if (size)
+        {
+            assert(sgl_front(deque) == ref[head]);
+            assert(sgl_back(deque) == ref[(head + size - 1) % 4096]);
+            size_t index = (size_t) rand() % size;
+            assert(sgl_at(deque, index) == ref[(head + index) % 4096]);
+        }
+    }
+
+    sgl_clear(deque);
+    assert(sgl_is_empty(deque));
+    sgl_shrink_to_fit(deque);
+    sgl_push_front(deque, 5);
+    assert(sgl_back(deque) == 5);
+    sgl_delete(deque);
+
+    sgl_deque(int) local;
+    sgl_init(sgl_deque(int), &local);
+    sgl_push_back(&local, 1);
+    sgl_destroy(&local);
+}
@@ -0,0 +1,105 @@
+/*
+ * Copyright (C) 2015 Morwenn
+ *
+ * The SGL is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * The SGL is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program. If not,
+ * see <http://www.gnu.org/licenses/>.
+ */
+#include <assert.h>
+#include <sgl/exception.h>
+
+static int max_depth = 0;
+
+// Nests try blocks until sgl_try refuses to enter one more
+static void nest(int depth)
+{
+    if (depth > SGL_MAX_EXCEPTIONS)
+    {
+        // The buffers would have overflowed
+        return;
+    }
+    sgl_try
+    {
+        max_depth = depth;
+        nest(depth + 1);
+    }
+    sgl_catch(sgl_out_of_range)
+    {
+        assert(false);
+    }
+    sgl_endtry
+}
+
+// Every try block catches and rethrows the exception
+static void rethrow_from(int depth, sgl_exception_t exception)
+{
+    if (depth == 0)
+    {
+        if (exception != sgl_exception)
+        {
+            sgl_throw(exception);
+        }
+        return;
+    }
+    sgl_try
+    {
+        rethrow_from(depth - 1, exception);
+    }
+    sgl_catch(sgl_overflow_error)
+    {
+        sgl_rethrow();
+    }
+    sgl_endtry
+}
+
+// Returns whether nesting try blocks from the outermost one ends
+// with sgl_length_error
+static bool nest_until_refused(void)
+{
+    bool caught = false;
+    max_depth = 0;
+    sgl_try
+    {
+        nest(1);
+    }
+    sgl_catch(sgl_length_error)
+    {
+        caught = true;
+    }
+    sgl_endtry
+    return caught;
+}
+
+int main()
+{
+    for (int i = 0 ; i < 3 ; ++i)
+    {
+        assert(nest_until_refused());
+        assert(max_depth == SGL_MAX_EXCEPTIONS - 1);
+        assert(sgl_detail_exceptions_index == -1);
+    }
+
+    // The deepest nesting allowed still works
+    bool caught = false;
+    sgl_try
+    {
+        rethrow_from(SGL_MAX_EXCEPTIONS - 1, sgl_overflow_error);
+    }
+    sgl_catch(sgl_runtime_error)
+    {
+        caught = true;
+    }
+    sgl_endtry
+    assert(caught);
+    assert(sgl_detail_exceptions_index == -1);
+}
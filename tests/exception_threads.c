@@ -0,0 +1,192 @@
+/*
+ * Copyright (C) 2015 Morwenn
+ *
+ * The SGL is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * The SGL is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program. If not,
+ * see <http://www.gnu.org/licenses/>.
+ */
+#include <assert.h>
+#include <stdatomic.h>
+#include <stdlib.h>
+#include <threads.h>
+#include <sgl/exception.h>
+#include <sgl/memory.h>
+#include <sgl/thread.h>
+#include <sgl/utility.h>
+#include <sgl/vector.h>
+
+sgl_define(sgl_vector(int))
+
+enum { iterations = 20000 };
+
+static atomic_size_t caught_count;
+
+// Reallocations fail once the limit is reached
+static void* limited_allocate(void* context, size_t size, size_t alignment)
+{
+    (void) context;
+    (void) alignment;
+    return malloc(size);
+}
+
+static void* limited_reallocate(void* context, void* ptr, size_t old_size,
+                                size_t new_size, size_t alignment)
+{
+    (void) old_size;
+    (void) alignment;
+    size_t limit = *(size_t*) context;
+    return new_size > limit ? NULL : realloc(ptr, new_size);
+}
+
+static void limited_deallocate(void* context, void* ptr, size_t size)
+{
+    (void) context;
+    (void) size;
+    free(ptr);
+}
+
+static void yield_and_throw(sgl_exception_t exception)
+{
+    thrd_yield();
+    if (exception != sgl_exception)
+    {
+        sgl_throw(exception);
+    }
+}
+
+// Throws from the given depth of nested try blocks which do not
+// catch the exception
+static void nested(int depth, sgl_exception_t exception)
+{
+    if (depth == 0)
+    {
+        yield_and_throw(exception);
+        return;
+    }
+    sgl_try
+    {
+        nested(depth - 1, exception);
+    }
+    sgl_catch(sgl_out_of_range)
+    {
+        assert(false);
+    }
+    sgl_endtry
+}
+
+// Throws sgl_bad_alloc from an sgl_vector, which is deleted by
+// an intermediate try block
+static void overflow_vector(const sgl_allocator* allocator)
+{
+    sgl_vector(int)* vec = sgl_new_with_allocator(sgl_vector(int), allocator);
+    sgl_try
+    {
+        for (int j = 0 ; j < 1000 ; ++j)
+        {
+            sgl_push_back(vec, j);
+        }
+    }
+    sgl_catch(sgl_exception)
+    {
+        sgl_delete(vec);
+        sgl_rethrow();
+    }
+    sgl_endtry
+}
+
+// Runs iteration i of a thread and returns the exception caught
+static sgl_exception_t throw_and_catch(size_t i, sgl_exception_t exception,
+                                       const sgl_allocator* allocator)
+{
+    // Written after the longjmp, hence volatile
+    volatile sgl_exception_t caught = sgl_exception;
+    sgl_try
+    {
+        if (i % 16 == 0)
+        {
+            overflow_vector(allocator);
+        }
+        else
+        {
+            nested((int) (i % 6), exception);
+        }
+    }
+    sgl_catch(sgl_domain_error)
+    {
+        caught = sgl_domain_error;
+    }
+    sgl_catch(sgl_overflow_error)
+    {
+        caught = sgl_overflow_error;
+    }
+    sgl_catch(sgl_bad_alloc)
+    {
+        caught = sgl_bad_alloc;
+    }
+    sgl_endtry
+    return caught;
+}
+
+static int stress(void* arg)
+{
+    size_t id = (size_t) arg;
+    static const sgl_exception_t exceptions[] = {
+        sgl_domain_error,
+        sgl_overflow_error,
+        sgl_bad_alloc
+    };
+
+    size_t limit = 64 * sizeof(int);
+    sgl_allocator allocator = {
+        limited_allocate,
+        limited_reallocate,
+        limited_deallocate,
+        &limit
+    };
+
+    for (size_t i = 0 ; i < iterations ; ++i)
+    {
+        assert(sgl_detail_exceptions_index == -1);
+        // Every 16th iteration, the exception is thrown by a container
+        sgl_exception_t expected = i % 16 == 0 ? sgl_bad_alloc
+                                               : exceptions[(i + id) % 3];
+        sgl_exception_t caught = throw_and_catch(i, expected, &allocator);
+        assert(caught == expected);
+        (void) caught;
+        atomic_fetch_add(&caught_count, 1);
+    }
+    return 0;
+}
+
+int main()
+{
+    // One thread per processor, and at least a few so that the
+    // threads are interleaved on any machine
+    size_t count = sgl_hardware_concurrency();
+    count = count < 4 ? 4 : count;
+    thrd_t* threads = malloc(count * sizeof(thrd_t));
+    assert(threads);
+    for (size_t i = 0 ; i < count ; ++i)
+    {
+        int res = thrd_create(&threads[i], &stress, (void*) i);
+        assert(res == thrd_success);
+        (void) res;
+    }
+    stress((void*) count);
+    for (size_t i = 0 ; i < count ; ++i)
+    {
+        thrd_join(threads[i], NULL);
+    }
+    free(threads);
+    assert(atomic_load(&caught_count) == (count + 1) * iterations);
+}
@@ -0,0 +1,99 @@
+/*
+ * Copyright (C) 2015 Morwenn
+ *
+ * The SGL is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * The SGL is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program. If not,
+ * see <http://www.gnu.org/licenses/>.
+ */
+#include <assert.h>
+#include <sgl/algorithm.h>
+#include <sgl/utility.h>
+#include <sgl/vector.h>
+
+sgl_define(sgl_vector(int))
+sgl_define(sgl_vector(double))
+
+#define increment(ptr) \
+    (++*(ptr))
+
+static inline double halve(int value)
+{
+    return value / 2.0;
+}
+
+#define add(acc, value) \
+    ((acc) + (value))
+
+#define is_odd(value) \
+    ((value) % 2 != 0)
+
+typedef long long llong;
+
+sgl_define(sgl_for_each(int, increment))
+sgl_define(sgl_transform(int, double, halve))
+sgl_define(sgl_reduce(double, add))
+sgl_define(sgl_reduce(llong, add))
+sgl_define(sgl_count_if(int, is_odd))
+
+int main()
+{
+    sgl_execution_policy policies[] = { sgl_seq, sgl_par, sgl_par_unseq };
+    size_t sizes[] = { 0, 1, 1000, 2 * SGL_PARALLEL_GRAIN, 1000003 };
+    for (size_t s = 0 ; s < sizeof sizes / sizeof *sizes ; ++s)
+    {
+        size_t size = sizes[s];
+        for (size_t p = 0 ; p < sizeof policies / sizeof *policies ; ++p)
+        {
+            sgl_execution_policy policy = policies[p];
+            sgl_vector(int)* ints = sgl_new(sgl_vector(int));
+            sgl_vector(double)* doubles = sgl_new(sgl_vector(double));
+            sgl_resize(ints, size, 0);
+            sgl_resize(doubles, size, 0.0);
+
+            sgl_fill(policy, sgl_begin(ints), sgl_end(ints), 7);
+            for (size_t i = 0 ; i < size ; ++i)
+            {
+                assert(sgl_at(ints, i) == 7);
+                sgl_at(ints, i) = (int) i;
+            }
+
+            sgl_for_each(int, increment)(policy, sgl_begin(ints), sgl_end(ints));
+            assert(sgl_count_if(int, is_odd)(policy, sgl_begin(ints), sgl_end(ints))
+                   == (size + 1) / 2);
+
+            sgl_transform(int, double, halve)(policy, sgl_begin(ints), sgl_end(ints),
+                                              sgl_begin(doubles));
+            for (size_t i = 0 ; i < size ; ++i)
+            {
+                assert(sgl_at(doubles, i) == (double) (i + 1) / 2);
+            }
+
+            // The sums of halves are exact, whatever the order
+            double sum = sgl_reduce(double, add)(policy, sgl_begin(doubles),
+                                                 sgl_end(doubles), 0.5);
+            assert(sum == 0.5 + (double) size * (size + 1) / 4);
+
+            sgl_delete(doubles);
+            sgl_delete(ints);
+        }
+    }
+
+    llong values[100000];
+    sgl_fill(sgl_seq, values, values + 100000, 3);
+    assert(sgl_reduce(llong, add)(sgl_par_unseq, values, values + 100000, 0) == 300000);
+    assert(sgl_reduce(llong, add)(sgl_par_unseq, values, values + 21, 1) == 64);
+    int small[5] = { 1, 2, 3, 4, 5 };
+    sgl_for_each(int, increment)(sgl_seq, small, small + 5);
+    assert(sgl_count_if(int, is_odd)(sgl_seq, small, small + 5) == 2);
+    assert(sgl_count_if(int, is_odd)(sgl_par, small, small + 5) == 2);
+}
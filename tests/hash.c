@@ -0,0 +1,141 @@
+/*
+ * Copyright (C) 2015 Morwenn
+ *
+ * The SGL is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * The SGL is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program. If not,
+ * see <http://www.gnu.org/licenses/>.
+ */
+#include <assert.h>
+#include <stdint.h>
+#include <string.h>
+#include <sgl/hash.h>
+#include <sgl/utility.h>
+#include <sgl/vector.h>
+
+sgl_define(sgl_vector(int))
+
+static int popcount(uint64_t value)
+{
+    int res = 0;
+    for ( ; value ; value &= value - 1)
+    {
+        ++res;
+    }
+    return res;
+}
+
+// Flipping one input bit should flip about half of the output bits
+static void check_avalanche(size_t (*hash)(const uint8_t*, size_t), size_t size)
+{
+    uint8_t data[64];
+    uint64_t state = 1;
+    long flipped = 0;
+    long samples = 0;
+    for (int round = 0 ; round < 200 ; ++round)
+    {
+        for (size_t i = 0 ; i < size ; ++i)
+        {
+            state = state * UINT64_C(6364136223846793005) + 1;
+            data[i] = (uint8_t) (state >> 56);
+        }
+        uint64_t reference = hash(data, size);
+        for (size_t bit = 0 ; bit < size * 8 ; ++bit)
+        {
+            data[bit / 8] ^= (uint8_t) (1u << (bit % 8));
+            flipped += popcount(reference ^ hash(data, size));
+            data[bit / 8] ^= (uint8_t) (1u << (bit % 8));
+            ++samples;
+        }
+    }
+    double ratio = (double) flipped / (samples * 64.0);
+    assert(ratio > 0.49 && ratio < 0.51);
+}
+
+static size_t hash_bytes(const uint8_t* data, size_t size)
+{
+    return sgl_hash_bytes(data, size);
+}
+
+static size_t hash_integer(const uint8_t* data, size_t size)
+{
+    uint64_t value = 0;
+    memcpy(&value, data, size);
+    return sgl_hash_integer(value);
+}
+
+// Sequential keys should fill the buckets of a table evenly
+static void check_distribution(void)
+{
+    enum { buckets = 1024, keys = buckets * 64 };
+    static int counts[buckets];
+    for (int key = 0 ; key < keys ; ++key)
+    {
+        ++counts[sgl_hash(key) % buckets];
+    }
+    double chi2 = 0.0;
+    for (int i = 0 ; i < buckets ; ++i)
+    {
+        double diff = counts[i] - 64.0;
+        chi2 += diff * diff / 64.0;
+    }
+    // 1023 degrees of freedom, the 99.9% quantile is about 1170
+    assert(chi2 < 1170.0);
+}
+
+int main()
+{
+    check_avalanche(hash_integer, 8);
+    check_avalanche(hash_bytes, 3);
+    check_avalanche(hash_bytes, 8);
+    check_avalanche(hash_bytes, 16);
+    check_avalanche(hash_bytes, 64);
+    check_distribution();
+
+    // Dispatch on the type of the value
+    const char* str = "generic";
+    char buffer[] = "generic";
+    assert(sgl_hash(str) == sgl_hash_bytes(str, strlen(str)));
+    assert(sgl_hash(buffer + 0) == sgl_hash(str));
+    assert(sgl_hash(42) == sgl_hash_integer(42));
+    assert(sgl_hash((char) 42) == sgl_hash(42LL));
+    assert(sgl_hash(0.0) == sgl_hash(-0.0));
+    assert(sgl_hash(1.5f) != sgl_hash(-1.5f));
+    assert(sgl_hash(&buffer[0]) != sgl_hash((void*) &buffer[0]));
+
+    // Seeds change every hash
+    assert(sgl_hash_seeded(42, 1) != sgl_hash_seeded(42, 2));
+    assert(sgl_hash_seeded(str, 1) != sgl_hash_seeded(str, 2));
+    assert(sgl_hash_seeded(str, 0) == sgl_hash(str));
+
+    // Every byte of the keys is used
+    for (size_t size = 1 ; size < 200 ; ++size)
+    {
+        uint8_t data[200] = { 0 };
+        size_t reference = sgl_hash_bytes(data, size);
+        for (size_t i = 0 ; i < size ; ++i)
+        {
+            data[i] = 1;
+            assert(sgl_hash_bytes(data, size) != reference);
+            data[i] = 0;
+        }
+        assert(sgl_hash_bytes(data, size - 1) != reference);
+    }
+
+    // Contents of a vector
+    sgl_vector(int)* vec = sgl_new(sgl_vector(int));
+    int values[] = { 1, 2, 3, 4, 5 };
+    sgl_append(vec, values, 5);
+    assert(sgl_hash_range(sgl_cbegin(vec), sgl_cend(vec))
+           == sgl_hash_bytes(values, sizeof values));
+    sgl_delete(vec);
+}
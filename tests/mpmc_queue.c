@@ -0,0 +1,170 @@
+/*
+ * Copyright (C) 2015 Morwenn
+ *
+ * The SGL is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * The SGL is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program. If not,
+ * see <http://www.gnu.org/licenses/>.
+ */
+#include <assert.h>
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <threads.h>
+#include <sgl/mpmc_queue.h>
+#include <sgl/utility.h>
+
+sgl_define(sgl_mpmc_queue(int))
+
+enum
+{
+    producers = 3,
+    consumers = 3,
+    per_producer = 50000,
+    total = producers * per_producer
+};
+
+static sgl_mpmc_queue(int)* queue;
+static unsigned char seen[total];
+static atomic_int consumed;
+
+static int produce(void* arg)
+{
+    int first = *(int*) arg * per_producer;
+    for (int i = 0 ; i < per_producer ; )
+    {
+        // Mix single, blocking and batched pushes
+        switch (i % 3)
+        {
+            case 0:
+                if (sgl_try_push(queue, first + i))
+                {
+                    ++i;
+                }
+                else
+                {
+                    thrd_yield();
+                }
+                break;
+            case 1:
+                sgl_push(queue, first + i);
+                ++i;
+                break;
+            default:
+            {
+                int batch[7];
+                int n = 0;
+                while (n < 7 && i + n < per_producer)
+                {
+                    batch[n] = first + i + n;
+                    ++n;
+                }
+                size_t pushed = sgl_push_n(queue, batch, (size_t) n);
+                if (pushed == 0)
+                {
+                    thrd_yield();
+                }
+                i += (int) pushed;
+            }
+        }
+    }
+    return 0;
+}
+
+static int consume(void* arg)
+{
+    (void) arg;
+    while (atomic_load(&consumed) < total)
+    {
+        int batch[6];
+        size_t n = sgl_pop_n(queue, batch, 5);
+        int value;
+        if (sgl_try_pop(queue, &value))
+        {
+            batch[n++] = value;
+        }
+        if (n == 0)
+        {
+            thrd_yield();
+            continue;
+        }
+        for (size_t i = 0 ; i < n ; ++i)
+        {
+            // Every value has its own cell, no synchronization needed
+            ++seen[batch[i]];
+        }
+        atomic_fetch_add(&consumed, (int) n);
+    }
+    return 0;
+}
+
+int main()
+{
+    // Single-threaded behaviour around the boundaries
+    queue = sgl_new_with_capacity(sgl_mpmc_queue(int), 3);
+    assert(sgl_capacity(queue) == 4);
+    int value;
+    bool popped = sgl_try_pop(queue, &value);
+    assert(not popped);
+    int values[6] = { 0, 1, 2, 3, 4, 5 };
+    int out[6];
+    size_t n = sgl_push_n(queue, values, 3);
+    assert(n == 3);
+    n = sgl_pop_n(queue, out, 2);
+    assert(n == 2);
+    assert(out[0] == 0 && out[1] == 1);
+    n = sgl_push_n(queue, values + 3, 3);
+    assert(n == 3);
+    bool pushed = sgl_try_push(queue, 42);
+    assert(not pushed);
+    assert(sgl_size(queue) == 4);
+    n = sgl_pop_n(queue, out, 6);
+    assert(n == 4);
+    assert(out[0] == 2 && out[1] == 3 && out[2] == 4 && out[3] == 5);
+    (void) popped;
+    (void) pushed;
+    (void) n;
+    sgl_push(queue, 42);
+    sgl_pop(queue, &value);
+    assert(value == 42);
+    assert(sgl_is_empty(queue));
+    sgl_delete(queue);
+
+    // Every value is received exactly once
+    queue = sgl_new_with_capacity(sgl_mpmc_queue(int), 64);
+    thrd_t threads[producers + consumers];
+    int ids[producers];
+    for (int i = 0 ; i < producers ; ++i)
+    {
+        ids[i] = i;
+        thrd_create(&threads[i], &produce, &ids[i]);
+    }
+    for (int i = 0 ; i < consumers ; ++i)
+    {
+        thrd_create(&threads[producers + i], &consume, NULL);
+    }
+    for (int i = 0 ; i < producers + consumers ; ++i)
+    {
+        thrd_join(threads[i], NULL);
+    }
+    assert(atomic_load(&consumed) == total);
+    for (int i = 0 ; i < total ; ++i)
+    {
+        assert(seen[i] == 1);
+    }
+    assert(sgl_is_empty(queue));
+    sgl_delete(queue);
+
+    sgl_mpmc_queue(int) local;
+    sgl_init(sgl_mpmc_queue(int), &local);
+    assert(sgl_capacity(&local) == SGL_MPMC_QUEUE_CAPACITY);
+    sgl_destroy(&local);
+}
@@ -0,0 +1,47 @@
+/*
+ * Copyright (C) 2015 Morwenn
+ *
+ * The SGL is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * The SGL is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program. If not,
+ * see <http://www.gnu.org/licenses/>.
+ */
+// Build with: cc -std=c11 -Iinclude tests/multi_tu/*.c src/exception.c
+
+#include <assert.h>
+#include "vectors.h"
+
+long long sum(const sgl_vector(int)* vec)
+{
+    long long res = 0;
+    for (size_t i = 0 ; i < sgl_size(vec) ; ++i)
+    {
+        res += sgl_at(vec, i);
+    }
+    return res;
+}
+
+int main()
+{
+    sgl_vector(int)* vec = sgl_new(sgl_vector(int));
+    fill_iota(vec, 1000);
+    assert(sgl_size(vec) == 1000);
+    assert(sgl_front(vec) == 0);
+    assert(sgl_back(vec) == 999);
+    assert(sum(vec) == 999 * 1000 / 2);
+
+    sgl_erase(vec, sgl_begin(vec), sgl_begin(vec) + 500);
+    assert(sgl_size(vec) == 500);
+    assert(sgl_front(vec) == 500);
+
+    sgl_delete(vec);
+}
@@ -0,0 +1,30 @@
+/*
+ * Copyright (C) 2015 Morwenn
+ *
+ * The SGL is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * The SGL is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program. If not,
+ * see <http://www.gnu.org/licenses/>.
+ */
+#ifndef SGL_TESTS_MULTI_TU_VECTORS_H_
+#define SGL_TESTS_MULTI_TU_VECTORS_H_
+
+#include <sgl/utility.h>
+#include <sgl/vector.h>
+
+// Shared by every translation unit of the test
+sgl_declare(sgl_vector(int))
+
+void fill_iota(sgl_vector(int)* vec, int count);
+long long sum(const sgl_vector(int)* vec);
+
+#endif // SGL_TESTS_MULTI_TU_VECTORS_H_
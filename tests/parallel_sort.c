@@ -0,0 +1,109 @@
+/*
+ * Copyright (C) 2015 Morwenn
+ *
+ * The SGL is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * The SGL is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program. If not,
+ * see <http://www.gnu.org/licenses/>.
+ */
+#include <assert.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Small ranges are split between threads as well
+#define SGL_PARALLEL_SORT_THRESHOLD 64
+
+#include <sgl/algorithm.h>
+#include <sgl/thread.h>
+#include <sgl/utility.h>
+#include <sgl/vector.h>
+
+sgl_define(sgl_vector(int))
+sgl_define(sgl_sort(int))
+sgl_define(sgl_sort(int, sgl_greater))
+sgl_define(sgl_parallel_sort(int))
+sgl_define(sgl_parallel_sort(int, sgl_greater))
+
+enum { max_size = 200000 };
+
+static int values[max_size];
+static int copy[max_size];
+static int original[max_size];
+
+static int compare_int(const void* lhs, const void* rhs)
+{
+    int a = *(const int*) lhs;
+    int b = *(const int*) rhs;
+    return (a > b) - (a < b);
+}
+
+static void fill(int pattern, size_t size)
+{
+    for (size_t i = 0 ; i < size ; ++i)
+    {
+        int n = (int) i;
+        switch (pattern)
+        {
+            case 0: values[i] = rand(); break;
+            case 1: values[i] = n; break;
+            case 2: values[i] = (int) size - n; break;
+            case 3: values[i] = 42; break;
+            default: values[i] = rand() % 16; break;
+        }
+    }
+}
+
+int main()
+{
+    assert(sgl_hardware_concurrency() >= 1);
+
+    srand(1);
+    size_t sizes[] = { 0, 1, 63, 64, 65, 100, 1000, 4321, max_size };
+    size_t threads[] = { 0, 1, 2, 3, 4, 5, 8, 13 };
+    for (size_t s = 0 ; s < sizeof sizes / sizeof *sizes ; ++s)
+    {
+        size_t size = sizes[s];
+        for (int pattern = 0 ; pattern < 5 ; ++pattern)
+        {
+            fill(pattern, size);
+            memcpy(original, values, size * sizeof(int));
+            memcpy(copy, values, size * sizeof(int));
+            qsort(copy, size, sizeof(int), &compare_int);
+            for (size_t t = 0 ; t < sizeof threads / sizeof *threads ; ++t)
+            {
+                memcpy(values, original, size * sizeof(int));
+                sgl_parallel_sort(int)(values, values + size, threads[t]);
+                assert(memcmp(values, copy, size * sizeof(int)) == 0);
+
+                memcpy(values, original, size * sizeof(int));
+                sgl_parallel_sort(int, sgl_greater)(values, values + size, threads[t]);
+                for (size_t i = 1 ; i < size ; ++i)
+                {
+                    assert(values[i - 1] >= values[i]);
+                }
+            }
+        }
+    }
+
+    // Works on vector iterators
+    sgl_vector(int)* vec = sgl_new(sgl_vector(int));
+    for (int i = 0 ; i < 10000 ; ++i)
+    {
+        sgl_push_back(vec, (i * 7919) % 10000);
+    }
+    sgl_parallel_sort(int)(sgl_begin(vec), sgl_end(vec), 4);
+    for (int i = 0 ; i < 10000 ; ++i)
+    {
+        assert(sgl_at(vec, i) == i);
+    }
+    sgl_delete(vec);
+}
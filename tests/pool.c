@@ -0,0 +1,68 @@
+/*
+ * Copyright (C) 2015 Morwenn
+ *
+ * The SGL is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * The SGL is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program. If not,
+ * see <http://www.gnu.org/licenses/>.
+ */
+#include <assert.h>
+#include <sgl/pool.h>
+#include <sgl/utility.h>
+
+typedef struct
+{
+    int key;
+    double value;
+} entry;
+
+sgl_define(sgl_pool(entry))
+
+int main()
+{
+    sgl_pool(entry)* pool = sgl_new_with_capacity(sgl_pool(entry), 16);
+    sgl_pool_stats stats = sgl_pool_get_stats(pool);
+    assert(stats.slab_count == 0);
+    assert(stats.utilization == 0.0);
+
+    entry* entries[40];
+    for (int i = 0 ; i < 40 ; ++i)
+    {
+        entries[i] = sgl_pool_allocate(pool);
+        entries[i]->key = i;
+    }
+    stats = sgl_pool_get_stats(pool);
+    assert(stats.slab_count == 3);
+    assert(stats.capacity == 48);
+    assert(stats.used == 40);
+
+    // Freed objects are reused before new slabs are allocated
+    for (int i = 0 ; i < 40 ; i += 2)
+    {
+        sgl_pool_deallocate(pool, entries[i]);
+    }
+    sgl_pool_flush(pool);
+    assert(sgl_pool_get_stats(pool).used == 20);
+    for (int i = 0 ; i < 20 ; ++i)
+    {
+        sgl_pool_allocate(pool);
+    }
+    stats = sgl_pool_get_stats(pool);
+    assert(stats.slab_count == 3);
+    assert(stats.used == 40);
+
+    for (int i = 1 ; i < 40 ; i += 2)
+    {
+        assert(entries[i]->key == i);
+    }
+    sgl_delete(pool);
+}
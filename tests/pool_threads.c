@@ -0,0 +1,127 @@
+/*
+ * Copyright (C) 2015 Morwenn
+ *
+ * The SGL is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * The SGL is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program. If not,
+ * see <http://www.gnu.org/licenses/>.
+ */
+#ifndef SGL_POOL_THREAD_CACHE
+#   define SGL_POOL_THREAD_CACHE 8
+#endif
+
+#include <assert.h>
+#include <stdbool.h>
+#include <threads.h>
+#include <sgl/pool.h>
+#include <sgl/utility.h>
+
+typedef struct
+{
+    int key;
+    double value;
+} entry;
+
+sgl_define(sgl_pool(entry))
+
+enum
+{
+    thread_count = 4,
+    iterations = 2000,
+    live_count = 50
+};
+
+typedef struct
+{
+    sgl_pool(entry)* pool;
+    int id;
+    bool flush;
+} worker_args;
+
+// Allocates and frees entries, leaving some of them in the cache
+// of the thread when it exits
+static int worker(void* arg)
+{
+    worker_args* args = arg;
+    entry* live[live_count];
+    for (int i = 0 ; i < iterations ; ++i)
+    {
+        for (int j = 0 ; j < live_count ; ++j)
+        {
+            live[j] = sgl_pool_allocate(args->pool);
+            live[j]->key = args->id * live_count + j;
+        }
+        for (int j = 0 ; j < live_count ; ++j)
+        {
+            bool intact = live[j]->key == args->id * live_count + j;
+            assert(intact);
+            (void) intact;
+            sgl_pool_deallocate(args->pool, live[j]);
+        }
+    }
+    if (args->flush)
+    {
+        sgl_pool_flush(args->pool);
+    }
+    return 0;
+}
+
+static void run_workers(sgl_pool(entry)* pool, bool flush)
+{
+    thrd_t threads[thread_count];
+    worker_args args[thread_count];
+    for (int i = 0 ; i < thread_count ; ++i)
+    {
+        args[i].pool = pool;
+        args[i].id = i;
+        args[i].flush = flush;
+        int res = thrd_create(&threads[i], &worker, &args[i]);
+        assert(res == thrd_success);
+        (void) res;
+    }
+    for (int i = 0 ; i < thread_count ; ++i)
+    {
+        thrd_join(threads[i], NULL);
+    }
+}
+
+int main()
+{
+    sgl_pool(entry)* pool = sgl_new_with_capacity(sgl_pool(entry), 16);
+
+    // Explicit flush before the threads exit
+    run_workers(pool, true);
+    sgl_pool_stats stats = sgl_pool_get_stats(pool);
+    assert(stats.used == 0);
+
+    // The caches are flushed when the threads exit
+    run_workers(pool, false);
+    stats = sgl_pool_get_stats(pool);
+    assert(stats.used == 0);
+
+    // The objects given back by the threads are reused
+    size_t slab_count = stats.slab_count;
+    entry* entries[live_count];
+    for (int i = 0 ; i < live_count ; ++i)
+    {
+        entries[i] = sgl_pool_allocate(pool);
+    }
+    assert(sgl_pool_get_stats(pool).slab_count == slab_count);
+    (void) slab_count;
+    for (int i = 0 ; i < live_count ; ++i)
+    {
+        sgl_pool_deallocate(pool, entries[i]);
+    }
+    sgl_pool_flush(pool);
+    assert(sgl_pool_get_stats(pool).used == 0);
+    sgl_delete(pool);
+}
@@ -0,0 +1,186 @@
+/*
+ * Copyright (C) 2015 Morwenn
+ *
+ * The SGL is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * The SGL is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program. If not,
+ * see <http://www.gnu.org/licenses/>.
+ */
+#include <assert.h>
+#include <stdlib.h>
+#include <sgl/priority_queue.h>
+#include <sgl/utility.h>
+#include <sgl/vector.h>
+
+typedef struct
+{
+    int node;
+    int distance;
+} path;
+
+#define path_further(lhs, rhs) \
+    ((lhs).distance > (rhs).distance)
+
+typedef struct
+{
+    int priority;
+    int id;
+} job;
+
+// Higher priorities come out first, then the jobs submitted first
+static inline bool job_before(job lhs, job rhs)
+{
+    return lhs.priority < rhs.priority
+        || (lhs.priority == rhs.priority && lhs.id > rhs.id);
+}
+
+sgl_define(sgl_vector(int))
+sgl_define(sgl_priority_queue(int, sgl_less))
+sgl_define(sgl_mutable_priority_queue(path, path_further))
+sgl_define(sgl_priority_queue(job, job_before))
+
+#undef SGL_PRIORITY_QUEUE_ARITY
+#define SGL_PRIORITY_QUEUE_ARITY 3
+sgl_define(sgl_priority_queue(int, sgl_greater))
+
+int main()
+{
+    srand(7);
+
+    // Random pushes come out sorted
+    sgl_priority_queue(int, sgl_less)* max_queue = sgl_new(sgl_priority_queue(int, sgl_less));
+    sgl_priority_queue(int, sgl_greater)* min_queue = sgl_new(sgl_priority_queue(int, sgl_greater));
+    assert(sgl_priority_queue_int_sgl_greater_arity == 3);
+    assert(sgl_is_empty(max_queue));
+    for (int i = 0 ; i < 1000 ; ++i)
+    {
+        int value = rand() % 100;
+        sgl_push(max_queue, value);
+        sgl_push(min_queue, value);
+    }
+    assert(sgl_size(max_queue) == 1000);
+    int last = sgl_top(max_queue);
+    int prev = sgl_top(min_queue);
+    while (not sgl_is_empty(max_queue))
+    {
+        int value, other;
+        sgl_pop(max_queue, &value);
+        sgl_pop(min_queue, &other);
+        assert(value <= last && other >= prev);
+        last = value;
+        prev = other;
+    }
+
+    // Popping an empty queue does nothing
+    int untouched = 42;
+    sgl_pop(max_queue, &untouched);
+    sgl_pop(max_queue, NULL);
+    assert(untouched == 42);
+    assert(sgl_size(max_queue) == 0);
+    sgl_push(max_queue, 3);
+    assert(sgl_size(max_queue) == 1);
+    assert(sgl_top(max_queue) == 3);
+    sgl_pop(max_queue, NULL);
+
+    // Heapify a copy of a vector
+    sgl_vector(int)* vec = sgl_new(sgl_vector(int));
+    for (int i = 0 ; i < 777 ; ++i)
+    {
+        sgl_push_back(vec, (i * 7919) % 777);
+    }
+    sgl_push(max_queue, 10000);
+    sgl_make_heap_vector(max_queue, vec);
+    assert(sgl_size(vec) == 777);
+    assert(sgl_size(max_queue) == 777);
+    for (int i = 776 ; i >= 0 ; --i)
+    {
+        assert(sgl_top(max_queue) == i);
+        sgl_pop(max_queue, NULL);
+    }
+    sgl_delete(vec);
+    sgl_delete(max_queue);
+    sgl_delete(min_queue);
+
+    // Struct elements with a function comparator, equal priorities
+    // come out in the order they were submitted
+    sgl_priority_queue(job, job_before)* jobs = sgl_new(sgl_priority_queue(job, job_before));
+    for (int i = 0 ; i < 300 ; ++i)
+    {
+        sgl_push(jobs, ((job) { rand() % 10, i }));
+    }
+    job last_job = { 10, -1 };
+    while (not sgl_is_empty(jobs))
+    {
+        job top;
+        sgl_pop(jobs, &top);
+        assert(top.priority < last_job.priority
+               || (top.priority == last_job.priority && top.id > last_job.id));
+        last_job = top;
+    }
+    job pending[] = { { 1, 0 }, { 5, 1 }, { 3, 2 }, { 5, 3 }, { 0, 4 } };
+    sgl_make_heap(jobs, pending, 5);
+    assert(sgl_size(jobs) == 5);
+    assert(sgl_top(jobs).id == 1);
+    sgl_pop(jobs, NULL);
+    assert(sgl_top(jobs).id == 3);
+    sgl_delete(jobs);
+
+    // Dijkstra-like use of the handles
+    sgl_mutable_priority_queue(path, path_further)* paths =
+        sgl_new(sgl_mutable_priority_queue(path, path_further));
+    enum { count = 500 };
+    sgl_priority_queue_handle handles[count];
+    int distances[count];
+    for (int i = 0 ; i < count ; ++i)
+    {
+        distances[i] = 1000 + rand() % 1000;
+        handles[i] = sgl_push(paths, ((path) { i, distances[i] }));
+    }
+    for (int i = 0 ; i < count ; ++i)
+    {
+        // Decrease or increase the keys
+        distances[i] = rand() % 2000;
+        sgl_priority_queue_update(paths, handles[i], ((path) { i, distances[i] }));
+        assert(sgl_at(paths, handles[i]).node == i);
+        assert(sgl_at(paths, handles[i]).distance == distances[i]);
+    }
+    // Remove every third element
+    for (int i = 0 ; i < count ; i += 3)
+    {
+        sgl_erase(paths, handles[i]);
+        distances[i] = -1;
+    }
+    // Handles are reused
+    sgl_priority_queue_handle reused = sgl_push(paths, ((path) { 0, -5 }));
+    assert(reused < count);
+    assert(sgl_priority_queue_top_handle(paths) == reused);
+    sgl_pop(paths, NULL);
+
+    int previous = -1;
+    size_t remaining = sgl_size(paths);
+    assert(remaining == count - (count + 2) / 3);
+    while (not sgl_is_empty(paths))
+    {
+        path top = sgl_top(paths);
+        assert(top.distance >= previous);
+        assert(distances[top.node] == top.distance);
+        previous = top.distance;
+        sgl_pop(paths, NULL);
+        --remaining;
+    }
+    assert(remaining == 0);
+    path untouched_path = { -1, -1 };
+    sgl_pop(paths, &untouched_path);
+    assert(untouched_path.node == -1);
+    assert(sgl_is_empty(paths));
+    sgl_delete(paths);
+}
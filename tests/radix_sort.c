@@ -0,0 +1,152 @@
+/*
+ * Copyright (C) 2015 Morwenn
+ *
+ * The SGL is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * The SGL is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program. If not,
+ * see <http://www.gnu.org/licenses/>.
+ */
+#include <assert.h>
+#include <math.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sgl/algorithm.h>
+#include <sgl/utility.h>
+#include <sgl/vector.h>
+
+sgl_define(sgl_vector(int))
+sgl_define(sgl_vector(unsigned))
+sgl_define(sgl_vector(float))
+sgl_define(sgl_vector(double))
+
+enum { max_size = 100000 };
+
+static int ints[max_size];
+static unsigned uints[max_size];
+static long long longs[max_size];
+static float floats[max_size];
+static double doubles[max_size];
+static void* copy;
+
+#define compare(T)                                                                  \
+    static int compare_##T(const void* lhs, const void* rhs)                        \
+    {                                                                               \
+        T a = *(const T*) lhs;                                                      \
+        T b = *(const T*) rhs;                                                      \
+        return (a > b) - (a < b);                                                   \
+    }
+
+typedef long long llong;
+compare(int)
+compare(unsigned)
+compare(llong)
+compare(float)
+compare(double)
+
+// Random bits, with a few patterns that let passes be skipped
+static uint64_t random_bits(int pattern, size_t i)
+{
+    uint64_t bits = ((uint64_t) rand() << 42) ^ ((uint64_t) rand() << 21) ^ rand();
+    switch (pattern)
+    {
+        case 0: return bits;
+        case 1: return bits & 0x7ff;
+        case 2: return bits << 53;
+        case 3: return 42;
+        default: return i % 7 ? bits >> 40 : bits;
+    }
+}
+
+// Sorts each array with qsort and sgl_radix_sort
+#define check(T, array, size)                                                       \
+    do {                                                                            \
+        memcpy(copy, array, size * sizeof(T));                                      \
+        qsort(copy, size, sizeof(T), &compare_##T);                                 \
+        sgl_radix_sort(array, array + size);                                        \
+        for (size_t i = 0 ; i < size ; ++i)                                         \
+        {                                                                           \
+            assert(array[i] == ((T*) copy)[i]);                                     \
+        }                                                                           \
+    } while (false)
+
+int main()
+{
+    srand(1);
+    copy = malloc(max_size * sizeof(double));
+    size_t sizes[] = { 0, 1, 2, 63, 64, 65, 1000, 4321, max_size };
+    for (size_t s = 0 ; s < sizeof sizes / sizeof *sizes ; ++s)
+    {
+        size_t size = sizes[s];
+        for (int pattern = 0 ; pattern < 5 ; ++pattern)
+        {
+            for (size_t i = 0 ; i < size ; ++i)
+            {
+                uint64_t bits = random_bits(pattern, i);
+                ints[i] = (int) (uint32_t) bits;
+                uints[i] = (unsigned) bits;
+                longs[i] = (long long) bits;
+                floats[i] = (float) (int64_t) bits / 1e9f;
+                doubles[i] = (double) (int64_t) bits / 1e9;
+            }
+            check(int, ints, size);
+            check(unsigned, uints, size);
+            check(llong, longs, size);
+            check(float, floats, size);
+            check(double, doubles, size);
+        }
+    }
+
+    // Negative zero comes before zero, infinities at both ends
+    double specials[] = { 1.5, -0.0, INFINITY, 0.0, -2.0, -INFINITY, 0.0, -0.0 };
+    sgl_radix_sort(specials, specials + 8);
+    assert(specials[0] == -INFINITY);
+    assert(specials[1] == -2.0);
+    assert(signbit(specials[2]) && signbit(specials[3]));
+    assert(not signbit(specials[4]) && not signbit(specials[5]));
+    assert(specials[6] == 1.5);
+    assert(specials[7] == INFINITY);
+
+    // Works on vector iterators
+    sgl_vector(int)* ivec = sgl_new(sgl_vector(int));
+    sgl_vector(unsigned)* uvec = sgl_new(sgl_vector(unsigned));
+    sgl_vector(float)* fvec = sgl_new(sgl_vector(float));
+    sgl_vector(double)* dvec = sgl_new(sgl_vector(double));
+    for (int i = 0 ; i < 1000 ; ++i)
+    {
+        int value = (i * 7919) % 1000 - 500;
+        sgl_push_back(ivec, value);
+        sgl_push_back(uvec, (unsigned) value);
+        sgl_push_back(fvec, (float) value / 4);
+        sgl_push_back(dvec, (double) value / 4);
+    }
+    sgl_radix_sort(sgl_begin(ivec), sgl_end(ivec));
+    sgl_radix_sort(sgl_begin(uvec), sgl_end(uvec));
+    sgl_radix_sort(sgl_begin(fvec), sgl_end(fvec));
+    sgl_radix_sort(sgl_begin(dvec), sgl_end(dvec));
+    for (int i = 0 ; i < 1000 ; ++i)
+    {
+        assert(sgl_at(ivec, i) == i - 500);
+        assert(sgl_at(fvec, i) == (float) (i - 500) / 4);
+        assert(sgl_at(dvec, i) == (double) (i - 500) / 4);
+    }
+    for (int i = 0 ; i < 500 ; ++i)
+    {
+        assert(sgl_at(uvec, i) == (unsigned) i);
+        assert(sgl_at(uvec, i + 500) == (unsigned) (i - 500));
+    }
+    sgl_delete(ivec);
+    sgl_delete(uvec);
+    sgl_delete(fvec);
+    sgl_delete(dvec);
+    free(copy);
+}
@@ -0,0 +1,123 @@
+/*
+ * Copyright (C) 2015 Morwenn
+ *
+ * The SGL is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * The SGL is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program. If not,
+ * see <http://www.gnu.org/licenses/>.
+ */
+#include <assert.h>
+#include <stdlib.h>
+#include <sgl/algorithm.h>
+#include <sgl/utility.h>
+
+typedef struct
+{
+    int key;
+    int index;
+} record;
+
+#define record_less(lhs, rhs) \
+    ((lhs).key < (rhs).key)
+
+sgl_define(sgl_sort(int))
+sgl_define(sgl_sort(int, sgl_greater))
+sgl_define(sgl_sort(record, record_less))
+sgl_define(sgl_stable_sort(int))
+sgl_define(sgl_stable_sort(record, record_less))
+
+enum { max_size = 100000 };
+
+static int values[max_size];
+static int copy[max_size];
+static int original[max_size];
+static record records[max_size];
+
+static int compare_int(const void* lhs, const void* rhs)
+{
+    int a = *(const int*) lhs;
+    int b = *(const int*) rhs;
+    return (a > b) - (a < b);
+}
+
+// Fills values with one of several patterns known to be hard for
+// some quicksort implementations
+static void fill(int pattern, size_t size)
+{
+    for (size_t i = 0 ; i < size ; ++i)
+    {
+        int n = (int) i;
+        switch (pattern)
+        {
+            case 0: values[i] = rand(); break;
+            case 1: values[i] = n; break;
+            case 2: values[i] = (int) size - n; break;
+            case 3: values[i] = 42; break;
+            case 4: values[i] = rand() % 16; break;
+            case 5: values[i] = n < (int) size / 2 ? n : (int) size - n; break;
+            case 6: values[i] = n % 2 ? n : -n; break;
+            default: values[i] = i % 100 ? n : rand(); break;
+        }
+    }
+}
+
+int main()
+{
+    srand(1);
+    size_t sizes[] = { 0, 1, 2, 3, 10, 23, 24, 25, 100, 129, 1000, 4321, max_size };
+    for (size_t s = 0 ; s < sizeof sizes / sizeof *sizes ; ++s)
+    {
+        size_t size = sizes[s];
+        for (int pattern = 0 ; pattern < 8 ; ++pattern)
+        {
+            // Both sorts give the same result as qsort
+            fill(pattern, size);
+            memcpy(original, values, size * sizeof(int));
+            memcpy(copy, values, size * sizeof(int));
+            qsort(copy, size, sizeof(int), &compare_int);
+            sgl_sort(int)(values, values + size);
+            assert(memcmp(values, copy, size * sizeof(int)) == 0);
+
+            memcpy(values, original, size * sizeof(int));
+            sgl_stable_sort(int)(values, values + size);
+            assert(memcmp(values, copy, size * sizeof(int)) == 0);
+
+            memcpy(values, original, size * sizeof(int));
+            sgl_sort(int, sgl_greater)(values, values + size);
+            for (size_t i = 1 ; i < size ; ++i)
+            {
+                assert(values[i - 1] >= values[i]);
+            }
+        }
+
+        // The stable sort keeps the order of equal keys
+        for (size_t i = 0 ; i < size ; ++i)
+        {
+            records[i].key = rand() % 50;
+            records[i].index = (int) i;
+        }
+        sgl_stable_sort(record, record_less)(records, records + size);
+        for (size_t i = 1 ; i < size ; ++i)
+        {
+            assert(records[i - 1].key <= records[i].key);
+            if (records[i - 1].key == records[i].key)
+            {
+                assert(records[i - 1].index < records[i].index);
+            }
+        }
+        sgl_sort(record, record_less)(records, records + size);
+        for (size_t i = 1 ; i < size ; ++i)
+        {
+            assert(records[i - 1].key <= records[i].key);
+        }
+    }
+}
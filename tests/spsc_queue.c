@@ -0,0 +1,131 @@
+/*
+ * Copyright (C) 2015 Morwenn
+ *
+ * The SGL is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * The SGL is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program. If not,
+ * see <http://www.gnu.org/licenses/>.
+ */
+#include <assert.h>
+#include <stdbool.h>
+#include <threads.h>
+#include <sgl/spsc_queue.h>
+#include <sgl/utility.h>
+
+sgl_define(sgl_spsc_queue(int))
+
+enum { count = 200000 };
+
+static int produce(void* arg)
+{
+    sgl_spsc_queue(int)* queue = arg;
+    int batch[37];
+    int next = 0;
+    while (next < count)
+    {
+        // Alternate single and batched pushes
+        if (next % 2)
+        {
+            if (sgl_try_push(queue, next))
+            {
+                ++next;
+            }
+            else
+            {
+                thrd_yield();
+            }
+            continue;
+        }
+        size_t n = 0;
+        while (n < 37 && next + (int) n < count)
+        {
+            batch[n] = next + (int) n;
+            ++n;
+        }
+        size_t pushed = sgl_push_n(queue, batch, n);
+        if (pushed == 0)
+        {
+            thrd_yield();
+        }
+        next += (int) pushed;
+    }
+    return 0;
+}
+
+int main()
+{
+    // Single-threaded behaviour around the boundaries
+    sgl_spsc_queue(int)* queue = sgl_new_with_capacity(sgl_spsc_queue(int), 5);
+    assert(sgl_capacity(queue) == 8);
+    assert(sgl_is_empty(queue));
+    int value;
+    bool popped = sgl_try_pop(queue, &value);
+    assert(not popped);
+
+    int values[10] = { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9 };
+    int out[10];
+    size_t n = sgl_push_n(queue, values, 6);
+    assert(n == 6);
+    n = sgl_pop_n(queue, out, 4);
+    assert(n == 4);
+    assert(out[0] == 0 && out[3] == 3);
+    // Wraps around the end of the buffer
+    n = sgl_push_n(queue, values, 10);
+    assert(n == 6);
+    bool pushed = sgl_try_push(queue, 42);
+    assert(not pushed);
+    assert(sgl_size(queue) == 8);
+    n = sgl_pop_n(queue, out, 10);
+    assert(n == 8);
+    assert(out[0] == 4 && out[1] == 5 && out[2] == 0 && out[7] == 5);
+    pushed = sgl_try_push(queue, 42);
+    assert(pushed);
+    popped = sgl_try_pop(queue, &value);
+    assert(popped && value == 42);
+    assert(sgl_is_empty(queue));
+    (void) pushed;
+    (void) popped;
+    sgl_delete(queue);
+
+    // Values cross threads in order and exactly once
+    queue = sgl_new_with_capacity(sgl_spsc_queue(int), 64);
+    thrd_t producer;
+    thrd_create(&producer, &produce, queue);
+    int expected = 0;
+    while (expected < count)
+    {
+        int batch[29];
+        n = sgl_pop_n(queue, batch, 29);
+        for (size_t i = 0 ; i < n ; ++i)
+        {
+            assert(batch[i] == expected);
+            ++expected;
+        }
+        if (sgl_try_pop(queue, &value))
+        {
+            assert(value == expected);
+            ++expected;
+        }
+        else if (n == 0)
+        {
+            thrd_yield();
+        }
+    }
+    thrd_join(producer, NULL);
+    assert(sgl_is_empty(queue));
+    sgl_delete(queue);
+
+    sgl_spsc_queue(int) local;
+    sgl_init(sgl_spsc_queue(int), &local);
+    assert(sgl_capacity(&local) == SGL_SPSC_QUEUE_CAPACITY);
+    sgl_destroy(&local);
+}
@@ -0,0 +1,106 @@
+/*
+ * Copyright (C) 2015 Morwenn
+ *
+ * The SGL is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * The SGL is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program. If not,
+ * see <http://www.gnu.org/licenses/>.
+ */
+#include <assert.h>
+#include <stdatomic.h>
+#include <stdint.h>
+#include <sgl/thread.h>
+
+typedef struct
+{
+    sgl_thread_pool* pool;
+    int n;
+    long result;
+} fib_args;
+
+static void fib(void* arg)
+{
+    fib_args* args = arg;
+    if (args->n < 2)
+    {
+        args->result = args->n;
+        return;
+    }
+    fib_args left = { args->pool, args->n - 1, 0 };
+    fib_args right = { args->pool, args->n - 2, 0 };
+    sgl_task_group group;
+    sgl_task_group_init(&group, args->pool);
+    sgl_spawn(&group, &fib, &left);
+    fib(&right);
+    sgl_wait(&group);
+    args->result = left.result + right.result;
+}
+
+static atomic_long counter;
+
+static void increment(void* arg)
+{
+    atomic_fetch_add(&counter, (long) (intptr_t) arg);
+}
+
+// Spawns more tasks than a worker deque can hold
+static void spawn_many(void* arg)
+{
+    sgl_task_group group;
+    sgl_task_group_init(&group, arg);
+    for (int i = 0 ; i < 5000 ; ++i)
+    {
+        sgl_spawn(&group, &increment, (void*) (intptr_t) 1);
+    }
+    sgl_wait(&group);
+}
+
+int main()
+{
+    size_t sizes[] = { 0, 1, 2, 4 };
+    for (size_t s = 0 ; s < sizeof sizes / sizeof *sizes ; ++s)
+    {
+        sgl_thread_pool* pool = sgl_thread_pool_new(sizes[s]);
+        size_t size = sizes[s] ? sizes[s] : sgl_hardware_concurrency();
+        assert(sgl_thread_pool_size(pool) == size);
+
+        // Waiting for an empty group returns immediately
+        sgl_task_group group;
+        sgl_task_group_init(&group, pool);
+        sgl_wait(&group);
+
+        // Nested fork-join
+        fib_args args = { pool, 20, 0 };
+        fib(&args);
+        assert(args.result == 6765);
+
+        // Tasks spawned from outside of the pool
+        atomic_store(&counter, 0);
+        for (int i = 0 ; i < 1000 ; ++i)
+        {
+            sgl_spawn(&group, &increment, (void*) (intptr_t) i);
+        }
+        sgl_wait(&group);
+        assert(atomic_load(&counter) == 999 * 1000 / 2);
+
+        // Full worker deques run the tasks in place
+        atomic_store(&counter, 0);
+        for (int i = 0 ; i < 4 ; ++i)
+        {
+            sgl_spawn(&group, &spawn_many, pool);
+        }
+        sgl_wait(&group);
+        assert(atomic_load(&counter) == 4 * 5000);
+
+        sgl_thread_pool_delete(pool);
+    }
+}
@@ -0,0 +1,135 @@
+/*
+ * Copyright (C) 2015 Morwenn
+ *
+ * The SGL is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * The SGL is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program. If not,
+ * see <http://www.gnu.org/licenses/>.
+ */
+#include <assert.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <sgl/collection.h>
+#include <sgl/exception.h>
+#include <sgl/memory.h>
+#include <sgl/utility.h>
+#include <sgl/vector.h>
+
+sgl_define(sgl_vector(int))
+
+// Reallocations fail once the limit is reached
+static void* limited_allocate(void* context, size_t size, size_t alignment)
+{
+    (void) context;
+    (void) alignment;
+    return malloc(size);
+}
+
+static void* limited_reallocate(void* context, void* ptr, size_t old_size,
+                                size_t new_size, size_t alignment)
+{
+    (void) old_size;
+    (void) alignment;
+    size_t limit = *(size_t*) context;
+    return new_size > limit ? NULL : realloc(ptr, new_size);
+}
+
+static void limited_deallocate(void* context, void* ptr, size_t size)
+{
+    (void) context;
+    (void) size;
+    free(ptr);
+}
+
+int main()
+{
+    size_t limit = 100 * sizeof(int);
+    sgl_allocator allocator = {
+        limited_allocate,
+        limited_reallocate,
+        limited_deallocate,
+        &limit
+    };
+
+    sgl_vector(int)* vec = sgl_new_with_allocator(sgl_vector(int), &allocator);
+
+    // No sgl_try block is needed around the non-throwing functions
+    int count = 0;
+    sgl_exception_t error;
+    while ((error = sgl_try_push_back(vec, count)) == sgl_no_exception)
+    {
+        ++count;
+    }
+    assert(error == sgl_bad_alloc);
+    assert(sgl_detail_exceptions_index == -1);
+
+    // The vector is left unchanged by the failed operations
+    assert(sgl_size(vec) == (size_t) count);
+    assert(sgl_size(vec) <= 100);
+    for (int i = 0 ; i < count ; ++i)
+    {
+        assert(sgl_at(vec, (size_t) i) == i);
+    }
+
+    size_t capacity = sgl_capacity(vec);
+    error = sgl_try_reserve(vec, 101);
+    assert(error == sgl_bad_alloc);
+    error = sgl_try_reserve(vec, SIZE_MAX);
+    assert(error == sgl_length_error);
+    assert(sgl_capacity(vec) == capacity);
+    error = sgl_try_reserve(vec, 100);
+    assert(error == sgl_no_exception);
+    assert(sgl_capacity(vec) == 100);
+    error = sgl_try_reserve(vec, 10);
+    assert(error == sgl_no_exception);
+    assert(sgl_capacity(vec) == 100);
+
+    // Fill the vector up to the limit
+    while (sgl_size(vec) < 100)
+    {
+        error = sgl_try_push_back(vec, count++);
+        assert(error == sgl_no_exception);
+    }
+    error = sgl_try_push_back(vec, count);
+    assert(error == sgl_bad_alloc);
+    assert(sgl_size(vec) == 100);
+
+    sgl_pop_back(vec);
+    error = sgl_try_shrink_to_fit(vec);
+    assert(error == sgl_no_exception);
+    assert(sgl_capacity(vec) == 99);
+    sgl_clear(vec);
+    error = sgl_try_shrink_to_fit(vec);
+    assert(error == sgl_no_exception);
+    assert(sgl_capacity(vec) == 0);
+    assert(sgl_is_empty(vec));
+    (void) capacity;
+
+    // The throwing functions still report the same errors
+    bool caught = false;
+    sgl_try
+    {
+        sgl_reserve(vec, 101);
+    }
+    sgl_catch(sgl_bad_alloc)
+    {
+        caught = true;
+    }
+    sgl_endtry
+    assert(caught);
+    (void) caught;
+    assert(sgl_detail_exceptions_index == -1);
+
+    assert(sgl_what(sgl_no_exception) != NULL);
+
+    sgl_delete(vec);
+}
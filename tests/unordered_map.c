@@ -0,0 +1,114 @@
+/*
+ * Copyright (C) 2015 Morwenn
+ *
+ * The SGL is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * The SGL is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program. If not,
+ * see <http://www.gnu.org/licenses/>.
+ */
+#include <assert.h>
+#include <stdlib.h>
+#include <sgl/unordered_map.h>
+#include <sgl/unordered_set.h>
+#include <sgl/utility.h>
+
+sgl_define(sgl_unordered_map(int, int))
+
+// Bad hash function creating long clusters of colliding keys
+typedef unsigned colliding;
+static size_t colliding_hash(const colliding* key)
+{
+    return *key / 64;
+}
+#undef SGL_UNORDERED_HASH
+#define SGL_UNORDERED_HASH colliding_hash
+sgl_define(sgl_unordered_set(colliding))
+
+enum { key_range = 5000 };
+
+int main()
+{
+    sgl_unordered_map(int, int)* map = sgl_new(sgl_unordered_map(int, int));
+    sgl_unordered_set(colliding) set;
+    sgl_init(sgl_unordered_set(colliding), &set);
+    assert(sgl_find(map, 42) == NULL);
+    bool erased = sgl_erase(map, 42);
+    assert(not erased);
+    (void) erased;
+
+    // Compare random insertions and erasures with a reference array
+    static int values[key_range];
+    static bool present[key_range];
+    size_t count = 0;
+    srand(1);
+    for (int i = 0 ; i < 200000 ; ++i)
+    {
+        int key = rand() % key_range;
+        if (rand() % 3)
+        {
+            int value = rand();
+            int* res = sgl_insert(map, key, value);
+            bool inserted = sgl_insert(&set, (colliding) key);
+            assert(inserted == not present[key]);
+            (void) inserted;
+            if (not present[key])
+            {
+                present[key] = true;
+                values[key] = value;
+                ++count;
+            }
+            assert(*res == values[key]);
+        }
+        else
+        {
+            erased = sgl_erase(map, key);
+            assert(erased == present[key]);
+            erased = sgl_erase(&set, (colliding) key);
+            assert(erased == present[key]);
+            if (present[key])
+            {
+                present[key] = false;
+                --count;
+            }
+        }
+        assert(sgl_size(map) == count);
+        assert(sgl_size(&set) == count);
+    }
+
+    for (int key = 0 ; key < key_range ; ++key)
+    {
+        int* value = sgl_find(map, key);
+        const colliding* elem = sgl_find(&set, (colliding) key);
+        assert((value != NULL) == present[key]);
+        assert((elem != NULL) == present[key]);
+        assert(value == NULL || *value == values[key]);
+    }
+
+    // Rehashing keeps the elements
+    sgl_rehash(map, 0);
+    assert(sgl_capacity(map) < 2 * key_range);
+    sgl_reserve(map, 100000);
+    assert(sgl_capacity(map) >= 100000);
+    for (int key = 0 ; key < key_range ; ++key)
+    {
+        assert((sgl_find(map, key) != NULL) == present[key]);
+    }
+
+    sgl_clear(map);
+    assert(sgl_is_empty(map));
+    assert(sgl_find(map, 0) == NULL);
+    sgl_rehash(map, 0);
+    assert(sgl_capacity(map) == 0);
+
+    sgl_delete(map);
+    sgl_destroy(&set);
+}
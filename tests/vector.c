@@ -0,0 +1,149 @@
+/*
+ * Copyright (C) 2015 Morwenn
+ *
+ * The SGL is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * The SGL is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this program. If not,
+ * see <http://www.gnu.org/licenses/>.
+ */
+#include <assert.h>
+#include <sgl/collection.h>
+#include <sgl/utility.h>
+#include <sgl/vector.h>
+
+sgl_define(sgl_vector(int))
+
+// Checks that the vector holds exactly the given values
+static bool holds(const sgl_vector(int)* vec, const int* values, size_t count)
+{
+    if (sgl_size(vec) != count)
+    {
+        return false;
+    }
+    for (size_t i = 0 ; i < count ; ++i)
+    {
+        if (sgl_at(vec, i) != values[i])
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+int main()
+{
+    // Insertions at the end, at the beginning and in the middle
+    sgl_vector(int)* vec = sgl_new(sgl_vector(int));
+    int* it = sgl_insert(vec, sgl_end(vec), 3);
+    assert(it == sgl_begin(vec));
+    sgl_insert(vec, sgl_end(vec), 5);
+    it = sgl_insert(vec, sgl_begin(vec), 1);
+    assert(it == sgl_begin(vec) && *it == 1);
+    it = sgl_insert(vec, sgl_begin(vec) + 2, 4);
+    assert(it == sgl_begin(vec) + 2 && *it == 4);
+    assert(holds(vec, (int[]) { 1, 3, 4, 5 }, 4));
+
+    // Several copies, and a range from another array
+    it = sgl_insert(vec, sgl_begin(vec) + 1, 2, 2);
+    assert(it == sgl_begin(vec) + 1);
+    assert(holds(vec, (int[]) { 1, 2, 2, 3, 4, 5 }, 6));
+    int tail[] = { 6, 7, 8 };
+    it = sgl_insert(vec, sgl_end(vec), tail, tail + 3);
+    assert(it == sgl_begin(vec) + 6);
+    assert(holds(vec, (int[]) { 1, 2, 2, 3, 4, 5, 6, 7, 8 }, 9));
+
+    // Inserting more than the capacity reallocates once and keeps
+    // the elements on both sides of the gap
+    size_t capacity = sgl_capacity(vec);
+    it = sgl_insert(vec, sgl_begin(vec) + 4, capacity, 0);
+    assert(sgl_capacity(vec) > capacity);
+    assert(sgl_size(vec) == 9 + capacity);
+    assert(it == sgl_begin(vec) + 4);
+    for (size_t i = 0 ; i < capacity ; ++i)
+    {
+        assert(it[i] == 0);
+    }
+    assert(sgl_at(vec, 3) == 3);
+    assert(sgl_at(vec, 4 + capacity) == 4);
+    assert(sgl_back(vec) == 8);
+
+    // Range erasures, then single erasures at both ends
+    sgl_erase(vec, sgl_begin(vec) + 4, sgl_begin(vec) + 4 + capacity);
+    assert(holds(vec, (int[]) { 1, 2, 2, 3, 4, 5, 6, 7, 8 }, 9));
+    sgl_erase(vec, sgl_begin(vec) + 1, sgl_begin(vec) + 3);
+    assert(holds(vec, (int[]) { 1, 3, 4, 5, 6, 7, 8 }, 7));
+    sgl_erase(vec, sgl_begin(vec) + 2, sgl_begin(vec) + 2);
+    assert(sgl_size(vec) == 7);
+    sgl_erase(vec, sgl_begin(vec));
+    sgl_erase(vec, sgl_end(vec) - 1);
+    assert(holds(vec, (int[]) { 3, 4, 5, 6, 7 }, 5));
+    sgl_erase(vec, sgl_begin(vec), sgl_end(vec));
+    assert(sgl_is_empty(vec));
+
+    // Appending a part of the vector to itself, with enough capacity
+    // then with a reallocation which moves the source elements
+    int head[] = { 1, 2, 3, 4 };
+    sgl_append(vec, head, 4);
+    sgl_reserve(vec, 6);
+    int* data = sgl_data(vec);
+    sgl_append(vec, sgl_data(vec) + 2, 2);
+    assert(sgl_data(vec) == data);
+    assert(holds(vec, (int[]) { 1, 2, 3, 4, 3, 4 }, 6));
+    sgl_shrink_to_fit(vec);
+    sgl_append_vector(vec, vec);
+    assert(holds(vec, (int[]) { 1, 2, 3, 4, 3, 4, 1, 2, 3, 4, 3, 4 }, 12));
+
+    // Assigning fewer elements keeps the buffer, assigning more
+    // than the capacity replaces it
+    capacity = sgl_capacity(vec);
+    data = sgl_data(vec);
+    sgl_assign(vec, (size_t) 3, 9);
+    assert(holds(vec, (int[]) { 9, 9, 9 }, 3));
+    assert(sgl_capacity(vec) == capacity && sgl_data(vec) == data);
+    sgl_assign(vec, capacity + 5, 7);
+    assert(sgl_size(vec) == capacity + 5);
+    assert(sgl_capacity(vec) >= capacity + 5);
+    assert(sgl_front(vec) == 7 && sgl_back(vec) == 7);
+    int values[] = { 5, 6, 7, 8, 9 };
+    sgl_assign(vec, values + 1, values + 4);
+    assert(holds(vec, (int[]) { 6, 7, 8 }, 3));
+    sgl_assign(vec, sgl_begin(vec) + 1, sgl_end(vec));
+    assert(holds(vec, (int[]) { 7, 8 }, 2));
+    sgl_delete(vec);
+
+    // The buffer is allocated up front, and not reallocated before
+    // the capacity is reached
+    vec = sgl_new_with_capacity(sgl_vector(int), 100);
+    assert(sgl_size(vec) == 0);
+    assert(sgl_capacity(vec) >= 100);
+    data = sgl_data(vec);
+    for (int i = 0 ; i < 100 ; ++i)
+    {
+        sgl_push_back(vec, i);
+    }
+    assert(sgl_data(vec) == data);
+    sgl_delete(vec);
+
+    // Vector with automatic storage duration, which can be used
+    // again after sgl_destroy
+    sgl_vector(int) local;
+    sgl_init(sgl_vector(int), &local);
+    assert(sgl_is_empty(&local) && sgl_capacity(&local) == 0);
+    sgl_push_back(&local, 42);
+    sgl_insert(&local, sgl_begin(&local), 41);
+    assert(holds(&local, (int[]) { 41, 42 }, 2));
+    sgl_destroy(&local);
+    assert(sgl_is_empty(&local) && sgl_capacity(&local) == 0);
+    sgl_push_back(&local, 1);
+    assert(sgl_front(&local) == 1);
+    sgl_destroy(&local);
+}